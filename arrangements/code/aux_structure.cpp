@@ -47,11 +47,34 @@ inline void AuxiliaryStructure::initFromTriangleSoup(TriangleSoup &ts)
     num_original_vtx = ts.numVerts();
     num_original_tris = ts.numTris();
 
-    coplanar_tris.resize(ts.numTris());
+    // only the triangles (and their edges) in the intersection list can receive points, segments or
+    // coplanar triangles, so they are the only ones that get a slot in the storage pools
+    tri_slot.assign(ts.numTris(), NO_SLOT);
+    edge_slot.assign(ts.numEdges(), NO_SLOT);
+
+    uint num_slots = 0;
+    for(auto &pair : intersection_list)
+    {
+        if(tri_slot[pair.first]  == NO_SLOT) tri_slot[pair.first]  = num_slots++;
+        if(tri_slot[pair.second] == NO_SLOT) tri_slot[pair.second] = num_slots++;
+    }
+    tri_data.clear();
+    tri_data.resize(num_slots);
+
+    num_slots = 0;
+    for(uint t_id = 0; t_id < ts.numTris(); t_id++)
+    {
+        if(tri_slot[t_id] == NO_SLOT) continue;
+
+        for(uint off = 0; off < 3; off++)
+        {
+            uint e_id = ts.triEdgeID(t_id, off);
+            if(edge_slot[e_id] == NO_SLOT) edge_slot[e_id] = num_slots++;
+        }
+    }
+    edge2pts.clear();
+    edge2pts.resize(num_slots);
 
-    tri2pts.resize(ts.numTris());
-    edge2pts.resize(ts.numEdges());
-    tri2segs.resize(ts.numTris());
     tri_has_intersections.resize(ts.numTris(), false);
 
     num_intersections = 0;
@@ -81,8 +104,7 @@ inline const std::vector<std::pair<uint, uint> > &AuxiliaryStructure::intersecti
 
 inline bool AuxiliaryStructure::addVertexInTriangle(uint t_id, uint v_id)
 {
-    assert(t_id < tri2pts.size());
-    auto& points = tri2pts[t_id];
+    auto& points = triData(t_id).points;
     if(contains(points, v_id)) return false;
     if(points.empty()) points.reserve(8);
     points.push_back(v_id);
@@ -93,8 +115,7 @@ inline bool AuxiliaryStructure::addVertexInTriangle(uint t_id, uint v_id)
 
 inline bool AuxiliaryStructure::addVertexInEdge(uint e_id, uint v_id)
 {
-    assert(e_id < edge2pts.size());
-    auto& points = edge2pts[e_id];
+    auto& points = edgePoints(e_id);
     if(contains(points, v_id)) return false;
     if(points.empty()) points.reserve(8);
     points.push_back(v_id);
@@ -105,9 +126,8 @@ inline bool AuxiliaryStructure::addVertexInEdge(uint e_id, uint v_id)
 
 inline bool AuxiliaryStructure::addSegmentInTriangle(uint t_id, const UIPair &seg)
 {
-    assert(t_id < tri2segs.size());
     UIPair key_seg = uniquePair(seg);
-    auto& segments = tri2segs[t_id];
+    auto& segments = triData(t_id).segments;
     if(contains(segments, key_seg)) return false;
     if(segments.empty()) segments.reserve(8);
     segments.push_back(key_seg);
@@ -148,28 +168,30 @@ inline void AuxiliaryStructure::splitSegmentInSubSegments(uint orig_v0, uint ori
 inline void AuxiliaryStructure::addCoplanarTriangles(uint ta, uint tb)
 {
     assert(ta != tb);
-    assert(ta < coplanar_tris.size() && tb < coplanar_tris.size());
 
-    if(coplanar_tris[ta].empty()) coplanar_tris[ta].reserve(8);
-    if(coplanar_tris[tb].empty()) coplanar_tris[tb].reserve(8);
-    coplanar_tris[ta].push_back(tb);
-    coplanar_tris[tb].push_back(ta);
+    auto& copl_a = triData(ta).coplanar_tris;
+    auto& copl_b = triData(tb).coplanar_tris;
+    if(copl_a.empty()) copl_a.reserve(8);
+    if(copl_b.empty()) copl_b.reserve(8);
+    copl_a.push_back(tb);
+    copl_b.push_back(ta);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 inline const auxvector<uint> &AuxiliaryStructure::coplanarTriangles(uint t_id) const
 {
-    assert(t_id < coplanar_tris.size());
-    return coplanar_tris[t_id];
+    static const auxvector<uint> empty;
+    const TriData *td = triDataPtr(t_id);
+    return (td != nullptr) ? td->coplanar_tris : empty;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 inline bool AuxiliaryStructure::triangleHasCoplanars(uint t_id) const
 {
-    assert(t_id < coplanar_tris.size());
-    return (coplanar_tris[t_id].size() > 0);
+    const TriData *td = triDataPtr(t_id);
+    return (td != nullptr && td->coplanar_tris.size() > 0);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -193,24 +215,27 @@ inline bool AuxiliaryStructure::triangleHasIntersections(uint t_id) const
 
 inline const auxvector<uint> &AuxiliaryStructure::trianglePointsList(uint t_id) const
 {
-    assert(t_id < tri2pts.size());
-    return tri2pts[t_id];
+    static const auxvector<uint> empty;
+    const TriData *td = triDataPtr(t_id);
+    return (td != nullptr) ? td->points : empty;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 inline const auxvector<uint> &AuxiliaryStructure::edgePointsList(uint e_id) const
 {
-    assert(e_id < edge2pts.size());
-    return edge2pts[e_id];
+    static const auxvector<uint> empty;
+    assert(e_id < edge_slot.size());
+    return (edge_slot[e_id] != NO_SLOT) ? edge2pts[edge_slot[e_id]] : empty;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 inline const auxvector<UIPair> &AuxiliaryStructure::triangleSegmentsList(uint t_id) const
 {
-    assert(t_id < tri2segs.size());
-    return tri2segs[t_id];
+    static const auxvector<UIPair> empty;
+    const TriData *td = triDataPtr(t_id);
+    return (td != nullptr) ? td->segments : empty;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -252,4 +277,66 @@ inline UIPair AuxiliaryStructure::uniquePair(const UIPair &uip) const
 {
     if(uip.first < uip.second) return  uip;
     return std::make_pair(uip.second, uip.first);
-}
\ No newline at end of file
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline uint AuxiliaryStructure::numIntersectingTriangles() const
+{
+    return static_cast<uint>(tri_data.size());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline uint AuxiliaryStructure::numIntersectingEdges() const
+{
+    return static_cast<uint>(edge2pts.size());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline size_t AuxiliaryStructure::memoryFootprint() const
+{
+    size_t bytes = tri_slot.capacity() * sizeof(uint) + edge_slot.capacity() * sizeof(uint) +
+                   tri_has_intersections.capacity() / 8 +
+                   tri_data.capacity() * sizeof(TriData) + edge2pts.capacity() * sizeof(auxvector<uint>);
+
+    // heap storage of the small vectors that outgrew their inlined capacity
+    for(const TriData &td : tri_data)
+    {
+        if(td.coplanar_tris.capacity() > 16) bytes += td.coplanar_tris.capacity() * sizeof(uint);
+        if(td.points.capacity() > 16)        bytes += td.points.capacity() * sizeof(uint);
+        if(td.segments.capacity() > 16)      bytes += td.segments.capacity() * sizeof(UIPair);
+    }
+
+    for(const auxvector<uint> &ep : edge2pts)
+        if(ep.capacity() > 16) bytes += ep.capacity() * sizeof(uint);
+
+    return bytes;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline AuxiliaryStructure::TriData &AuxiliaryStructure::triData(uint t_id)
+{
+    assert(t_id < tri_slot.size());
+    assert(tri_slot[t_id] != NO_SLOT && "triangle not in the intersection list");
+    return tri_data[tri_slot[t_id]];
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline const AuxiliaryStructure::TriData *AuxiliaryStructure::triDataPtr(uint t_id) const
+{
+    assert(t_id < tri_slot.size());
+    return (tri_slot[t_id] != NO_SLOT) ? &tri_data[tri_slot[t_id]] : nullptr;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline auxvector<uint> &AuxiliaryStructure::edgePoints(uint e_id)
+{
+    assert(e_id < edge_slot.size());
+    assert(edge_slot[e_id] != NO_SLOT && "edge not in the intersection list");
+    return edge2pts[edge_slot[e_id]];
+}
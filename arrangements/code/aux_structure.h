@@ -47,6 +47,8 @@
 
 #include <mutex>
 
+#include <limits>
+
 #include "utils.h"
 
 typedef std::pair<uint, uint> UIPair;
@@ -180,17 +182,34 @@ class AuxiliaryStructure
         inline const auto& get_vmap() const { return v_map; }
         inline auto& get_vmap() { return v_map; }
 
+        inline uint numIntersectingTriangles() const;
+
+        inline uint numIntersectingEdges() const;
+
+        inline size_t memoryFootprint() const; // bytes used by the per-triangle and per-edge storage
+
     private:
+
+        // per-triangle data, stored only for the triangles appearing in the intersection list
+        struct TriData
+        {
+            auxvector<uint>   coplanar_tris;
+            auxvector<uint>   points;
+            auxvector<UIPair> segments;
+        };
+
+        static constexpr uint NO_SLOT = std::numeric_limits<uint>::max();
+
         uint    num_original_vtx;
         uint    num_original_tris;
         int     num_intersections;
         uint    num_tpi;
 
         std::vector< std::pair<uint, uint> > intersection_list;
-        std::vector< auxvector<uint> > coplanar_tris;
-        std::vector< auxvector<uint> > tri2pts;
+        std::vector<uint> tri_slot;                 // t_id -> position in tri_data (NO_SLOT if not intersecting)
+        std::vector<uint> edge_slot;                // e_id -> position in edge2pts (NO_SLOT if not intersecting)
+        std::vector<TriData> tri_data;
         std::vector< auxvector<uint> > edge2pts;
-        std::vector< auxvector<UIPair> > tri2segs;
         phmap::flat_hash_map< UIPair, auxvector<uint>  > seg2tris;
         std::vector<bool> tri_has_intersections;
         aux_point_map<uint> v_map;
@@ -198,6 +217,12 @@ class AuxiliaryStructure
         phmap::flat_hash_map< std::vector<uint>, uint> pockets_map;
 
         inline UIPair uniquePair(const UIPair &uip) const;
+
+        inline TriData &triData(uint t_id);
+
+        inline const TriData *triDataPtr(uint t_id) const;
+
+        inline auxvector<uint> &edgePoints(uint e_id);
 };
 
 
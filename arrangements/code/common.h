@@ -50,4 +50,12 @@ inline Plane intToPlane(const int &norm)
     return XY;
 }
 
+// inverse of intToPlane: the n_max argument of the genericPoint predicates that work on a single plane
+inline int planeToInt(const Plane &p)
+{
+    if(p == YZ) return 0;
+    if(p == ZX) return 1;
+    return 2;
+}
+
 #endif // COMMON_H
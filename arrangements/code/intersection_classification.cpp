@@ -107,19 +107,50 @@ inline void detectIntersections(const TriangleSoup &ts, std::vector<std::pair<ui
 
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-inline void classifyIntersections(TriangleSoup &ts, point_arena& arena, AuxiliaryStructure &g)
+inline void classifyIntersections(TriangleSoup &ts, point_arena& arena, AuxiliaryStructure &g, ProgressMonitor *progress)
 {
     auto& v_map = g.get_vmap();
     v_map.start_size = v_map.map.size();
     v_map.insert_tries = 0;
-    for(auto &pair : g.intersectionList())
+
+    // the list is sorted, so all the pairs of a triangle tA are contiguous: the vertices of all its partners are
+    // gathered and tested against the plane of tA in a single batch
+    const std::vector<std::pair<uint, uint> > &pairs = g.intersectionList();
+    std::vector<double> partner_verts;
+    std::vector<int> orBA_signs;
+
+    uint num_reported = 0;
+    if(progress) progress->beginItems(pairs.size());
+
+    for(uint first = 0, last; first < pairs.size(); first = last)
     {
-        uint tA_id = pair.first, tB_id = pair.second;
+        if(progress && first - num_reported >= ProgressMonitor::GRANULARITY)
+        {
+            progress->advance(first - num_reported, ts.numImplVerts());
+            num_reported = first;
+        }
+
+        uint tA_id = pairs[first].first;
+        for(last = first + 1; last < pairs.size() && pairs[last].first == tA_id; last++);
+
+        partner_verts.clear();
+        for(uint i = first; i < last; i++)
+            for(uint v = 0; v < 3; v++)
+                partner_verts.insert(partner_verts.end(), ts.triVertPtr(pairs[i].second, v), ts.triVertPtr(pairs[i].second, v) + 3);
 
-        g.setTriangleHasIntersections(tA_id);
-        g.setTriangleHasIntersections(tB_id);
+        orBA_signs.resize(3 * (last - first));
+        orient3dBatch(ts.triVertPtr(tA_id, 0), ts.triVertPtr(tA_id, 1), ts.triVertPtr(tA_id, 2),
+                      partner_verts.data(), 3 * (last - first), orBA_signs.data());
 
-        checkTriangleTriangleIntersections(ts, arena, g, tA_id, tB_id);
+        for(uint i = first; i < last; i++)
+        {
+            uint tB_id = pairs[i].second;
+
+            g.setTriangleHasIntersections(tA_id);
+            g.setTriangleHasIntersections(tB_id);
+
+            checkTriangleTriangleIntersections(ts, arena, g, tA_id, tB_id, &orBA_signs[3 * (i - first)]);
+        }
     }
 
     // Coplanar triangles intersections propagation
@@ -128,7 +159,7 @@ inline void classifyIntersections(TriangleSoup &ts, point_arena& arena, Auxiliar
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-inline void checkTriangleTriangleIntersections(TriangleSoup &ts, point_arena& arena, AuxiliaryStructure &g, uint tA_id, uint tB_id)
+inline void checkTriangleTriangleIntersections(TriangleSoup &ts, point_arena& arena, AuxiliaryStructure &g, uint tA_id, uint tB_id, const int orBA_signs[3])
 {
     phmap::flat_hash_set<uint> v_tmp; // temporary vtx list for final symbolic edge creation
     bool coplanar_tris = false;
@@ -138,11 +169,11 @@ inline void checkTriangleTriangleIntersections(TriangleSoup &ts, point_arena& ar
     /* ::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
      *      check of tB respect to tA
      * :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::: */
+    // orient3d(tB_v, tA_v0, tA_v1, tA_v2) = -orient3d(tA_v0, tA_v1, tA_v2, tB_v)
     double orBA[3];
-    orBA[0] = cinolib::orient3d(ts.triVertPtr(tB_id, 0), ts.triVertPtr(tA_id, 0), ts.triVertPtr(tA_id, 1), ts.triVertPtr(tA_id, 2));
-    orBA[1] = cinolib::orient3d(ts.triVertPtr(tB_id, 1), ts.triVertPtr(tA_id, 0), ts.triVertPtr(tA_id, 1), ts.triVertPtr(tA_id, 2));
-    orBA[2] = cinolib::orient3d(ts.triVertPtr(tB_id, 2), ts.triVertPtr(tA_id, 0), ts.triVertPtr(tA_id, 1), ts.triVertPtr(tA_id, 2));
-    normalizeOrientations(orBA);
+    orBA[0] = -orBA_signs[0];
+    orBA[1] = -orBA_signs[1];
+    orBA[2] = -orBA_signs[2];
 
     if(sameOrientation(orBA[0], orBA[1]) && sameOrientation(orBA[1], orBA[2]) && (orBA[0] != 0.0)) return;   //no intersection found
 
@@ -153,18 +184,16 @@ inline void checkTriangleTriangleIntersections(TriangleSoup &ts, point_arena& ar
         g.addCoplanarTriangles(tA_id, tB_id);
         coplanar_tris = true;
 
-        checkSingleCoplanarEdgeIntersections(ts, arena, ts.triVertID(tB_id, 0), ts.triVertID(tB_id, 1), tB_id, tA_id, g, li);
-        checkSingleCoplanarEdgeIntersections(ts, arena, ts.triVertID(tB_id, 1), ts.triVertID(tB_id, 2), tB_id, tA_id, g, li);
-        checkSingleCoplanarEdgeIntersections(ts, arena, ts.triVertID(tB_id, 2), ts.triVertID(tB_id, 0), tB_id, tA_id, g, li);
+        checkSingleCoplanarEdgeIntersections(ts, arena, tB_id, 0, tA_id, g, li);
+        checkSingleCoplanarEdgeIntersections(ts, arena, tB_id, 1, tA_id, g, li);
+        checkSingleCoplanarEdgeIntersections(ts, arena, tB_id, 2, tA_id, g, li);
     }
 
     // a single edge of tB is coplanar to tA    (e.g. orBA: 1 0 0)
     int tmp_edge_id = singleCoplanarEdge(orBA);
     if(tmp_edge_id != -1)
     {
-        uint e_v0_id = static_cast<uint>(tmp_edge_id);
-        uint e_v1_id = (tmp_edge_id + 1) % 3;
-        checkSingleCoplanarEdgeIntersections(ts, arena, ts.triVertID(tB_id, e_v0_id), ts.triVertID(tB_id, e_v1_id), tB_id, tA_id, g, li);
+        checkSingleCoplanarEdgeIntersections(ts, arena, tB_id, static_cast<uint>(tmp_edge_id), tA_id, g, li);
     }
 
     // a vertex of tB is coplanar to tA, and the opposite edge is on the same side respect to tA  (e.g. orBA: 1 0 1)
@@ -180,7 +209,7 @@ inline void checkTriangleTriangleIntersections(TriangleSoup &ts, point_arena& ar
         uint real_v_id = ts.triVertID(tB_id, static_cast<uint>(tmp_vtx_id));
         checkVtxInTriangleIntersection(ts, real_v_id, tA_id, v_tmp, g, li);
 
-        uint opp_edge_id = ts.edgeOppositeToVert(tB_id, ts.triVertID(tB_id, static_cast<uint>(tmp_vtx_id)));
+        uint opp_edge_id = ts.triEdgeOppositeTo(tB_id, static_cast<uint>(tmp_vtx_id));
         checkSingleNoCoplanarEdgeIntersection(ts, arena, opp_edge_id, tA_id, v_tmp, g, li);
     }
 
@@ -191,16 +220,12 @@ inline void checkTriangleTriangleIntersections(TriangleSoup &ts, point_arena& ar
 
     if(tmp_vtx_id != -1)
     {
-        uint id_v = ts.triVertID(tB_id, static_cast<uint>(tmp_vtx_id));
-        uint id_opp_v0 = ts.triVertID(tB_id, opp_v0);
-        uint id_opp_v1 = ts.triVertID(tB_id, opp_v1);
+        // the edge (v, opp_v0) is the one opposite to opp_v1 and vice versa
+        uint edge_id0 = ts.triEdgeOppositeTo(tB_id, opp_v1);
+        uint edge_id1 = ts.triEdgeOppositeTo(tB_id, opp_v0);
 
-        int edge_id0 = ts.edgeID(id_v, id_opp_v0);
-        int edge_id1 = ts.edgeID(id_v, id_opp_v1);
-        assert(edge_id0 != -1 && edge_id1 != -1);
-
-        checkSingleNoCoplanarEdgeIntersection(ts, arena, static_cast<uint>(edge_id0), tA_id, v_tmp, g, li);
-        checkSingleNoCoplanarEdgeIntersection(ts, arena, static_cast<uint>(edge_id1), tA_id, v_tmp, g, li);
+        checkSingleNoCoplanarEdgeIntersection(ts, arena, edge_id0, tA_id, v_tmp, g, li);
+        checkSingleNoCoplanarEdgeIntersection(ts, arena, edge_id1, tA_id, v_tmp, g, li);
     }
 
     if(!coplanar_tris && li.size() > 1) goto final_check; // sorry about that :(
@@ -217,9 +242,9 @@ inline void checkTriangleTriangleIntersections(TriangleSoup &ts, point_arena& ar
     if(coplanar_tris)
     {
         orAB[0] = 0; orAB[1] = 0; orAB[2] = 0;
-        checkSingleCoplanarEdgeIntersections(ts, arena, ts.triVertID(tA_id, 0), ts.triVertID(tA_id, 1), tA_id, tB_id, g, li);
-        checkSingleCoplanarEdgeIntersections(ts, arena, ts.triVertID(tA_id, 1), ts.triVertID(tA_id, 2), tA_id, tB_id, g, li);
-        checkSingleCoplanarEdgeIntersections(ts, arena, ts.triVertID(tA_id, 2), ts.triVertID(tA_id, 0), tA_id, tB_id, g, li);
+        checkSingleCoplanarEdgeIntersections(ts, arena, tA_id, 0, tB_id, g, li);
+        checkSingleCoplanarEdgeIntersections(ts, arena, tA_id, 1, tB_id, g, li);
+        checkSingleCoplanarEdgeIntersections(ts, arena, tA_id, 2, tB_id, g, li);
     }
     else
     {
@@ -235,9 +260,7 @@ inline void checkTriangleTriangleIntersections(TriangleSoup &ts, point_arena& ar
     tmp_edge_id = singleCoplanarEdge(orAB);
     if(tmp_edge_id != -1)
     {
-        uint e_v0_id = static_cast<uint>(tmp_edge_id);
-        uint e_v1_id = (tmp_edge_id + 1) % 3;
-        checkSingleCoplanarEdgeIntersections(ts, arena, ts.triVertID(tA_id, e_v0_id), ts.triVertID(tA_id, e_v1_id), tA_id, tB_id, g, li);
+        checkSingleCoplanarEdgeIntersections(ts, arena, tA_id, static_cast<uint>(tmp_edge_id), tB_id, g, li);
     }
 
     // a vertex of tA is coplanar to tB, and the opposite edge is on the same side respect to tB  (e.g. orAB: 1 0 1)
@@ -253,7 +276,7 @@ inline void checkTriangleTriangleIntersections(TriangleSoup &ts, point_arena& ar
         uint real_v_id = ts.triVertID(tA_id, static_cast<uint>(tmp_vtx_id));
         checkVtxInTriangleIntersection(ts, real_v_id, tB_id, v_tmp, g, li);
 
-        uint opp_edge_id = ts.edgeOppositeToVert(tA_id, ts.triVertID(tA_id, static_cast<uint>(tmp_vtx_id)));
+        uint opp_edge_id = ts.triEdgeOppositeTo(tA_id, static_cast<uint>(tmp_vtx_id));
         checkSingleNoCoplanarEdgeIntersection(ts, arena, opp_edge_id, tB_id, v_tmp, g, li);
     }
 
@@ -261,16 +284,12 @@ inline void checkTriangleTriangleIntersections(TriangleSoup &ts, point_arena& ar
     tmp_vtx_id = vtxOnASideAndOppositeEdgeOnTheOther(orAB, opp_v0, opp_v1);
     if(tmp_vtx_id != -1)
     {
-        uint id_v = ts.triVertID(tA_id, static_cast<uint>(tmp_vtx_id));
-        uint id_opp_v0 = ts.triVertID(tA_id, opp_v0);
-        uint id_opp_v1 = ts.triVertID(tA_id, opp_v1);
-
-        int edge_id0 = ts.edgeID(id_v, id_opp_v0);
-        int edge_id1 = ts.edgeID(id_v, id_opp_v1);
-        assert(edge_id0 != -1 && edge_id1 != -1);
+        // the edge (v, opp_v0) is the one opposite to opp_v1 and vice versa
+        uint edge_id0 = ts.triEdgeOppositeTo(tA_id, opp_v1);
+        uint edge_id1 = ts.triEdgeOppositeTo(tA_id, opp_v0);
 
-        checkSingleNoCoplanarEdgeIntersection(ts, arena, static_cast<uint>(edge_id0), tB_id, v_tmp, g, li);
-        checkSingleNoCoplanarEdgeIntersection(ts, arena, static_cast<uint>(edge_id1), tB_id, v_tmp, g, li);
+        checkSingleNoCoplanarEdgeIntersection(ts, arena, edge_id0, tB_id, v_tmp, g, li);
+        checkSingleNoCoplanarEdgeIntersection(ts, arena, edge_id1, tB_id, v_tmp, g, li);
     }
 
 
@@ -431,10 +450,14 @@ inline uint noCoplanarJollyPointID(const TriangleSoup &ts, const double *v0, con
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-inline void checkSingleCoplanarEdgeIntersections(TriangleSoup &ts, point_arena& arena, uint e_v0, uint e_v1,
-                                                 uint e_t_id, uint o_t_id,
+inline void checkSingleCoplanarEdgeIntersections(TriangleSoup &ts, point_arena& arena, uint e_t_id, uint e_off, uint o_t_id,
                                                  AuxiliaryStructure &g, phmap::flat_hash_set<uint> &il) // il -> intersection list
 {
+    // the tested edge is the e_off-th edge of e_t_id
+    uint e_v0 = ts.triVertID(e_t_id, e_off);
+    uint e_v1 = ts.triVertID(e_t_id, (e_off + 1) % 3);
+    int curr_e_id = static_cast<int>(ts.triEdgeID(e_t_id, e_off));
+
     bool  v0_in_vtx = false,    v1_in_vtx = false;
     int  v0_in_seg = -1,        v1_in_seg = -1;
     bool v0_in_tri = false,     v1_in_tri = false;
@@ -559,7 +582,6 @@ inline void checkSingleCoplanarEdgeIntersections(TriangleSoup &ts, point_arena&
     bool tv2_in_edge = cinolib::point_in_segment_3d(ts.triVertPtr(o_t_id, 2), ts.vertPtr(e_v0), ts.vertPtr(e_v1)) != cinolib::STRICTLY_OUTSIDE;
 
     int seg0_cross = -1, seg1_cross = -1, seg2_cross = -1;
-    int curr_e_id = ts.edgeID(e_v0, e_v1);
 
     if(v0_in_seg != o_t_e0 && v1_in_seg != o_t_e0 && !tv0_in_edge && !tv1_in_edge &&
        cinolib::segment_segment_intersect_3d(ts.vertPtr(e_v0), ts.vertPtr(e_v1), ts.triVertPtr(o_t_id, 0), ts.triVertPtr(o_t_id, 1)) == cinolib::INTERSECT &&
@@ -583,11 +605,9 @@ inline void checkSingleCoplanarEdgeIntersections(TriangleSoup &ts, point_arena&
         {
             addSymbolicSegment(ts,ts.triVertID(o_t_id, 2), static_cast<uint>(seg0_cross), o_t_id, e_t_id, g);
             uint v_id = ts.triVertID(o_t_id, 2);
-            int edge_id = ts.edgeID(e_v0, e_v1);
-            assert(edge_id != -1 && "edge not found!");
 
             il.insert(v_id);
-            g.addVertexInEdge(edge_id, v_id);
+            g.addVertexInEdge(static_cast<uint>(curr_e_id), v_id);
 
             return;
         }
@@ -615,11 +635,9 @@ inline void checkSingleCoplanarEdgeIntersections(TriangleSoup &ts, point_arena&
         {
             addSymbolicSegment(ts, ts.triVertID(o_t_id, 0), static_cast<uint>(seg1_cross), o_t_id, e_t_id, g);
             uint v_id = ts.triVertID(o_t_id, 0);
-            int edge_id = ts.edgeID(e_v0, e_v1);
-            assert(edge_id != 0 && "edge not foubd!");
 
             il.insert(v_id);
-            g.addVertexInEdge(edge_id, v_id);
+            g.addVertexInEdge(static_cast<uint>(curr_e_id), v_id);
 
             return;
         }
@@ -647,11 +665,9 @@ inline void checkSingleCoplanarEdgeIntersections(TriangleSoup &ts, point_arena&
         {
             addSymbolicSegment(ts, ts.triVertID(o_t_id, 1), static_cast<uint>(seg2_cross), o_t_id, e_t_id, g);
             uint v_id = ts.triVertID(o_t_id, 1);
-            int edge_id = ts.edgeID(e_v0, e_v1);
-            assert(edge_id != 0 && "edge not found!");
 
             il.insert(v_id);
-            g.addVertexInEdge(edge_id, v_id);
+            g.addVertexInEdge(static_cast<uint>(curr_e_id), v_id);
 
             return;
         }
@@ -43,6 +43,7 @@
 
 #include "triangle_soup.h"
 #include "aux_structure.h"
+#include "orient3d_batch.h"
 #include <cinolib/predicates.h>
 
 #pragma GCC diagnostic ignored "-Wfloat-equal"
@@ -52,9 +53,11 @@ inline void find_intersections(const std::vector<cinolib::vec3d> & verts, const
 
 inline void detectIntersections(const TriangleSoup &ts, phmap::flat_hash_set<std::pair<uint, uint> > &intersection_list);
 
-inline void classifyIntersections(TriangleSoup &ts, point_arena& arena, AuxiliaryStructure &g);
+// progress, if given, counts the intersecting pairs and the implicit points, and may cancel the classification (see ProgressMonitor)
+inline void classifyIntersections(TriangleSoup &ts, point_arena& arena, AuxiliaryStructure &g, ProgressMonitor *progress = nullptr);
 
-inline void checkTriangleTriangleIntersections(TriangleSoup &ts, point_arena& arena, AuxiliaryStructure &g, uint tA_id, uint tB_id);
+// orBA_signs: orientation of the vertices of tB with respect to the plane of tA, see classifyIntersections
+inline void checkTriangleTriangleIntersections(TriangleSoup &ts, point_arena& arena, AuxiliaryStructure &g, uint tA_id, uint tB_id, const int orBA_signs[3]);
 
 inline uint addEdgeCrossEdgeInters(TriangleSoup &ts, point_arena& arena, uint e0_id, uint e1_id, AuxiliaryStructure &g);
 
@@ -66,8 +69,8 @@ inline void addSymbolicSegment(const TriangleSoup &ts, uint v0_id, uint v1_id, u
 
 inline uint noCoplanarJollyPointID(const TriangleSoup &ts, const double *v0, const double *v1, const double *v2);
 
-inline void checkSingleCoplanarEdgeIntersections(TriangleSoup &ts, point_arena& arena, uint e_v0, uint e_v1,
-                                                 uint e_t_id, uint o_t_id, AuxiliaryStructure &g, phmap::flat_hash_set<uint> &il);
+inline void checkSingleCoplanarEdgeIntersections(TriangleSoup &ts, point_arena& arena, uint e_t_id, uint e_off, uint o_t_id,
+                                                 AuxiliaryStructure &g, phmap::flat_hash_set<uint> &il);
 
 inline void checkSingleNoCoplanarEdgeIntersection(TriangleSoup &ts, point_arena& arena, uint e_id, uint t_id,
                                                   phmap::flat_hash_set<uint> &v_tmp, AuxiliaryStructure &g, phmap::flat_hash_set<uint> &li);
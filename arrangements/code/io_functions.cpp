@@ -39,80 +39,782 @@
 
 #include <cinolib/octree.h>
 
-inline void load(const std::string &filename, std::vector<double> &coords, std::vector<uint> &tris)
+#include <cstring>
+
+#if ENABLE_MULTITHREADING
+    #include <tbb/tbb.h>
+#endif
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define IO_FUNCTIONS_MMAP 1
+#endif
+
+inline MappedFile::MappedFile(const std::string &filename)
 {
-    std::vector<cinolib::vec3d> tmp_verts;
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if(file != INVALID_HANDLE_VALUE)
+    {
+        LARGE_INTEGER file_size;
+        if(GetFileSizeEx(file, &file_size))
+        {
+            is_open = true;
+            len = static_cast<size_t>(file_size.QuadPart);
+            mapping = len ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+            if(mapping)
+            {
+                ptr = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                is_mapped = (ptr != nullptr);
+                if(!is_mapped) { CloseHandle(mapping); mapping = nullptr; }
+            }
+        }
+        CloseHandle(file);
+        if(!is_open || is_mapped || !len) return;
+    }
+#elif IO_FUNCTIONS_MMAP
+    int fd = open(filename.c_str(), O_RDONLY);
+    if(fd >= 0)
+    {
+        struct stat st;
+        if(fstat(fd, &st) == 0)
+        {
+            is_open = true;
+            len = static_cast<size_t>(st.st_size);
+            void *addr = len ? mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+            if(addr != MAP_FAILED)
+            {
+                #ifdef MADV_WILLNEED
+                madvise(addr, len, MADV_WILLNEED);
+                #endif
+                ptr = static_cast<const char*>(addr);
+                is_mapped = true;
+            }
+        }
+        close(fd);
+        if(!is_open || is_mapped || !len) return;
+    }
+#endif
+
+    // no mapping available: plain read
+    std::ifstream f(filename, std::ios::binary | std::ios::ate);
+    if(!f.is_open()) { is_open = false; len = 0; return; }
+    buffer.resize(static_cast<size_t>(f.tellg()));
+    f.seekg(0);
+    is_open = static_cast<bool>(f.read(buffer.data(), static_cast<std::streamsize>(buffer.size())));
+    ptr = buffer.data();
+    len = is_open ? buffer.size() : 0;
+}
 
-    std::string filetype = filename.substr(filename.size() - 4, 4);
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline MappedFile::~MappedFile()
+{
+    if(!is_mapped) return;
+#if defined(_WIN32)
+    UnmapViewOfFile(ptr);
+    CloseHandle(mapping);
+#elif IO_FUNCTIONS_MMAP
+    munmap(const_cast<char*>(ptr), len);
+#endif
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+namespace io_detail
+{
+
+inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; }
+
+inline void skipBlanks(const char *&p, const char *end) { while(p < end && isBlank(*p)) p++; }
+
+inline const char *lineEnd(const char *p, const char *end)
+{
+    const char *eol = static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(end - p)));
+    return eol ? eol : end;
+}
+
+// parses the number starting at p (after any blank) with the same rounding as strtod, and moves p past it
+inline bool parseDouble(const char *&p, const char *end, double &x)
+{
+    skipBlanks(p, end);
+    if(p < end && *p == '+' && p + 1 < end && p[1] != '-') p++; // from_chars rejects an explicit plus sign
+
+#if defined(__cpp_lib_to_chars)
+    std::from_chars_result res = std::from_chars(p, end, x);
+    if(res.ec == std::errc()) { p = res.ptr; return true; }
+    if(res.ec != std::errc::result_out_of_range) return false;
+#endif
+
+    // strtod needs a terminated string: the token is copied (out of range values become 0 or inf, as with sscanf)
+    char token[128];
+    size_t n = 0;
+    while(p + n < end && n < sizeof(token) - 1 && !isBlank(p[n]) && p[n] != '\n') { token[n] = p[n]; n++; }
+    token[n] = '\0';
+    char *token_end;
+    x = strtod(token, &token_end);
+    if(token_end == token) return false;
+    p += token_end - token;
+    return true;
+}
+
+inline bool parseInt(const char *&p, const char *end, int64_t &i)
+{
+    skipBlanks(p, end);
+    if(p < end && *p == '+') p++;
+    std::from_chars_result res = std::from_chars(p, end, i);
+    if(res.ec != std::errc()) return false;
+    p = res.ptr;
+    return true;
+}
+
+template<typename Fn>
+inline void forEach(uint begin, uint end, bool parallel, const Fn &fn)
+{
+#if ENABLE_MULTITHREADING
+    if(parallel) { tbb::parallel_for(begin, end, fn); return; }
+#endif
+    for(uint i = begin; i < end; i++) fn(i);
+}
+
+// lines of an OBJ file parsed on their own: the vertex ids of faces are file-wise (or relative to the vertices
+// before them in the chunk, for negative indices, until the chunks are joined)
+struct OBJChunk
+{
+    std::vector<double>  coords;
+    std::vector<int64_t> tris;
+    std::vector<size_t>  relative; // positions in tris of the ids relative to the chunk
+    bool ok = true;
+};
+
+inline void parseOBJChunk(const char *p, const char *end, OBJChunk &chunk)
+{
+    std::vector<int64_t> poly;
+    std::vector<uint8_t> poly_relative;
 
-    if (filetype.compare(".off") == 0 || filetype.compare(".OFF") == 0)
+    for(; p < end; p++)
     {
-        std::vector< std::vector<uint> > tmp_tris;
-        cinolib::read_OFF(filename.c_str(), tmp_verts, tmp_tris);
-        tris = cinolib::serialized_vids_from_polys(tmp_tris);
+        const char *eol = lineEnd(p, end);
+
+        if(eol - p > 1 && isBlank(p[1]))
+        {
+            const char *q = p + 1;
+
+            if(p[0] == 'v')
+            {
+                double xyz[3];
+                if(parseDouble(q, eol, xyz[0]) && parseDouble(q, eol, xyz[1]) && parseDouble(q, eol, xyz[2]))
+                    chunk.coords.insert(chunk.coords.end(), xyz, xyz + 3);
+            }
+            else if(p[0] == 'f')
+            {
+                poly.clear();
+                poly_relative.clear();
+                for(skipBlanks(q, eol); q < eol; skipBlanks(q, eol))
+                {
+                    int64_t id;
+                    if(!parseInt(q, eol, id) || id == 0) { chunk.ok = false; return; }
+
+                    poly_relative.push_back(id < 0);
+                    poly.push_back(id < 0 ? id + static_cast<int64_t>(chunk.coords.size() / 3) : id - 1);
+                    while(q < eol && !isBlank(*q)) q++; // texture and normal ids
+                }
+
+                for(size_t i = 1; i + 1 < poly.size(); i++)
+                {
+                    for(size_t c : {size_t(0), i, i + 1})
+                    {
+                        if(poly_relative[c]) chunk.relative.push_back(chunk.tris.size());
+                        chunk.tris.push_back(poly[c]);
+                    }
+                }
+            }
+        }
+
+        p = eol;
     }
-    else if (filetype.compare(".obj") == 0 || filetype.compare(".OBJ") == 0)
+}
+
+} // namespace io_detail
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline bool parseOBJ(const char *data, size_t size, std::vector<double> &coords, std::vector<uint> &tris, bool parallel)
+{
+    using namespace io_detail;
+
+    const char *end = data + size;
+    const size_t chunk_size = 1 << 20;
+
+    // chunk boundaries at line starts
+    std::vector<const char*> bounds = {data};
+    while(static_cast<size_t>(end - bounds.back()) > chunk_size)
     {
-        std::vector< std::vector<uint> > tmp_tris;
-        cinolib::read_OBJ(filename.c_str(), tmp_verts, tmp_tris);
-        tris = cinolib::serialized_vids_from_polys(tmp_tris);
+        const char *b = lineEnd(bounds.back() + chunk_size, end);
+        if(b == end) break;
+        bounds.push_back(b + 1);
     }
-    else if (filetype.compare(".stl") == 0 || filetype.compare(".STL") == 0)
+    bounds.push_back(end);
+
+    uint num_chunks = static_cast<uint>(bounds.size() - 1);
+    std::vector<OBJChunk> chunks(num_chunks);
+    forEach(0, num_chunks, parallel, [&](uint c) { parseOBJChunk(bounds[c], bounds[c + 1], chunks[c]); });
+
+    std::vector<size_t> vert_offset(num_chunks + 1, 0), tri_offset(num_chunks + 1, 0);
+    for(uint c = 0; c < num_chunks; c++)
     {
-        cinolib::read_STL(filename.c_str(), tmp_verts, tris, false);
+        if(!chunks[c].ok) return false;
+        vert_offset[c + 1] = vert_offset[c] + chunks[c].coords.size() / 3;
+        tri_offset[c + 1] = tri_offset[c] + chunks[c].tris.size();
+    }
+
+    const int64_t num_verts = static_cast<int64_t>(vert_offset[num_chunks]);
+    if(num_verts > std::numeric_limits<uint>::max()) return false;
+
+    coords.resize(3 * vert_offset[num_chunks]);
+    tris.resize(tri_offset[num_chunks]);
+
+    std::vector<uint8_t> ok(num_chunks, 1);
+    forEach(0, num_chunks, parallel, [&](uint c)
+    {
+        OBJChunk &chunk = chunks[c];
+        for(size_t pos : chunk.relative) chunk.tris[pos] += static_cast<int64_t>(vert_offset[c]);
+
+        std::copy(chunk.coords.begin(), chunk.coords.end(), coords.begin() + 3 * vert_offset[c]);
+        for(size_t i = 0; i < chunk.tris.size(); i++)
+        {
+            int64_t id = chunk.tris[i];
+            if(id < 0 || id >= num_verts) { ok[c] = 0; return; }
+            tris[tri_offset[c] + i] = static_cast<uint>(id);
+        }
+    });
+
+    return std::find(ok.begin(), ok.end(), 0) == ok.end();
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline bool parseOFF(const char *data, size_t size, std::vector<double> &coords, std::vector<uint> &tris)
+{
+    using namespace io_detail;
+
+    const char *p = data, *end = data + size;
+    int64_t nv = -1, np = -1, ne = -1;
+
+    // header keyword, then the first line with the three counts (possibly the keyword line itself)
+    const char *eol = p;
+    for(; p < end; p = eol + 1)
+    {
+        eol = lineEnd(p, end);
+        const char *key = std::search(p, eol, "OFF", "OFF" + 3);
+        if(key != eol) { p = key + 3; break; }
+    }
+    for(; p < end; p = eol + 1)
+    {
+        eol = lineEnd(p, end);
+        const char *q = p;
+        if(parseInt(q, eol, nv) && parseInt(q, eol, np) && parseInt(q, eol, ne)) { p = eol + 1; break; }
+        nv = -1;
+    }
+    if(nv < 0 || np < 0 || nv > std::numeric_limits<uint>::max()) return false;
+
+    coords.resize(3 * static_cast<size_t>(nv));
+    for(int64_t v_id = 0; v_id < nv; p = eol + 1)
+    {
+        if(p >= end) return false;
+        eol = lineEnd(p, end);
+        const char *q = p;
+        double *xyz = coords.data() + 3 * v_id;
+        if(parseDouble(q, eol, xyz[0]) && parseDouble(q, eol, xyz[1]) && parseDouble(q, eol, xyz[2])) v_id++;
+    }
+
+    tris.clear();
+    tris.reserve(3 * static_cast<size_t>(np));
+    std::vector<uint> poly;
+    for(int64_t p_id = 0; p_id < np; p = eol + 1)
+    {
+        if(p >= end) return false;
+        eol = lineEnd(p, end);
+        const char *q = p;
+        int64_t n_corners;
+        if(!parseInt(q, eol, n_corners)) continue; // blank line or comment
+        p_id++;
+
+        poly.clear();
+        for(int64_t i = 0; i < n_corners; i++)
+        {
+            int64_t id;
+            if(!parseInt(q, eol, id) || id < 0 || id >= nv) return false;
+            poly.push_back(static_cast<uint>(id));
+        }
+
+        for(size_t i = 1; i + 1 < poly.size(); i++)
+            tris.insert(tris.end(), {poly[0], poly[i], poly[i + 1]});
+    }
+
+    return true;
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline bool parseSTL(const char *data, size_t size, std::vector<double> &coords, std::vector<uint> &tris, bool parallel)
+{
+    using namespace io_detail;
+
+    // binary files are recognized by their size, as some of them start with "solid" as ASCII ones do
+    uint32_t nt = 0;
+    if(size >= 84) memcpy(&nt, data + 80, sizeof(uint32_t));
+    bool binary = (size >= 84 && size == 84 + 50 * static_cast<uint64_t>(nt));
+
+    if(binary)
+    {
+        // each record is a normal, three vertices as float triplets and a 2-byte attribute
+        coords.resize(9 * static_cast<size_t>(nt));
+        forEach(0, nt, parallel, [&](uint t_id)
+        {
+            float xyz[9];
+            memcpy(xyz, data + 84 + 50 * static_cast<size_t>(t_id) + 12, sizeof(xyz));
+            std::copy(xyz, xyz + 9, coords.begin() + 9 * static_cast<size_t>(t_id));
+        });
     }
     else
     {
-        std::cerr << "ERROR: file format not supported yet " << std::endl;
+        const char *p = data, *end = data + size;
+        skipBlanks(p, end);
+        if(end - p < 5 || memcmp(p, "solid", 5) != 0) return false;
+
+        const char *keyword = "vertex";
+        coords.clear();
+        for(p = std::search(p, end, keyword, keyword + 6); p != end; p = std::search(p, end, keyword, keyword + 6))
+        {
+            p += 6;
+            double xyz[3];
+            if(!parseDouble(p, end, xyz[0]) || !parseDouble(p, end, xyz[1]) || !parseDouble(p, end, xyz[2])) return false;
+            coords.insert(coords.end(), xyz, xyz + 3);
+        }
+        if(coords.size() % 9 != 0) return false;
     }
 
-    coords = cinolib::serialized_xyz_from_vec3d(tmp_verts);
+    tris.resize(coords.size() / 3);
+    for(uint i = 0; i < tris.size(); i++) tris[i] = i;
+    return true;
 }
 
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-inline void loadMultipleFiles(const std::vector<std::string> &files, std::vector<double> &coords, std::vector<uint> &tris, std::vector<uint> &labels)
+inline bool viewMeshFile(const char *data, size_t size, MeshFileView &view)
 {
-    for(uint f_id = 0; f_id < files.size(); f_id++)
+    MeshFileHeader header;
+    if(size < sizeof(header)) return false;
+    if(reinterpret_cast<uintptr_t>(data) % 8 != 0) return false; // the sections are used in place
+    memcpy(&header, data, sizeof(header));
+
+    if(memcmp(header.magic, MESH_FILE_MAGIC, sizeof(MESH_FILE_MAGIC)) != 0 || header.version != MESH_FILE_VERSION) return false;
+    if(header.file_size != size) return false;
+
+    const bool has_labels = (header.flags & MESH_FILE_LABELS) != 0;
+    const uint64_t coord_size = (header.flags & MESH_FILE_DOUBLE) ? sizeof(double) : sizeof(float);
+    const uint64_t offsets[3] = {header.positions_offset, header.indices_offset, has_labels ? header.labels_offset : 0};
+    const uint64_t bytes[3] = {3 * coord_size * header.num_verts, 3 * sizeof(uint32_t) * static_cast<uint64_t>(header.num_tris),
+                               has_labels ? sizeof(uint32_t) * static_cast<uint64_t>(header.num_tris) : 0};
+    for(uint s = 0; s < 3; s++)
     {
-        std::vector<double> tmp_coords;
-        std::vector<uint> tmp_tris;
+        if(!bytes[s]) continue;
+        if(offsets[s] % 8 != 0 || offsets[s] < sizeof(header) || offsets[s] > size || bytes[s] > size - offsets[s]) return false;
+    }
 
-        load(files[f_id], tmp_coords, tmp_tris);
+    view.num_verts   = header.num_verts;
+    view.num_tris    = header.num_tris;
+    view.positions_f = (header.flags & MESH_FILE_DOUBLE) ? nullptr : reinterpret_cast<const float*>(data + header.positions_offset);
+    view.positions_d = (header.flags & MESH_FILE_DOUBLE) ? reinterpret_cast<const double*>(data + header.positions_offset) : nullptr;
+    view.indices     = reinterpret_cast<const uint32_t*>(data + header.indices_offset);
+    view.labels      = has_labels ? reinterpret_cast<const uint32_t*>(data + header.labels_offset) : nullptr;
 
-        uint off = static_cast<uint>(coords.size() / 3); // prev num verts
+    for(uint64_t i = 0; i < 3 * static_cast<uint64_t>(view.num_tris); i++)
+        if(view.indices[i] >= view.num_verts) return false;
 
-        coords.insert(coords.end(), tmp_coords.begin(), tmp_coords.end());
+    return true;
+}
 
-        for(auto &i : tmp_tris) tris.push_back(i + off);
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        for(uint i = 0; i < tmp_tris.size() / 3; i++)
-            labels.push_back(f_id);
+inline bool parseCMB(const char *data, size_t size, std::vector<double> &coords, std::vector<uint> &tris, std::vector<uint> *labels)
+{
+    MeshFileView view;
+    if(!viewMeshFile(data, size, view)) return false;
+
+    if(view.positions_d) coords.assign(view.positions_d, view.positions_d + 3 * static_cast<size_t>(view.num_verts));
+    else                 coords.assign(view.positions_f, view.positions_f + 3 * static_cast<size_t>(view.num_verts));
+    tris.assign(view.indices, view.indices + 3 * static_cast<size_t>(view.num_tris));
+    if(labels)
+    {
+        if(view.labels) labels->assign(view.labels, view.labels + view.num_tris);
+        else            labels->assign(view.num_tris, 0);
     }
+    return true;
 }
 
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-inline void loadMultipleFiles(const std::vector<std::string> &files, std::vector<double> &coords, std::vector<uint> &tris, std::vector<uint> &labels, int &vert_offset)
+inline void load(const std::string &filename, std::vector<double> &coords, std::vector<uint> &tris, bool parallel)
 {
+    coords.clear();
+    tris.clear();
+
+    std::string filetype = filename.substr(filename.size() - 4, 4);
+
+    enum { OFF, OBJ, STL, CMB, UNKNOWN } format = UNKNOWN;
+    if (filetype.compare(".off") == 0 || filetype.compare(".OFF") == 0)      format = OFF;
+    else if (filetype.compare(".obj") == 0 || filetype.compare(".OBJ") == 0) format = OBJ;
+    else if (filetype.compare(".stl") == 0 || filetype.compare(".STL") == 0) format = STL;
+    else if (filetype.compare(".cmb") == 0 || filetype.compare(".CMB") == 0) format = CMB;
+    else
+    {
+        std::cerr << "ERROR: file format not supported yet " << std::endl;
+        return;
+    }
+
+    MappedFile file(filename);
+    if(!file.isOpen())
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load() : couldn't open input file " << filename << std::endl;
+        exit(-1);
+    }
+
+    bool ok = (format == OFF) ? parseOFF(file.data(), file.size(), coords, tris) :
+              (format == OBJ) ? parseOBJ(file.data(), file.size(), coords, tris, parallel) :
+              (format == STL) ? parseSTL(file.data(), file.size(), coords, tris, parallel) :
+                                parseCMB(file.data(), file.size(), coords, tris);
+    if(!ok)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load() : malformed input file " << filename << std::endl;
+        coords.clear();
+        tris.clear();
+    }
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline void loadMultipleFiles(const std::vector<std::string> &files, std::vector<double> &coords, std::vector<uint> &tris, std::vector<uint> &labels, bool parallel)
+{
+    int vert_offset;
+    loadMultipleFiles(files, coords, tris, labels, vert_offset, parallel);
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline void loadMultipleFiles(const std::vector<std::string> &files, std::vector<double> &coords, std::vector<uint> &tris, std::vector<uint> &labels, int &vert_offset, bool parallel)
+{
+    std::vector<std::vector<double>> file_coords(files.size());
+    std::vector<std::vector<uint>> file_tris(files.size());
+
+    io_detail::forEach(0, static_cast<uint>(files.size()), parallel, [&](uint f_id)
+    {
+        load(files[f_id], file_coords[f_id], file_tris[f_id], parallel);
+    });
+
     for(uint f_id = 0; f_id < files.size(); f_id++)
     {
         vert_offset = coords.size();
 
-        std::vector<double> tmp_coords;
-        std::vector<uint> tmp_tris;
+        uint off = static_cast<uint>(coords.size() / 3); // prev num verts
 
-        load(files[f_id], tmp_coords, tmp_tris);
+        coords.insert(coords.end(), file_coords[f_id].begin(), file_coords[f_id].end());
 
-        uint off = static_cast<uint>(coords.size() / 3); // prev num verts
+        for(auto &i : file_tris[f_id]) tris.push_back(i + off);
 
-        coords.insert(coords.end(), tmp_coords.begin(), tmp_coords.end());
+        labels.insert(labels.end(), file_tris[f_id].size() / 3, f_id);
+    }
+}
 
-        for(auto &i : tmp_tris) tris.push_back(i + off);
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        for(uint i = 0; i < tmp_tris.size() / 3; i++)
-            labels.push_back(f_id);
+inline BufferedFileWriter::BufferedFileWriter(const std::string &filename, size_t buffer_size)
+    : current(buffer_size), in_flight(buffer_size)
+{
+    fp = fopen(filename.c_str(), "wb");
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline BufferedFileWriter::~BufferedFileWriter()
+{
+    close();
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline char *BufferedFileWriter::reserve(size_t n)
+{
+    if(used + n > current.size())
+    {
+        flush();
+        if(n > current.size()) current.resize(n);
+    }
+    return current.data() + used;
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline void BufferedFileWriter::write(const void *data, size_t n)
+{
+    char *p = reserve(n);
+    memcpy(p, data, n);
+    advance(p + n);
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline void BufferedFileWriter::flush()
+{
+    if(pending.valid()) ok &= pending.get();
+    if(!used || !fp) return;
+
+    std::swap(current, in_flight);
+    if(current.size() < in_flight.size()) current.resize(in_flight.size());
+    size_t n = used;
+    used = 0;
+
+    auto write_buffer = [this, n]() { return fwrite(in_flight.data(), 1, n, fp) == n; };
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    ok &= write_buffer();
+#else
+    pending = std::async(std::launch::async, write_buffer);
+#endif
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline bool BufferedFileWriter::close()
+{
+    if(!fp) return false;
+    flush();
+    if(pending.valid()) ok &= pending.get();
+    ok &= (fclose(fp) == 0);
+    fp = nullptr;
+    return ok;
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+namespace io_detail
+{
+
+// shortest text that reads back to the same double (the coords of cmb results are floats, written as doubles)
+inline char *formatDouble(char *p, double x)
+{
+#if defined(__cpp_lib_to_chars)
+    return std::to_chars(p, p + 32, x).ptr;
+#else
+    return p + snprintf(p, 32, "%.17g", x);
+#endif
+}
+
+inline char *formatUint(char *p, uint64_t i)
+{
+    return std::to_chars(p, p + 24, i).ptr;
+}
+
+template<typename T>
+inline bool writeTextMesh(const std::string &filename, const T *coords, uint num_verts, const uint *tris, uint num_tris, bool obj)
+{
+    BufferedFileWriter out(filename);
+    if(!out.isOpen()) return false;
+
+    if(!obj)
+    {
+        char *p = out.reserve(64);
+        memcpy(p, "OFF\n", 4);
+        p = formatUint(p + 4, num_verts);   *p++ = ' ';
+        p = formatUint(p, num_tris);        memcpy(p, " 0\n", 3);
+        out.advance(p + 3);
+    }
+
+    for(uint v_id = 0; v_id < num_verts; v_id++)
+    {
+        char *p = out.reserve(128);
+        if(obj) { *p++ = 'v'; *p++ = ' '; }
+        p = formatDouble(p, static_cast<double>(coords[3 * v_id]));       *p++ = ' ';
+        p = formatDouble(p, static_cast<double>(coords[3 * v_id + 1]));   *p++ = ' ';
+        p = formatDouble(p, static_cast<double>(coords[3 * v_id + 2]));   *p++ = '\n';
+        out.advance(p);
+    }
+
+    const uint base = obj ? 1 : 0;
+    for(uint t_id = 0; t_id < num_tris; t_id++)
+    {
+        char *p = out.reserve(64);
+        *p++ = obj ? 'f' : '3';                         *p++ = ' ';
+        p = formatUint(p, tris[3 * t_id] + base);       *p++ = ' ';
+        p = formatUint(p, tris[3 * t_id + 1] + base);   *p++ = ' ';
+        p = formatUint(p, tris[3 * t_id + 2] + base);   *p++ = '\n';
+        out.advance(p);
+    }
+
+    return out.close();
+}
+
+} // namespace io_detail
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+inline bool writeOBJ(const std::string &filename, const T *coords, uint num_verts, const uint *tris, uint num_tris)
+{
+    return io_detail::writeTextMesh(filename, coords, num_verts, tris, num_tris, true);
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+inline bool writeOFF(const std::string &filename, const T *coords, uint num_verts, const uint *tris, uint num_tris)
+{
+    return io_detail::writeTextMesh(filename, coords, num_verts, tris, num_tris, false);
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+inline bool writeSTL(const std::string &filename, const T *coords, uint num_verts, const uint *tris, uint num_tris)
+{
+    BufferedFileWriter out(filename);
+    if(!out.isOpen()) return false;
+
+    char header[80] = "binary STL";
+    out.write(header, sizeof(header));
+    uint32_t nt = num_tris;
+    out.write(&nt, sizeof(nt));
+
+    for(uint t_id = 0; t_id < num_tris; t_id++)
+    {
+        double v[3][3];
+        for(uint i = 0; i < 3; i++)
+        {
+            uint v_id = tris[3 * t_id + i];
+            assert(v_id < num_verts && "vertex id out of range");
+            for(uint j = 0; j < 3; j++) v[i][j] = static_cast<double>(coords[3 * v_id + j]);
+        }
+
+        double e0[3] = {v[1][0] - v[0][0], v[1][1] - v[0][1], v[1][2] - v[0][2]};
+        double e1[3] = {v[2][0] - v[0][0], v[2][1] - v[0][1], v[2][2] - v[0][2]};
+        double n[3] = {e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2], e0[0] * e1[1] - e0[1] * e1[0]};
+        double len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if(len > 0) for(double &c : n) c /= len;
+
+        // normal, vertices and a zero attribute: 50 bytes
+        float record[12] = {float(n[0]), float(n[1]), float(n[2]),
+                            float(v[0][0]), float(v[0][1]), float(v[0][2]),
+                            float(v[1][0]), float(v[1][1]), float(v[1][2]),
+                            float(v[2][0]), float(v[2][1]), float(v[2][2])};
+        char *p = out.reserve(50);
+        memcpy(p, record, sizeof(record));
+        memset(p + sizeof(record), 0, 2);
+        out.advance(p + 50);
     }
+
+    return out.close();
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+inline bool writePLY(const std::string &filename, const T *coords, uint num_verts, const uint *tris, uint num_tris)
+{
+    static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value, "unsupported coordinate type");
+
+    BufferedFileWriter out(filename);
+    if(!out.isOpen()) return false;
+
+    const char *type = std::is_same<T, float>::value ? "float" : "double";
+    std::string header = "ply\nformat binary_little_endian 1.0\nelement vertex " + std::to_string(num_verts) + "\n"
+                         "property " + type + " x\nproperty " + type + " y\nproperty " + type + " z\n"
+                         "element face " + std::to_string(num_tris) + "\nproperty list uchar uint vertex_indices\nend_header\n";
+    out.write(header.data(), header.size());
+    out.write(coords, 3 * sizeof(T) * static_cast<size_t>(num_verts));
+
+    for(uint t_id = 0; t_id < num_tris; t_id++)
+    {
+        char *p = out.reserve(13);
+        *p = 3;
+        memcpy(p + 1, tris + 3 * t_id, 3 * sizeof(uint));
+        out.advance(p + 13);
+    }
+
+    return out.close();
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+inline bool writeCMB(const std::string &filename, const T *coords, uint num_verts, const uint *tris, uint num_tris, const uint *labels)
+{
+    static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value, "unsupported coordinate type");
+    static_assert(sizeof(uint) == sizeof(uint32_t), "indices are stored as uint32_t");
+
+    BufferedFileWriter out(filename);
+    if(!out.isOpen()) return false;
+
+    auto aligned = [](uint64_t offset) { return (offset + 7) & ~uint64_t(7); };
+
+    MeshFileHeader header = {};
+    memcpy(header.magic, MESH_FILE_MAGIC, sizeof(MESH_FILE_MAGIC));
+    header.version          = MESH_FILE_VERSION;
+    header.flags            = (std::is_same<T, double>::value ? MESH_FILE_DOUBLE : 0) | (labels ? MESH_FILE_LABELS : 0);
+    header.num_verts        = num_verts;
+    header.num_tris         = num_tris;
+    header.positions_offset = aligned(sizeof(header));
+    header.indices_offset   = aligned(header.positions_offset + 3 * sizeof(T) * static_cast<uint64_t>(num_verts));
+    uint64_t end            = header.indices_offset + 3 * sizeof(uint32_t) * static_cast<uint64_t>(num_tris);
+    if(labels)
+    {
+        header.labels_offset = aligned(end);
+        end = header.labels_offset + sizeof(uint32_t) * static_cast<uint64_t>(num_tris);
+    }
+    header.file_size = end;
+
+    const char zeros[8] = {};
+    uint64_t written = 0;
+    auto section = [&](uint64_t offset, const void *data, uint64_t bytes)
+    {
+        out.write(zeros, offset - written);
+        out.write(data, bytes);
+        written = offset + bytes;
+    };
+
+    section(0, &header, sizeof(header));
+    section(header.positions_offset, coords, 3 * sizeof(T) * static_cast<uint64_t>(num_verts));
+    section(header.indices_offset, tris, 3 * sizeof(uint32_t) * static_cast<uint64_t>(num_tris));
+    if(labels) section(header.labels_offset, labels, sizeof(uint32_t) * static_cast<uint64_t>(num_tris));
+
+    return out.close();
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+inline bool saveMesh(const std::string &filename, const T *coords, uint num_verts, const uint *tris, uint num_tris)
+{
+    std::string filetype = filename.substr(filename.size() - 4, 4);
+
+    if (filetype.compare(".off") == 0 || filetype.compare(".OFF") == 0)         return writeOFF(filename, coords, num_verts, tris, num_tris);
+    else if (filetype.compare(".obj") == 0 || filetype.compare(".OBJ") == 0)    return writeOBJ(filename, coords, num_verts, tris, num_tris);
+    else if (filetype.compare(".stl") == 0 || filetype.compare(".STL") == 0)    return writeSTL(filename, coords, num_verts, tris, num_tris);
+    else if (filetype.compare(".ply") == 0 || filetype.compare(".PLY") == 0)    return writePLY(filename, coords, num_verts, tris, num_tris);
+    else if (filetype.compare(".cmb") == 0 || filetype.compare(".CMB") == 0)    return writeCMB(filename, coords, num_verts, tris, num_tris, nullptr);
+
+    std::cerr << "ERROR: file format not supported yet " << std::endl;
+    return false;
 }
 
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -191,22 +893,8 @@ inline bool fixCoincidentVertices(cinolib::Trimesh<> &m) // return true if the f
 
 inline void save(const std::string &filename, std::vector<double> &coords, std::vector<uint> &tris)
 {
-    std::string filetype = filename.substr(filename.size() - 4, 4);
-
-    std::vector< std::vector<uint> > tmp_tris = cinolib::polys_from_serialized_vids(tris, 3);
-
-    if (filetype.compare(".off") == 0 || filetype.compare(".OFF") == 0)
-    {
-        cinolib::write_OFF(filename.c_str(), coords, tmp_tris);
-    }
-    else if (filetype.compare(".obj") == 0 || filetype.compare(".OBJ") == 0)
-    {
-        cinolib::write_OBJ(filename.c_str(), coords, tmp_tris);
-    }
-    else
-    {
-        std::cerr << "ERROR: file format not supported yet " << std::endl;
-    }
+    if(!saveMesh(filename, coords.data(), static_cast<uint>(coords.size() / 3), tris.data(), static_cast<uint>(tris.size() / 3)))
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : save() : couldn't write output file " << filename << std::endl;
 }
 
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
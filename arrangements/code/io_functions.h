@@ -54,12 +54,152 @@
 
 #include <common.h>
 
-
-inline void load(const std::string &filename, std::vector<double> &coords, std::vector<uint> &tris);
-
-inline void loadMultipleFiles(const std::vector<std::string> &files, std::vector<double> &coords, std::vector<uint> &tris, std::vector<uint> &labels);
-
-inline void loadMultipleFiles(const std::vector<std::string> &files, std::vector<double> &coords, std::vector<uint> &tris, std::vector<uint> &labels, int &vert_offset);
+#include <charconv>
+#include <future>
+
+
+// read-only view of a whole file: memory mapped where the platform allows it, read into memory otherwise
+class MappedFile
+{
+public:
+    inline explicit MappedFile(const std::string &filename);
+    inline ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool isOpen() const { return is_open; }
+    const char *data() const { return ptr; }
+    size_t size() const { return len; }
+
+private:
+    bool is_open = false;
+    bool is_mapped = false;
+    const char *ptr = nullptr;
+    size_t len = 0;
+    std::vector<char> buffer; // file content when it is not mapped
+#ifdef _WIN32
+    void *mapping = nullptr;
+#endif
+};
+
+/* Parsers of the in-memory content of OBJ, OFF and STL files into flat coords and tris. Polygons are fan-triangulated,
+ * STL triangles get three fresh vertices each (as cinolib::read_STL without merge). OBJ files are split into chunks of
+ * lines parsed concurrently when parallel is true. They return false if the content is malformed. */
+inline bool parseOBJ(const char *data, size_t size, std::vector<double> &coords, std::vector<uint> &tris, bool parallel);
+
+inline bool parseOFF(const char *data, size_t size, std::vector<double> &coords, std::vector<uint> &tris);
+
+inline bool parseSTL(const char *data, size_t size, std::vector<double> &coords, std::vector<uint> &tris, bool parallel);
+
+/* Native binary mesh files (.cmb), to skip the parsing of meshes that are loaded again and again. A mapped file can be
+ * used in place (see cmb_mesh_load): the positions and the indices are the arrays cmb_InputMesh points to.
+ *
+ * Layout (native byte order, every section starts at a multiple of 8 bytes from the start of the file):
+ *   MeshFileHeader
+ *   POSITIONS  float (or double, with MESH_FILE_DOUBLE) x y z of each vertex
+ *   INDICES    uint32_t 3 vertex ids per triangle
+ *   LABELS     uint32_t label of each triangle, only with MESH_FILE_LABELS (e.g. the input file of each triangle) */
+
+static constexpr char     MESH_FILE_MAGIC[8] = {'C', 'M', 'B', 'M', 'E', 'S', 'H', '1'};
+static constexpr uint32_t MESH_FILE_VERSION  = 1;
+
+enum MeshFileFlags : uint32_t
+{
+    MESH_FILE_DOUBLE = 1,
+    MESH_FILE_LABELS = 2,
+};
+
+struct MeshFileHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint32_t num_verts;
+    uint32_t num_tris;
+    uint64_t positions_offset; // bytes from the start of the file
+    uint64_t indices_offset;
+    uint64_t labels_offset;    // 0 without MESH_FILE_LABELS
+    uint64_t file_size;
+};
+
+// arrays of a mesh file in memory, pointing into it
+struct MeshFileView
+{
+    uint32_t        num_verts = 0;
+    uint32_t        num_tris  = 0;
+    const float    *positions_f = nullptr; // one of the two, depending on MESH_FILE_DOUBLE
+    const double   *positions_d = nullptr;
+    const uint32_t *indices = nullptr;
+    const uint32_t *labels  = nullptr;     // null if the file has no labels
+};
+
+// false if data is not a valid mesh file (wrong magic or version, sections out of bounds or misaligned, vertex ids out of range)
+inline bool viewMeshFile(const char *data, size_t size, MeshFileView &view);
+
+inline bool parseCMB(const char *data, size_t size, std::vector<double> &coords, std::vector<uint> &tris, std::vector<uint> *labels = nullptr);
+
+inline void load(const std::string &filename, std::vector<double> &coords, std::vector<uint> &tris, bool parallel = true);
+
+// the files are loaded concurrently when parallel is true, and concatenated in the given order
+inline void loadMultipleFiles(const std::vector<std::string> &files, std::vector<double> &coords, std::vector<uint> &tris, std::vector<uint> &labels, bool parallel = true);
+
+inline void loadMultipleFiles(const std::vector<std::string> &files, std::vector<double> &coords, std::vector<uint> &tris, std::vector<uint> &labels, int &vert_offset, bool parallel = true);
+
+// buffered output file: the caller formats into one buffer while the previous one is written by a background thread
+class BufferedFileWriter
+{
+public:
+    inline explicit BufferedFileWriter(const std::string &filename, size_t buffer_size = 1 << 22);
+    inline ~BufferedFileWriter();
+
+    BufferedFileWriter(const BufferedFileWriter &) = delete;
+    BufferedFileWriter &operator=(const BufferedFileWriter &) = delete;
+
+    bool isOpen() const { return fp != nullptr; }
+
+    // room for at least n bytes, to be filled and then committed with advance(end of the written bytes)
+    inline char *reserve(size_t n);
+    void advance(char *end) { used = static_cast<size_t>(end - current.data()); }
+
+    inline void write(const void *data, size_t n);
+
+    // flushes and closes the file, returns false if any write failed
+    inline bool close();
+
+private:
+    inline void flush();
+
+    FILE *fp = nullptr;
+    std::vector<char> current, in_flight;
+    size_t used = 0;
+    std::future<bool> pending;
+    bool ok = true;
+};
+
+/* Writers of triangle meshes straight from flat arrays, e.g. cmb_positions/cmb_indices (float coords) or the output of
+ * computeFinalExplicitResult (double coords). OBJ and OFF coords are written as the shortest text that reads back to the
+ * same double, STL is binary (float coords, normals computed from the vertices), PLY is binary little endian with float
+ * or double coords as given, and so are the .cmb mesh files. saveMesh picks the format from the file extension. They
+ * return false if the file cannot be written. */
+template<typename T>
+inline bool writeOBJ(const std::string &filename, const T *coords, uint num_verts, const uint *tris, uint num_tris);
+
+template<typename T>
+inline bool writeOFF(const std::string &filename, const T *coords, uint num_verts, const uint *tris, uint num_tris);
+
+template<typename T>
+inline bool writeSTL(const std::string &filename, const T *coords, uint num_verts, const uint *tris, uint num_tris);
+
+template<typename T>
+inline bool writePLY(const std::string &filename, const T *coords, uint num_verts, const uint *tris, uint num_tris);
+
+// labels may be null
+template<typename T>
+inline bool writeCMB(const std::string &filename, const T *coords, uint num_verts, const uint *tris, uint num_tris, const uint *labels);
+
+template<typename T>
+inline bool saveMesh(const std::string &filename, const T *coords, uint num_verts, const uint *tris, uint num_tris);
 
 inline void loadMultipleFilesWithVertFix(const std::vector<std::string> &files, std::vector<double> &coords, std::vector<uint> &tris, std::vector<uint> &labels);
 
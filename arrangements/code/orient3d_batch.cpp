@@ -0,0 +1,152 @@
+/*****************************************************************************************
+ *              MIT License                                                              *
+ *                                                                                       *
+ * Copyright (c) 2022 G. Cherchi, M. Livesu, R. Scateni, M. Attene and F. Pellacini      *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION     *
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                *
+ *                                                                                       *
+ * Authors:                                                                              *
+ *      Gianmarco Cherchi (g.cherchi@unica.it)                                           *
+ *      https://www.gianmarcocherchi.com                                                 *
+ *                                                                                       *
+ *      Marco Livesu (marco.livesu@ge.imati.cnr.it)                                      *
+ *      http://pers.ge.imati.cnr.it/livesu/                                              *
+ *                                                                                       *
+ *      Riccardo Scateni (riccardo@unica.it)                                             *
+ *      https://people.unica.it/riccardoscateni/                                         *
+ *                                                                                       *
+ *      Marco Attene (marco.attene@ge.imati.cnr.it)                                      *
+ *      https://www.cnr.it/en/people/marco.attene/                                       *
+ *                                                                                       *
+ *      Fabio Pellacini (fabio.pellacini@uniroma1.it)                                    *
+ *      https://pellacini.di.uniroma1.it                                                 *
+ *                                                                                       *
+ * ***************************************************************************************/
+
+#include "orient3d_batch.h"
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define ORIENT3D_BATCH_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define ORIENT3D_BATCH_SSE2
+#endif
+
+// Shewchuk's o3derrboundA = (7 + 56 eps) eps, with eps = 2^-53 (round to nearest)
+static constexpr double o3d_errbound = (7.0 + 56.0 * 0x1p-53) * 0x1p-53;
+
+inline int orient3dSign(const double *pa, const double *pb, const double *pc, const double *pd)
+{
+    double o = cinolib::orient3d(pa, pb, pc, pd);
+    return (o > 0) - (o < 0);
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+#if defined(ORIENT3D_BATCH_AVX2) || defined(ORIENT3D_BATCH_SSE2)
+
+#ifdef ORIENT3D_BATCH_AVX2
+    #define O3DB_W      4
+    #define O3DB_T      __m256d
+    #define O3DB_SET1   _mm256_set1_pd
+    #define O3DB_ADD    _mm256_add_pd
+    #define O3DB_SUB    _mm256_sub_pd
+    #define O3DB_MUL    _mm256_mul_pd
+    #define O3DB_ANDNOT _mm256_andnot_pd
+    #define O3DB_CMPGT(a, b) _mm256_cmp_pd(a, b, _CMP_GT_OQ)
+    #define O3DB_MASK   _mm256_movemask_pd
+    #define O3DB_LOAD(p, o) _mm256_set_pd(p[9 + o], p[6 + o], p[3 + o], p[o])
+#else
+    #define O3DB_W      2
+    #define O3DB_T      __m128d
+    #define O3DB_SET1   _mm_set1_pd
+    #define O3DB_ADD    _mm_add_pd
+    #define O3DB_SUB    _mm_sub_pd
+    #define O3DB_MUL    _mm_mul_pd
+    #define O3DB_ANDNOT _mm_andnot_pd
+    #define O3DB_CMPGT(a, b) _mm_cmpgt_pd(a, b)
+    #define O3DB_MASK   _mm_movemask_pd
+    #define O3DB_LOAD(p, o) _mm_set_pd(p[3 + o], p[o])
+#endif
+
+inline void orient3dBatch(const double *pa, const double *pb, const double *pc, const double *pd, uint n, int *res)
+{
+    const O3DB_T ax = O3DB_SET1(pa[0]), ay = O3DB_SET1(pa[1]), az = O3DB_SET1(pa[2]);
+    const O3DB_T bx = O3DB_SET1(pb[0]), by = O3DB_SET1(pb[1]), bz = O3DB_SET1(pb[2]);
+    const O3DB_T cx = O3DB_SET1(pc[0]), cy = O3DB_SET1(pc[1]), cz = O3DB_SET1(pc[2]);
+    const O3DB_T sign_bit = O3DB_SET1(-0.0), zero = O3DB_SET1(0.0), errbound = O3DB_SET1(o3d_errbound);
+
+    uint i = 0;
+    for(; i + O3DB_W <= n; i += O3DB_W)
+    {
+        const double *d = pd + 3 * i;
+        const O3DB_T dx = O3DB_LOAD(d, 0), dy = O3DB_LOAD(d, 1), dz = O3DB_LOAD(d, 2);
+
+        // same operations, in the same order, as the filter of Shewchuk's orient3d
+        O3DB_T adx = O3DB_SUB(ax, dx), bdx = O3DB_SUB(bx, dx), cdx = O3DB_SUB(cx, dx);
+        O3DB_T ady = O3DB_SUB(ay, dy), bdy = O3DB_SUB(by, dy), cdy = O3DB_SUB(cy, dy);
+        O3DB_T adz = O3DB_SUB(az, dz), bdz = O3DB_SUB(bz, dz), cdz = O3DB_SUB(cz, dz);
+
+        O3DB_T bdxcdy = O3DB_MUL(bdx, cdy), cdxbdy = O3DB_MUL(cdx, bdy);
+        O3DB_T cdxady = O3DB_MUL(cdx, ady), adxcdy = O3DB_MUL(adx, cdy);
+        O3DB_T adxbdy = O3DB_MUL(adx, bdy), bdxady = O3DB_MUL(bdx, ady);
+
+        O3DB_T det = O3DB_ADD(O3DB_ADD(O3DB_MUL(adz, O3DB_SUB(bdxcdy, cdxbdy)),
+                                       O3DB_MUL(bdz, O3DB_SUB(cdxady, adxcdy))),
+                                       O3DB_MUL(cdz, O3DB_SUB(adxbdy, bdxady)));
+
+        O3DB_T perm = O3DB_ADD(O3DB_ADD(O3DB_MUL(O3DB_ADD(O3DB_ANDNOT(sign_bit, bdxcdy), O3DB_ANDNOT(sign_bit, cdxbdy)), O3DB_ANDNOT(sign_bit, adz)),
+                                        O3DB_MUL(O3DB_ADD(O3DB_ANDNOT(sign_bit, cdxady), O3DB_ANDNOT(sign_bit, adxcdy)), O3DB_ANDNOT(sign_bit, bdz))),
+                                        O3DB_MUL(O3DB_ADD(O3DB_ANDNOT(sign_bit, adxbdy), O3DB_ANDNOT(sign_bit, bdxady)), O3DB_ANDNOT(sign_bit, cdz)));
+
+        // a lane is certain if |det| > errbound * permanent (false for NaNs, i.e. on overflow)
+        int certain = O3DB_MASK(O3DB_CMPGT(O3DB_ANDNOT(sign_bit, det), O3DB_MUL(errbound, perm)));
+        int positive = O3DB_MASK(O3DB_CMPGT(det, zero));
+
+        for(uint l = 0; l < O3DB_W; l++)
+        {
+            if(certain & (1 << l)) res[i + l] = (positive & (1 << l)) ? 1 : -1;
+            else                   res[i + l] = orient3dSign(pa, pb, pc, d + 3 * l);
+        }
+    }
+
+    for(; i < n; i++)
+        res[i] = orient3dSign(pa, pb, pc, pd + 3 * i);
+}
+
+#undef O3DB_W
+#undef O3DB_T
+#undef O3DB_SET1
+#undef O3DB_ADD
+#undef O3DB_SUB
+#undef O3DB_MUL
+#undef O3DB_ANDNOT
+#undef O3DB_CMPGT
+#undef O3DB_MASK
+#undef O3DB_LOAD
+
+#else // no SIMD: the scalar predicate runs the same filter point by point
+
+inline void orient3dBatch(const double *pa, const double *pb, const double *pc, const double *pd, uint n, int *res)
+{
+    for(uint i = 0; i < n; i++)
+        res[i] = orient3dSign(pa, pb, pc, pd + 3 * i);
+}
+
+#endif
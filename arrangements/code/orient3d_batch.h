@@ -0,0 +1,58 @@
+/*****************************************************************************************
+ *              MIT License                                                              *
+ *                                                                                       *
+ * Copyright (c) 2022 G. Cherchi, M. Livesu, R. Scateni, M. Attene and F. Pellacini      *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION     *
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                *
+ *                                                                                       *
+ * Authors:                                                                              *
+ *      Gianmarco Cherchi (g.cherchi@unica.it)                                           *
+ *      https://www.gianmarcocherchi.com                                                 *
+ *                                                                                       *
+ *      Marco Livesu (marco.livesu@ge.imati.cnr.it)                                      *
+ *      http://pers.ge.imati.cnr.it/livesu/                                              *
+ *                                                                                       *
+ *      Riccardo Scateni (riccardo@unica.it)                                             *
+ *      https://people.unica.it/riccardoscateni/                                         *
+ *                                                                                       *
+ *      Marco Attene (marco.attene@ge.imati.cnr.it)                                      *
+ *      https://www.cnr.it/en/people/marco.attene/                                       *
+ *                                                                                       *
+ *      Fabio Pellacini (fabio.pellacini@uniroma1.it)                                    *
+ *      https://pellacini.di.uniroma1.it                                                 *
+ *                                                                                       *
+ * ***************************************************************************************/
+
+#ifndef ORIENT3D_BATCH_H
+#define ORIENT3D_BATCH_H
+
+#include <cinolib/predicates.h>
+
+/* Orientation of many points with respect to the plane of a single triangle.
+ *
+ * res[i] is the sign (-1, 0, 1) of cinolib::orient3d(pa, pb, pc, pd_i), where pd holds the n points as
+ * consecutive xyz triplets. The points are filtered 4 at a time (AVX2) or 2 at a time (SSE2, which also
+ * covers wasm simd128 through the Emscripten SSE2 headers) against the same static error bound used by
+ * Shewchuk's orient3d, and only the lanes the filter cannot certify go through the exact cinolib::orient3d.
+ * The signs are therefore always exact and equal to the ones of the scalar predicate. */
+
+inline void orient3dBatch(const double *pa, const double *pb, const double *pc, const double *pd, uint n, int *res);
+
+#include "orient3d_batch.cpp"
+
+#endif // ORIENT3D_BATCH_H
@@ -42,6 +42,9 @@
 
 #include "utils.h"
 
+#include <cstring>
+#include <limits>
+
 inline double computeMultiplier(const std::vector<double> &coords)
 {
     const double R = 11259470696.0; //avg_max_coord (167.78) * old_multiplier (67108864.0)
@@ -64,64 +67,174 @@ inline double computeMultiplier(const std::vector<double> &coords)
 
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+inline double computeLatticeMultiplier(const std::vector<double> &coords, uint bits)
+{
+    assert(bits >= 2 && bits <= 31 && "lattice bits out of range");
+
+    double max_coord = *std::max_element(coords.begin(), coords.end());
+    double min_coord = *std::min_element(coords.begin(), coords.end());
+
+    double abs_max_coord = std::max(std::abs(min_coord), std::abs(max_coord));
+    if(abs_max_coord == 0.0) return 1.0;
+
+    // largest power of 2 such that abs_max_coord * multiplier <= 2^(bits-1) - 1
+    double max_int = std::ldexp(1.0, static_cast<int>(bits) - 1) - 1.0;
+    int e = static_cast<int>(std::floor(std::log2(max_int / abs_max_coord)));
+    while(std::ldexp(abs_max_coord, e) > max_int) e--;
+
+    return std::ldexp(1.0, e);
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline void snapToLattice(std::vector<double> &coords, double multiplier, bool parallel)
+{
+    // multiplier is a power of 2, so both the scaling and the unscaling are exact
+    auto snap = [&](uint i) { coords[i] = std::round(coords[i] * multiplier) / multiplier; };
+
+    if(parallel)
+    {
+        #if ENABLE_MULTITHREADING
+        tbb::parallel_for((uint)0, (uint)coords.size(), snap);
+        #endif
+    }
+    else
+    {
+        for(uint i = 0; i < (uint)coords.size(); i++) snap(i);
+    }
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 inline void mergeDuplicatedVertices(const std::vector<double> &in_coords, const std::vector<uint> &in_tris,
                                     point_arena& arena, std::vector<genericPoint*> &verts, std::vector<uint> &tris,
-                                    bool parallel)
+                                    bool parallel, uint num_welded_verts)
 {
-    verts.reserve(in_coords.size() / 3);
-    tris.reserve(in_tris.size());
-    arena.init.reserve(in_tris.size());
+    mergeDuplicatedVertices(in_coords.data(), static_cast<uint>(in_coords.size() / 3), in_tris, arena, verts, tris, parallel,
+                            num_welded_verts);
+}
 
-    if(parallel)
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Welds the vertices with identical coordinates. Vertex ids are radix-sorted on a 32-bit digest of the bit
+ * patterns of their coordinates, so that coincident vertices become contiguous (runs of equal digest holding
+ * different points are re-sorted on the coordinates), then the triangles are remapped in one pass. Coordinates can be float (e.g. straight from the C API) or double, and are converted
+ * to double when the explicit points are created. The output vertices follow the order of first reference
+ * in in_tris, unreferenced vertices are dropped. The last num_welded_verts vertices are left out of the sort: each
+ * one is binary searched among the sorted digests of the others, and welded to its match if any. */
+template<typename T>
+inline void mergeDuplicatedVertices(const T *in_coords, uint num_in_verts, const std::vector<uint> &in_tris,
+                                    point_arena& arena, std::vector<genericPoint*> &verts, std::vector<uint> &tris,
+                                    bool parallel, uint num_welded_verts)
+{
+    static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value, "unsupported coordinate type");
+    using Key = typename std::conditional<sizeof(T) == 8, uint64_t, uint32_t>::type;
+
+    auto for_each_vert = [&](const auto &fn)
     {
-        printf("PARALLEL\n");
     #if ENABLE_MULTITHREADING
-        using vec3 = std::array<double, 3>;
-        auto in_vecs = (vec3*)in_coords.data();
-        std::vector<uint> sorted = std::vector<uint>(in_coords.size() / 3);
+        if(parallel) { tbb::parallel_for((uint)0, num_in_verts, fn); return; }
+    #endif
+        for(uint v_id = 0; v_id < num_in_verts; v_id++) fn(v_id);
+    };
 
-        for(uint idx = 0; idx < (uint)sorted.size(); idx ++) sorted[idx] = idx;
+    auto coord_bits = [](T c) -> Key
+    {
+        if(c == T(0)) c = T(0); // -0 and +0 are the same point
+        Key k;
+        std::memcpy(&k, &c, sizeof(Key));
+        return k;
+    };
+
+    // 32-bit digest of the exact coordinates: coincident vertices share it, different ones rarely do
+    auto vert_digest = [&](uint v_id) -> uint32_t
+    {
+        uint64_t h = 0x9E3779B97F4A7C15ull;
+        for(uint i = 0; i < 3; i++)
+        {
+            h ^= static_cast<uint64_t>(coord_bits(in_coords[3 * v_id + i]));
+            h *= 0xFF51AFD7ED558CCDull;
+            h ^= h >> 32;
+        }
+        return static_cast<uint32_t>(h);
+    };
 
-        tbb::parallel_sort(sorted.begin(), sorted.end(), [in_vecs](auto a, auto b)
+    auto same_coords = [in_coords](uint a, uint b)
+    {
+        return in_coords[3 * a] == in_coords[3 * b] && in_coords[3 * a + 1] == in_coords[3 * b + 1] && in_coords[3 * a + 2] == in_coords[3 * b + 2];
+    };
+
+    auto coords_less = [&](const std::pair<uint32_t, uint> &a, const std::pair<uint32_t, uint> &b)
+    {
+        for(uint i = 0; i < 3; i++)
         {
-            return in_vecs[a] < in_vecs[b];
-        });
+            Key ka = coord_bits(in_coords[3 * a.second + i]), kb = coord_bits(in_coords[3 * b.second + i]);
+            if(ka != kb) return ka < kb;
+        }
+        return a.second < b.second;
+    };
 
-        std::vector<uint> lookup = std::vector<uint>(sorted.size());
-        for(uint idx = 0; idx < (uint)sorted.size(); idx ++)
+    assert(num_welded_verts <= num_in_verts && "more welded vertices than vertices");
+    const uint num_sorted = num_in_verts - num_welded_verts;
+
+    std::vector<std::pair<uint32_t, uint>> keys(num_sorted);
+    for_each_vert([&](uint v_id) { if(v_id < num_sorted) keys[v_id] = {vert_digest(v_id), v_id}; });
+    radix_sort_pairs(keys, parallel);
+
+    // each input vertex points to the first vertex of its group of coincident ones
+    std::vector<uint> weld(num_in_verts);
+    for(uint begin = 0, end = 0; begin < num_sorted; begin = end)
+    {
+        bool collision = false;
+        for(end = begin + 1; end < num_sorted && keys[end].first == keys[begin].first; end++)
+            collision |= !same_coords(keys[end].second, keys[begin].second);
+
+        if(!collision)
         {
-            if (idx == 0 || in_vecs[sorted[idx]] != in_vecs[sorted[idx-1]])
-            {
-                auto v = in_vecs[sorted[idx]];
-                verts.push_back(&arena.init.emplace_back(v[0], v[1], v[2]));
-            }
-            lookup[sorted[idx]] = (uint)verts.size() - 1;
+            for(uint i = begin; i < end; i++) weld[keys[i].second] = keys[begin].second;
+            continue;
         }
-        tris.resize(in_tris.size());
-        tbb::parallel_for((uint)0, (uint)in_tris.size(), [&](uint idx)
+
+        // different points with the same digest: sort the run on the actual coordinates
+        std::sort(keys.begin() + begin, keys.begin() + end, coords_less);
+
+        for(uint i = begin; i < end; i++)
         {
-            tris[idx] = lookup[in_tris[idx]];
-        });
-    #endif
+            uint v_id = keys[i].second;
+            weld[v_id] = (i > begin && same_coords(v_id, keys[i - 1].second)) ? weld[keys[i - 1].second] : v_id;
+        }
     }
-    else
+
+    for(uint v_id = num_sorted; v_id < num_in_verts; v_id++)
     {
-        phmap::flat_hash_map <std::array<double, 3>, uint> v_map;
-        v_map.reserve(in_tris.size() * 3);
+        const uint32_t digest = vert_digest(v_id);
+        auto it = std::lower_bound(keys.begin(), keys.end(), digest, [](const std::pair<uint32_t, uint> &k, uint32_t d) { return k.first < d; });
+        while(it != keys.end() && it->first == digest && !same_coords(v_id, it->second)) ++it;
+        weld[v_id] = (it != keys.end() && it->first == digest) ? weld[it->second] : v_id;
+    }
+    std::vector<std::pair<uint32_t, uint>>().swap(keys);
 
-        for(const uint &v_id : in_tris)
-        {
-            std::array<double, 3> v = {in_coords[(3 * v_id)], in_coords[(3 * v_id) +1], in_coords[(3 * v_id) +2]};
+    // final ids in order of first reference
+    std::vector<uint> new_ids(num_in_verts, std::numeric_limits<uint>::max());
 
-            auto ins = v_map.insert({v, v_map.size()});
-            if(ins.second) verts.push_back(&arena.init.emplace_back(v[0], v[1], v[2])); // new_vtx added
+    verts.reserve(num_in_verts);
+    arena.init.reserve(num_in_verts); // verts point inside this vector, it must not reallocate
+    tris.resize(in_tris.size());
 
-            tris.push_back(ins.first->second);
+    for(uint i = 0; i < (uint)in_tris.size(); i++)
+    {
+        uint w_id = weld[in_tris[i]];
+        if(new_ids[w_id] == std::numeric_limits<uint>::max())
+        {
+            new_ids[w_id] = static_cast<uint>(verts.size());
+            verts.push_back(&arena.init.emplace_back(static_cast<double>(in_coords[3 * w_id]),
+                                                     static_cast<double>(in_coords[3 * w_id + 1]),
+                                                     static_cast<double>(in_coords[3 * w_id + 2])));
         }
+        tris[i] = new_ids[w_id];
     }
 }
 
-
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 inline void removeDegenerateAndDuplicatedTriangles(const std::vector<genericPoint*> &verts, const std::vector<std::bitset<NBIT> > &in_labels,
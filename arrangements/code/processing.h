@@ -49,9 +49,22 @@
 
 inline double computeMultiplier(const std::vector<double> &coords);
 
+// power of 2 that maps the coords to signed integers of at most bits bits, see snapToLattice
+inline double computeLatticeMultiplier(const std::vector<double> &coords, uint bits);
+
+// rounds the coords to the closest multiple of 1 / multiplier, i.e. to integers once scaled by the multiplier
+inline void snapToLattice(std::vector<double> &coords, double multiplier, bool parallel);
+
+// the last num_welded_verts vertices are known to be distinct from each other (e.g. generated geometry): they are only
+// looked up among the other vertices instead of being sorted with them
 inline void mergeDuplicatedVertices(const std::vector<double> &in_coords, const std::vector<uint> &in_tris,
                                     point_arena& arena, std::vector<genericPoint*> &verts, std::vector<uint> &tris,
-                                    bool parallel);
+                                    bool parallel, uint num_welded_verts = 0);
+
+template<typename T>
+inline void mergeDuplicatedVertices(const T *in_coords, uint num_in_verts, const std::vector<uint> &in_tris,
+                                    point_arena& arena, std::vector<genericPoint*> &verts, std::vector<uint> &tris,
+                                    bool parallel, uint num_welded_verts = 0);
 
 inline void removeDegenerateAndDuplicatedTriangles(const std::vector<genericPoint *> &verts, const std::vector<std::bitset<NBIT> > &in_labels,
                                                    std::vector<uint> &tris, std::vector<std::bitset<NBIT> > &labels);
@@ -43,92 +43,43 @@
 
 inline void TriangleSoup::init(point_arena& arena, double multiplier, bool parallel)
 {
-    if (parallel) {
-    #if ENABLE_MULTITHREADING
-        num_orig_vtxs = static_cast<uint>(vertices.size());
-        num_orig_tris = static_cast<uint>(triangles.size() / 3);
-
-        edges.reserve(numVerts() + numTris());
-        edge_map.reserve(numVerts() + numTris());
-        tri_planes.resize(numTris());
-
-        // vertices
-        for(uint v_id = 0; v_id < num_orig_vtxs; v_id++)
-        {
-            const explicitPoint3D &e = vertices[v_id]->toExplicit3D();
-            vertices[v_id]->toExplicit3D().set(e.X() * multiplier, e.Y() * multiplier, e.Z() * multiplier);
-        }
-
-        // this is done separately since it is expensive
-        tbb::parallel_for((uint)0, num_orig_tris, [this](uint t_id)
-        {
-            uint v0_id = triVertID(t_id, 0), v1_id = triVertID(t_id, 1), v2_id = triVertID(t_id, 2);
-
-            tri_planes[t_id] = intToPlane(genericPoint::maxComponentInTriangleNormal(vertX(v0_id), vertY(v0_id), vertZ(v0_id),
-                                                                                    vertX(v1_id), vertY(v1_id), vertZ(v1_id),
-                                                                                    vertX(v2_id), vertY(v2_id), vertZ(v2_id)));
-        });
-        
-        // triangles
-        auto edges = std::vector<Edge>(num_orig_tris * 3);
-        for(uint t_id = 0; t_id < num_orig_tris; t_id++)
-        {
-            uint v0_id = triVertID(t_id, 0), v1_id = triVertID(t_id, 1), v2_id = triVertID(t_id, 2);
-            edges[t_id * 3 + 0] = uniqueEdge(v0_id, v1_id);
-            edges[t_id * 3 + 1] = uniqueEdge(v1_id, v2_id);
-            edges[t_id * 3 + 2] = uniqueEdge(v2_id, v0_id);
-        }
-        tbb::parallel_sort(edges.begin(), edges.end());   
-
-        // I think since it keeps order that we do not need
-        for(auto e_id = (uint)0; e_id < (uint)edges.size(); e_id++)
-        {
-            if(e_id == 0 || edges[e_id] != edges[e_id - 1]) 
-                addEdge(edges[e_id].first, edges[e_id].second);
-        }
-
-        initJollyPoints(arena, multiplier);
-    #endif
+    num_orig_vtxs = static_cast<uint>(vertices.size());
+    num_orig_tris = static_cast<uint>(triangles.size() / 3);
+
+    tri_planes.resize(numTris());
+
+    // vertices
+    for(uint v_id = 0; v_id < num_orig_vtxs; v_id++)
+    {
+        const explicitPoint3D &e = vertices[v_id]->toExplicit3D();
+        vertices[v_id]->toExplicit3D().set(e.X() * multiplier, e.Y() * multiplier, e.Z() * multiplier);
+    }
+
+    // this is done separately since it is expensive
+    auto init_tri_plane = [this](uint t_id)
+    {
+        uint v0_id = triVertID(t_id, 0), v1_id = triVertID(t_id, 1), v2_id = triVertID(t_id, 2);
+
+        tri_planes[t_id] = intToPlane(genericPoint::maxComponentInTriangleNormal(vertX(v0_id), vertY(v0_id), vertZ(v0_id),
+                                                                                vertX(v1_id), vertY(v1_id), vertZ(v1_id),
+                                                                                vertX(v2_id), vertY(v2_id), vertZ(v2_id)));
+    };
+
+    if(parallel)
+    {
+        #if ENABLE_MULTITHREADING
+        tbb::parallel_for((uint)0, num_orig_tris, init_tri_plane);
+        #endif
     }
     else
     {
-        num_orig_vtxs = static_cast<uint>(vertices.size());
-        num_orig_tris = static_cast<uint>(triangles.size() / 3);
-
-        edges.reserve(numVerts() + numTris());
-        edge_map.reserve(numVerts() + numTris());
-        tri_planes.resize(numTris());
-
-        // vertices
-        for(uint v_id = 0; v_id < num_orig_vtxs; v_id++)
-        {
-            const explicitPoint3D &e = vertices[v_id]->toExplicit3D();
-            vertices[v_id]->toExplicit3D().set(e.X() * multiplier, e.Y() * multiplier, e.Z() * multiplier);
-        }
-
-        // this is done separately since it is expensive
-        for(uint t_id = 0; t_id < num_orig_tris; t_id++)
-        {
-            uint v0_id = triVertID(t_id, 0), v1_id = triVertID(t_id, 1), v2_id = triVertID(t_id, 2);
-
-            tri_planes[t_id] = intToPlane(genericPoint::maxComponentInTriangleNormal(vertX(v0_id), vertY(v0_id), vertZ(v0_id),
-                                                                                    vertX(v1_id), vertY(v1_id), vertZ(v1_id),
-                                                                                    vertX(v2_id), vertY(v2_id), vertZ(v2_id)));
-        }
-        
-        // triangles
-        for(uint t_id = 0; t_id < num_orig_tris; t_id++)
-        {
-            uint v0_id = triVertID(t_id, 0), v1_id = triVertID(t_id, 1), v2_id = triVertID(t_id, 2);
-
-            // edges
-            addEdge(v0_id, v1_id);
-            addEdge(v1_id, v2_id);
-            addEdge(v2_id, v0_id);
-        }
-
-        initJollyPoints(arena, multiplier);
+        for(uint t_id = 0; t_id < num_orig_tris; t_id++) init_tri_plane(t_id);
     }
+
+    // edges
+    initEdges(parallel);
+
+    initJollyPoints(arena, multiplier);
 }
 
 /*******************************************************************************************************
@@ -163,6 +114,13 @@ inline uint TriangleSoup::numOrigTriangles() const
 
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+inline uint TriangleSoup::numImplVerts() const
+{
+    return numVerts() - num_orig_vtxs;
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 inline const genericPoint* TriangleSoup::vert(uint v_id) const
 {
     assert(v_id < numVerts() && "vtx id out of range");
@@ -215,10 +173,11 @@ inline uint TriangleSoup::addImplVert(genericPoint* gp)
 
 inline int TriangleSoup::edgeID(uint v0_id, uint v1_id) const
 {
-    auto it = edge_map.find(uniqueEdge(v0_id, v1_id));
+    Edge e = uniqueEdge(v0_id, v1_id);
+    auto it = std::lower_bound(edges.begin(), edges.end(), e);
 
-    if(it == edge_map.end()) return -1;
-    return static_cast<int>(it->second); // edge id
+    if(it == edges.end() || *it != e) return -1;
+    return static_cast<int>(it - edges.begin()); // edge id
 }
 
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -248,26 +207,14 @@ inline uint TriangleSoup::edgeOppositeToVert(uint t_id, uint v_id) const
 
     int e_id = -1;
 
-    if     (triVertID(t_id, 0) == v_id) e_id = edgeID(triVertID(t_id, 1), triVertID(t_id, 2));
-    else if(triVertID(t_id, 1) == v_id) e_id = edgeID(triVertID(t_id, 0), triVertID(t_id, 2));
-    else if(triVertID(t_id, 2) == v_id) e_id = edgeID(triVertID(t_id, 0), triVertID(t_id, 1));
+    if     (triVertID(t_id, 0) == v_id) e_id = static_cast<int>(triEdgeOppositeTo(t_id, 0));
+    else if(triVertID(t_id, 1) == v_id) e_id = static_cast<int>(triEdgeOppositeTo(t_id, 1));
+    else if(triVertID(t_id, 2) == v_id) e_id = static_cast<int>(triEdgeOppositeTo(t_id, 2));
 
     assert(e_id >= 0 && "Opposite edge not found");
     return static_cast<uint>(e_id);
 }
 
-//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
-
-inline void TriangleSoup::addEdge(uint v0_id, uint v1_id)
-{
-    uint tmp_id = static_cast<uint>(edges.size());
-    Edge e = uniqueEdge(v0_id, v1_id);
-
-    auto it = edge_map.insert({e, tmp_id});
-
-    if(it.second) edges.push_back(e);
-}
-
 /*******************************************************************************************************
  *      TRIANGLES
  * ****************************************************************************************************/
@@ -314,11 +261,16 @@ inline const double* TriangleSoup::triVertPtr(uint t_id, uint off) const
 inline uint TriangleSoup::triEdgeID(uint t_id, uint off) const
 {
     assert(t_id < numTris() && "t_id out of range");
-    int e_id = edgeID(triangles[3 * t_id + off],
-                      triangles[3 * t_id + ((off +1) %3)]);
+    assert(off < 3 && "offset out of range");
+    return tri_edges[3 * t_id + off];
+}
 
-    assert(e_id >= 0 && "no triangle edge found");
-    return static_cast<uint>(e_id);
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline uint TriangleSoup::triEdgeOppositeTo(uint t_id, uint v_off) const
+{
+    assert(v_off < 3 && "offset out of range");
+    return triEdgeID(t_id, (v_off + 1) % 3);
 }
 
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -382,6 +334,26 @@ inline void TriangleSoup::appendJollyPoints()
  *              PRIVATE METHODS
  * ****************************************************************************************************/
 
+inline void TriangleSoup::initEdges(bool parallel)
+{
+    // one scan of the sorted half-edges gives both the (sorted) edge list and the triangle -> edges map
+    std::vector<std::pair<uint64_t, uint>> half_edges = sorted_half_edges(triangles, parallel);
+
+    edges.clear();
+    edges.reserve(half_edges.size() / 2 + 1);
+    tri_edges.resize(half_edges.size());
+
+    for(uint i = 0; i < (uint)half_edges.size(); i++)
+    {
+        if(i == 0 || half_edges[i].first != half_edges[i - 1].first)
+            edges.emplace_back(static_cast<uint>(half_edges[i].first >> 32), static_cast<uint>(half_edges[i].first & 0xFFFFFFFF));
+
+        tri_edges[half_edges[i].second] = static_cast<uint>(edges.size() - 1);
+    }
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 inline void TriangleSoup::initJollyPoints(point_arena& arena, double multiplier)
 {
     jolly_points.push_back(&arena.jolly.emplace_back(0.94280904158 * multiplier, 0.0 * multiplier, -0.333333333 * multiplier));
@@ -55,9 +55,6 @@
 
 typedef std::pair<uint, uint> Edge;
 
-template<typename K, typename V>
-using EdgeMap = phmap::flat_hash_map<K, V>;
-
 class TriangleSoup
 {
     public:
@@ -80,6 +77,7 @@ class TriangleSoup
 
         //inline uint numOrigVertices() const;
         inline uint numOrigTriangles() const;
+        inline uint numImplVerts() const; // added by addImplVert
 
         // VERTICES
         inline const genericPoint* vert(uint v_id) const;
@@ -101,8 +99,6 @@ class TriangleSoup
 
         inline uint edgeOppositeToVert(uint t_id, uint v_id) const;
 
-        inline void addEdge(uint v0_id, uint v1_id);
-
         // TRIANGLES
         inline const std::vector<uint>& trisVector() const;
 
@@ -116,6 +112,8 @@ class TriangleSoup
 
         inline uint triEdgeID(uint t_id, uint off) const;
 
+        inline uint triEdgeOppositeTo(uint t_id, uint v_off) const;
+
         inline Plane triPlane(uint t_id) const;
 
         inline bool triContainsVert(uint t_id, uint v_id) const;
@@ -133,7 +131,8 @@ class TriangleSoup
 
         std::vector<genericPoint*>      &vertices;
 
-        std::vector<Edge>               edges;
+        std::vector<Edge>               edges;      // sorted by (min, max) vertex ids
+        std::vector<uint>               tri_edges;  // 3 edge ids per triangle, edge off is (v[off], v[(off+1)%3])
 
         std::vector<uint>               &triangles;
         std::vector<std::bitset<NBIT>>  &tri_labels;
@@ -141,12 +140,12 @@ class TriangleSoup
 
         std::vector<genericPoint*>      jolly_points;
 
-        EdgeMap <Edge, uint> edge_map;
-
         uint num_orig_vtxs;
         uint num_orig_tris;
 
         // PRIVATE METHODS
+        inline void initEdges(bool parallel);
+
         inline void initJollyPoints(point_arena& arena, double multiplier);
 
         inline Edge uniqueEdge(uint v0_id, uint v1_id) const;
@@ -63,9 +63,10 @@ inline void triangulateSingleTriangle(TriangleSoup &ts, point_arena& arena, Fast
 
     const auto& t_points = g.trianglePointsList(t_id);
 
-    int e0_id = ts.edgeID(subm.vertOrigID(0), subm.vertOrigID(1));      assert(e0_id != -1);
-    int e1_id = ts.edgeID(subm.vertOrigID(1), subm.vertOrigID(2));      assert(e1_id != -1);
-    int e2_id = ts.edgeID(subm.vertOrigID(2), subm.vertOrigID(0));      assert(e2_id != -1);
+    // subm is initialized with the vertices of t_id in the same order, so its edges are the triangle edges
+    uint e0_id = ts.triEdgeID(t_id, 0);
+    uint e1_id = ts.triEdgeID(t_id, 1);
+    uint e2_id = ts.triEdgeID(t_id, 2);
 
     //auxvector<uint> e0_points, e1_points, e2_points;
     //sortedVertexListAlongSegment(ts, g.edgePointsList(static_cast<uint>(e0_id)), subm.vertOrigID(0), subm.vertOrigID(1), e0_points);
@@ -146,7 +147,8 @@ inline void triangulateSingleTriangle(TriangleSoup &ts, point_arena& arena, Fast
     }
 }
 
-inline void triangulation(TriangleSoup &ts, point_arena& arena, AuxiliaryStructure &g, std::vector<uint> &new_tris, std::vector< std::bitset<NBIT> > &new_labels, bool parallel)
+inline void triangulation(TriangleSoup &ts, point_arena& arena, AuxiliaryStructure &g, std::vector<uint> &new_tris, std::vector< std::bitset<NBIT> > &new_labels, bool parallel,
+                          ProgressMonitor *progress)
 {
     new_labels.clear();
     new_tris.clear();
@@ -171,6 +173,8 @@ inline void triangulation(TriangleSoup &ts, point_arena& arena, AuxiliaryStructu
     }
 
     // processing the triangles to split
+    if(progress) progress->beginItems(tris_to_split.size());
+
     #if ENABLE_MULTITHREADING
         tbb::spin_mutex mutex;
     #endif
@@ -178,6 +182,7 @@ inline void triangulation(TriangleSoup &ts, point_arena& arena, AuxiliaryStructu
         #if ENABLE_MULTITHREADING
             tbb::parallel_for((uint)0, (uint)tris_to_split.size(), [&](uint t) {
                 //for (uint t=0; t < (uint)tris_to_split.size(); t++) {
+                if(progress && t % ProgressMonitor::GRANULARITY == 0 && t > 0) progress->advance(ProgressMonitor::GRANULARITY);
                 uint t_id = tris_to_split[t];
                 FastTrimesh subm(ts.triVert(t_id, 0),
                                 ts.triVert(t_id, 1),
@@ -190,6 +195,7 @@ inline void triangulation(TriangleSoup &ts, point_arena& arena, AuxiliaryStructu
         #endif
     }else{
         for (uint t=0; t < (uint)tris_to_split.size(); t++) {
+            if(progress && t % ProgressMonitor::GRANULARITY == 0 && t > 0) progress->advance(ProgressMonitor::GRANULARITY, ts.numImplVerts());
             uint t_id = tris_to_split[t];
             FastTrimesh subm(ts.triVert(t_id, 0),
                              ts.triVert(t_id, 1),
@@ -682,14 +688,12 @@ inline void findIntersectingElements(TriangleSoup &ts, point_arena& arena, FastT
 #endif
 )
 {
-    printf("findIntersectingElements - start\n");
     uint orig_vstart = subm.vertOrigID(v_start);
     uint orig_vstop  = subm.vertOrigID(v_stop);
 
     // find the edge in link(seed) that intersect {A,B}
     for(uint t_id : subm.adjV2T(v_start))
     {
-        printf("findIntersectingElements - loop iter start\n");
         uint e_id = subm.edgeOppToVert(t_id, v_start);
         uint ev0_id = subm.edgeVertID(e_id, 0);
         uint ev1_id = subm.edgeVertID(e_id, 1);
@@ -733,12 +737,10 @@ inline void findIntersectingElements(TriangleSoup &ts, point_arena& arena, FastT
 
             return;
         }
-        printf("findIntersectingElements - loop iterend\n");
     }
 
     assert(intersected_edges.size() > 0);
 
-    printf("findIntersectingElements - while start\n");
     // walk along the topology to find the sorted list of edges and tris that intersect {v_start, v_stop}
     while(true)
     {
@@ -1093,11 +1095,16 @@ inline std::vector<const genericPoint *> computeTriangleOfSegment(const Triangle
 
         bool copl = true;
 
-        if(genericPoint::orient3D(*ts.vert(ref_t[0]), *ts.vert(ref_t[1]), *ts.vert(ref_t[2]), *ts.vert(tv1[0])) != 0.0)
+        // the triangles of the soup only have explicit vertices
+        const explicitPoint3D &rv0 = ts.vert(ref_t[0])->toExplicit3D();
+        const explicitPoint3D &rv1 = ts.vert(ref_t[1])->toExplicit3D();
+        const explicitPoint3D &rv2 = ts.vert(ref_t[2])->toExplicit3D();
+
+        if(genericPoint::orient3D(rv0, rv1, rv2, ts.vert(tv1[0])->toExplicit3D()) != 0.0)
             copl = false;
-        else if(genericPoint::orient3D(*ts.vert(ref_t[0]), *ts.vert(ref_t[1]), *ts.vert(ref_t[2]), *ts.vert(tv1[1])) != 0.0)
+        else if(genericPoint::orient3D(rv0, rv1, rv2, ts.vert(tv1[1])->toExplicit3D()) != 0.0)
             copl = false;
-        else if(genericPoint::orient3D(*ts.vert(ref_t[0]), *ts.vert(ref_t[1]), *ts.vert(ref_t[2]), *ts.vert(tv1[2])) != 0.0)
+        else if(genericPoint::orient3D(rv0, rv1, rv2, ts.vert(tv1[2])->toExplicit3D()) != 0.0)
             copl = false;
 
         // no-coplanar triangle found
@@ -1164,7 +1171,8 @@ inline std::vector<const genericPoint *> computeTriangleOfSegmentInCoplanarCase(
     // check for the 3rd point of the triangle
     for(uint jp_id = 0; jp_id < 4; jp_id++)
     {
-        if(genericPoint::orient3D(*ts.vert(ref_t[0]), *ts.vert(ref_t[1]), *ts.vert(ref_t[2]), *ts.jollyPoint(jp_id)) != 0.0)
+        if(genericPoint::orient3D(ts.vert(ref_t[0])->toExplicit3D(), ts.vert(ref_t[1])->toExplicit3D(), ts.vert(ref_t[2])->toExplicit3D(),
+                                  ts.jollyPoint(jp_id)->toExplicit3D()) != 0.0)
         {
             res.push_back(ts.jollyPoint(jp_id));
             return res;
@@ -1211,15 +1219,16 @@ inline bool fastPointOnLine(const FastTrimesh &subm, uint e_id, uint p_id)
 // at a point that is inside both segments
 inline bool segmentsIntersectInside(const FastTrimesh &subm, uint e00_id, uint e01_id, uint e10_id, uint e11_id)
 {
+    // all the points of subm lie on its triangle, so the projection on the reference plane is enough
     return genericPoint::innerSegmentsCross(*subm.vert(e00_id), *subm.vert(e01_id),
-                                            *subm.vert(e10_id), *subm.vert(e11_id));
+                                            *subm.vert(e10_id), *subm.vert(e11_id), planeToInt(subm.refPlane()));
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 inline bool pointInsideSegment(const FastTrimesh &subm, uint ev0_id, uint ev1_id, uint p_id)
 {
-    return genericPoint::pointInInnerSegment(*subm.vert(p_id), *subm.vert(ev0_id), *subm.vert(ev1_id));
+    return genericPoint::pointInInnerSegment(*subm.vert(p_id), *subm.vert(ev0_id), *subm.vert(ev1_id), planeToInt(subm.refPlane()));
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -61,7 +61,10 @@ inline bool lessThanP(std::pair<const genericPoint*, uint> &a, std::pair<const g
 }
 
 
-inline void triangulation(TriangleSoup &ts, point_arena& arena, AuxiliaryStructure &g, std::vector<uint> &new_tris, std::vector<std::bitset<NBIT> > &new_labels, bool parallel);
+// progress, if given, counts the triangles to split and (when not parallel) the implicit points, and may cancel the
+// triangulation (see ProgressMonitor)
+inline void triangulation(TriangleSoup &ts, point_arena& arena, AuxiliaryStructure &g, std::vector<uint> &new_tris, std::vector<std::bitset<NBIT> > &new_labels, bool parallel,
+                          ProgressMonitor *progress = nullptr);
 
 inline void triangulateSingleTriangle(TriangleSoup &ts, FastTrimesh &subm, uint t_id, AuxiliaryStructure &g, std::vector<uint> &new_tris, std::vector<std::bitset<NBIT> > &new_labels);
 
@@ -44,6 +44,11 @@
 #include <vector>
 #include <deque>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <optional>
+#include <type_traits>
 
 #include <absl/container/flat_hash_map.h>
 
@@ -98,6 +103,95 @@ inline bool contains(const std::vector<T>& values, T value) {
   return false;
 }
 
+// stable LSD radix sort of (unsigned key, id) pairs on 11-bit digits. Digits shared by all the keys (e.g.
+// the high bits of vertex ids, or the exponent of coordinates with similar magnitude) are skipped. With
+// multithreading each pass runs on independent chunks, which write at offsets computed from their histograms
+template<typename K>
+inline void radix_sort_pairs(std::vector<std::pair<K, uint>>& items, bool parallel) {
+  static_assert(std::is_unsigned<K>::value, "radix keys must be unsigned integers");
+  constexpr uint RADIX_BITS = 11;
+  constexpr uint RADIX_SIZE = 1 << RADIX_BITS;
+  constexpr uint NUM_PASSES = (sizeof(K) * 8 + RADIX_BITS - 1) / RADIX_BITS;
+
+  const uint n = static_cast<uint>(items.size());
+  if(n < 2) return;
+
+  uint num_chunks = 1;
+#if ENABLE_MULTITHREADING
+  if(parallel) num_chunks = std::max(1u, std::min(n / (1u << 16), 4u * static_cast<uint>(tbb::this_task_arena::max_concurrency())));
+#endif
+  const uint chunk_size = (n + num_chunks - 1) / num_chunks;
+
+  auto for_each_chunk = [&](const auto& fn) {
+#if ENABLE_MULTITHREADING
+    if(num_chunks > 1) { tbb::parallel_for(0u, num_chunks, fn); return; }
+#endif
+    for(uint c = 0; c < num_chunks; c++) fn(c);
+  };
+
+  std::vector<std::pair<K, uint>> tmp(n);
+  std::vector<uint> hist(num_chunks * RADIX_SIZE);
+
+  for(uint pass = 0; pass < NUM_PASSES; pass++) {
+    const uint shift = pass * RADIX_BITS;
+
+    std::fill(hist.begin(), hist.end(), 0);
+    for_each_chunk([&](uint c) {
+      uint* h = &hist[c * RADIX_SIZE];
+      for(uint i = c * chunk_size; i < std::min(n, (c + 1) * chunk_size); i++)
+        h[(items[i].first >> shift) & (RADIX_SIZE - 1)]++;
+    });
+
+    // exclusive prefix sum, digit-major so that each chunk writes after the previous ones (stability)
+    uint sum = 0;
+    bool trivial_pass = false;
+    for(uint d = 0; d < RADIX_SIZE && !trivial_pass; d++) {
+      uint digit_sum = sum;
+      for(uint c = 0; c < num_chunks; c++) {
+        uint cnt = hist[c * RADIX_SIZE + d];
+        hist[c * RADIX_SIZE + d] = sum;
+        sum += cnt;
+      }
+      trivial_pass = (sum - digit_sum == n);
+    }
+    if(trivial_pass) continue; // all the keys share this digit
+
+    for_each_chunk([&](uint c) {
+      uint* h = &hist[c * RADIX_SIZE];
+      for(uint i = c * chunk_size; i < std::min(n, (c + 1) * chunk_size); i++)
+        tmp[h[(items[i].first >> shift) & (RADIX_SIZE - 1)]++] = items[i];
+    });
+
+    items.swap(tmp);
+  }
+}
+
+// the half-edges of a triangle list (id 3 * t_id + off, joining tri vertices off and (off + 1) % 3) keyed by
+// the unique (min, max) pair of their endpoints and sorted by key, so that all the copies of the same edge
+// are contiguous and ordered by half-edge id. Edge ids can then be assigned with a single scan
+inline std::vector<std::pair<uint64_t, uint>> sorted_half_edges(const std::vector<uint>& tris, bool parallel) {
+  std::vector<std::pair<uint64_t, uint>> half_edges(tris.size());
+
+  auto build_half_edge = [&](uint he_id) {
+    uint v0 = tris[he_id];
+    uint v1 = tris[(he_id % 3 == 2) ? he_id - 2 : he_id + 1];
+    if(v0 > v1) std::swap(v0, v1);
+    half_edges[he_id] = {(static_cast<uint64_t>(v0) << 32) | v1, he_id};
+  };
+
+  if(parallel) {
+#if ENABLE_MULTITHREADING
+    tbb::parallel_for((uint)0, (uint)half_edges.size(), build_half_edge);
+#endif
+  } else {
+    for(uint he_id = 0; he_id < (uint)half_edges.size(); he_id++) build_half_edge(he_id);
+  }
+
+  radix_sort_pairs(half_edges, parallel); // stable: equal keys keep the half-edge order
+
+  return half_edges;
+}
+
 namespace std {
 template<typename T, size_t N>
 struct hash<std::array<T, N>>
@@ -180,6 +274,18 @@ struct bucket_arena {
     buckets.back().pop_back();
     if(buckets.back().empty()) buckets.pop_back();
   }
+
+  // destroys the elements, keeping the storage of the first bucket
+  void clear() {
+    if(buckets.size() > 1) buckets.resize(1);
+    if(!buckets.empty()) buckets.front().clear();
+  }
+
+  size_t memoryFootprint() const {
+    size_t bytes = 0;
+    for(const auto& bucket : buckets) bytes += bucket.capacity() * sizeof(T);
+    return bytes;
+  }
 };
 
 struct point_arena {
@@ -187,6 +293,18 @@ struct point_arena {
   bucket_arena<implicitPoint3D_LPI, 1024 * 1024> edges;
   bucket_arena<explicitPoint3D, 1024> jolly;
   bucket_arena<implicitPoint3D_TPI, 1024 * 1024> tpi;
+
+  // bytes reserved for the points (the cached lambdas of the implicit points are not included)
+  size_t memoryFootprint() const {
+    return init.capacity() * sizeof(explicitPoint3D) + edges.memoryFootprint() + jolly.memoryFootprint() + tpi.memoryFootprint();
+  }
+
+  void clear() {
+    init.clear();
+    edges.clear();
+    jolly.clear();
+    tpi.clear();
+  }
 };
 
 #else
@@ -196,8 +314,117 @@ struct point_arena {
   std::deque<implicitPoint3D_LPI> edges;
   std::deque<explicitPoint3D> jolly;
   std::deque<implicitPoint3D_TPI> tpi;
+
+  // bytes used by the points (the cached lambdas of the implicit points are not included)
+  size_t memoryFootprint() const {
+    return init.capacity() * sizeof(explicitPoint3D) + edges.size() * sizeof(implicitPoint3D_LPI) +
+           jolly.size() * sizeof(explicitPoint3D) + tpi.size() * sizeof(implicitPoint3D_TPI);
+  }
+
+  void clear() {
+    init.clear();
+    edges.clear();
+    jolly.clear();
+    tpi.clear();
+  }
 };
 
 #endif
 
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// why a ProgressMonitor stopped its computation
+enum StopReason : uint32_t { NOT_STOPPED, CANCELLED, OUT_OF_TIME, TOO_MANY_PAIRS, TOO_MANY_POINTS };
+
+// thrown at the checkpoint of a ProgressMonitor that has been cancelled, or whose budget has been exceeded
+struct OperationCancelled : std::exception {
+  StopReason reason;
+
+  explicit OperationCancelled(StopReason reason) : reason(reason) {}
+  const char* what() const noexcept override { return reason == CANCELLED ? "operation cancelled" : "operation over budget"; }
+};
+
+// progress of a computation running on another thread, and its cooperative cancellation. The computation reports
+// the stage it is in and, inside the long loops, how many of the items of the stage it has done, every GRANULARITY
+// items. Each report is also a checkpoint: once cancel() has been called, or once the budget of the computation has
+// been exceeded, the next one throws OperationCancelled, which unwinds the computation up to whoever started it
+class ProgressMonitor {
+public:
+  static constexpr uint64_t GRANULARITY = 256;
+
+  // no limit where the argument is 0 (or no deadline). To be set by the thread that runs the computation, before it starts
+  void setBudget(std::optional<std::chrono::steady_clock::time_point> deadline, uint64_t max_pairs, uint64_t max_implicit_points) {
+    this->deadline = deadline;
+    this->max_pairs = max_pairs;
+    this->max_implicit_points = max_implicit_points;
+  }
+
+  void beginStage(uint32_t stage) {
+    checkpoint();
+    num_done.store(0, std::memory_order_relaxed);
+    num_items.store(0, std::memory_order_relaxed);
+    curr_stage.store(stage, std::memory_order_relaxed);
+  }
+
+  // the current stage is made of n items (triangles, pairs of triangles, octree leaves...)
+  void beginItems(uint64_t n) {
+    checkpoint();
+    num_done.store(0, std::memory_order_relaxed);
+    num_items.store(n, std::memory_order_relaxed);
+  }
+
+  // n more items are done. May be called from several threads at once
+  void advance(uint64_t n) {
+    num_done.fetch_add(n, std::memory_order_relaxed);
+    checkpoint();
+  }
+
+  // as above, and the computation has made num_implicit_points implicit points so far
+  void advance(uint64_t n, uint64_t num_implicit_points) {
+    if(max_implicit_points && num_implicit_points > max_implicit_points) stop(TOO_MANY_POINTS);
+    advance(n);
+  }
+
+  // the computation has found num_pairs pairs of intersecting triangles
+  void countPairs(uint64_t num_pairs) {
+    if(max_pairs && num_pairs > max_pairs) stop(TOO_MANY_PAIRS);
+    checkpoint();
+  }
+
+  void checkpoint() {
+    if(deadline && std::chrono::steady_clock::now() > *deadline) stop(OUT_OF_TIME);
+    const StopReason r = stop_reason.load(std::memory_order_relaxed);
+    if(r != NOT_STOPPED) throw OperationCancelled(r);
+  }
+
+  void cancel() {
+    StopReason expected = NOT_STOPPED;
+    stop_reason.compare_exchange_strong(expected, CANCELLED, std::memory_order_relaxed);
+  }
+
+  // the first reason the computation has been stopped for, NOT_STOPPED if it has not
+  StopReason stopReason() const { return stop_reason.load(std::memory_order_relaxed); }
+
+  uint32_t stage() const { return curr_stage.load(std::memory_order_relaxed); }
+
+  // fraction of the items of the current stage done so far, 0 if the stage does not count its items
+  double stageFraction() const {
+    const uint64_t n = num_items.load(std::memory_order_relaxed);
+    return n ? std::min(1.0, double(num_done.load(std::memory_order_relaxed)) / double(n)) : 0.0;
+  }
+
+private:
+  std::atomic<StopReason> stop_reason{NOT_STOPPED};
+  std::atomic<uint32_t> curr_stage{0};
+  std::atomic<uint64_t> num_done{0}, num_items{0};
+  std::optional<std::chrono::steady_clock::time_point> deadline;
+  uint64_t max_pairs = 0, max_implicit_points = 0;
+
+  [[noreturn]] void stop(StopReason reason) {
+    StopReason expected = NOT_STOPPED;
+    stop_reason.compare_exchange_strong(expected, reason, std::memory_order_relaxed);
+    throw OperationCancelled(stop_reason.load(std::memory_order_relaxed));
+  }
+};
+
 #endif
@@ -372,12 +372,15 @@ public:
 		file << return_type << func_name << "(" << createParameterProtoList("double") << ")\n{\n";
 
 		file << "   int ret;\n";
+		file << "   IP_STATS_PREDICATE(" << func_name << ");\n";
 		if (!is_lambda && !is_indirect) {
 			file << comm << "   ret = " << filtered_funcname << "(" << all_pars << ");\n";
 			file << comm << "   if (ret != Filtered_Sign::UNCERTAIN) return ret;\n";
 		}
+		file << "   IP_STATS_STAGE(STAGE_INTERVAL);\n";
 		file << "   ret = " << interval_funcname << "(" << all_pars << ");\n";
 		file << "   if (ret != Filtered_Sign::UNCERTAIN) return ret;\n";
+		file << "   IP_STATS_STAGE(STAGE_EXACT);\n";
 		file << "   return " << exact_funcname << "(" << all_pars << ");\n";
 
 		file << "}\n\n";
@@ -1005,11 +1008,11 @@ public:
 					file << " }\n\n";
 #ifdef UNDERFLOW_GUARDING
 					file << "#ifdef CHECK_FOR_XYZERFLOWS\n";
-					file << "   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = ";
+					file << "   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = ";
 
 					string bigfloatname = funcname.substr(0, funcname.size() - 6) + "_bigfloat";
 
-					file << bigfloatname << "(" << createParameterValueList() << ");\n";
+					file << bigfloatname << "(" << createParameterValueList() << "); }\n";
 					file << "#endif\n\n";
 #endif
 					for (variable& v : all_vars) if (v.isInput() && v.is_lambda_out)
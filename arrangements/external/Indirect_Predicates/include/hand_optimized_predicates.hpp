@@ -113,10 +113,12 @@ inline int orient2d_exact(double p1x, double p1y, double p2x, double p2y, double
 
 inline int orient2d(double p1x, double p1y, double p2x, double p2y, double p3x, double p3y)
 {
+   IP_STATS_PREDICATE(orient2d);
    int ret = orient2d_filtered(p1x, p1y, p2x, p2y, p3x, p3y);
    if (ret) return ret;
    //ret = orient2d_interval(p1x, p1y, p2x, p2y, p3x, p3y);
    //if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return orient2d_exact(p1x, p1y, p2x, p2y, p3x, p3y);
 }
 
@@ -391,9 +393,11 @@ inline int orient3d_exact(double pdx, double pdy, double pdz, double pax, double
 inline int orient3d(double px, double py, double pz, double qx, double qy, double qz, double rx, double ry, double rz, double sx, double sy, double sz)
 {
    int ret;
+   IP_STATS_PREDICATE(orient3d);
    ret = orient3d_filtered(px, py, pz, qx, qy, qz, rx, ry, rz, sx, sy, sz);
    if (ret) return ret;
    //ret = orient3d_interval(px, py, pz, qx, qy, qz, rx, ry, rz, sx, sy, sz);
    //if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return orient3d_exact(px, py, pz, qx, qy, qz, rx, ry, rz, sx, sy, sz);
 }
@@ -29,6 +29,7 @@
 #define IMPLICIT_POINT_H
 
 #include "numerics.h"
+#include "predicate_stats.h"
 #include <iostream>
 
 // An indirect predicate can assume one of the following values.
@@ -143,6 +144,15 @@ public:
 	// Input can be any combination of 3D points
 	static int orient3D(const genericPoint& a, const genericPoint& b, const genericPoint& c, const genericPoint& d);
 
+	// Orient3D with some of the arguments known to be explicit at compile time.
+	// The type tests and argument permutations for those arguments are skipped, but
+	// the same kernel is reached with the same argument order, so the result is the
+	// same as the generic version's.
+	static int orient3D(const class explicitPoint3D& a, const class explicitPoint3D& b, const class explicitPoint3D& c, const class explicitPoint3D& d);
+	static int orient3D(const class explicitPoint3D& a, const class explicitPoint3D& b, const class explicitPoint3D& c, const genericPoint& d);
+	static int orient3D(const genericPoint& a, const genericPoint& b, const genericPoint& c, const class explicitPoint3D& d);
+	static int orient3D(const genericPoint& a, const genericPoint& b, const class explicitPoint3D& c, const class explicitPoint3D& d);
+
 	// InSphere - fully supported
 	// Input can be any combination of 3D points
 	static int inSphere(const genericPoint& a, const genericPoint& b, const genericPoint& c, const genericPoint& d, const genericPoint& e);
@@ -484,6 +494,7 @@ inline ostream& operator<<(ostream& os, const implicitPoint3D_LNC& p)
 	else return os << "UNDEF_LNC";
 }
 
+#include "predicate_capture.h"
 #include "hand_optimized_predicates.hpp"
 #include "implicit_point.hpp"
 
@@ -60,6 +60,7 @@ inline int lessThan_IE(const genericPoint& a, const genericPoint& b) { return le
 
 inline int genericPoint::lessThan(const genericPoint& a, const genericPoint& b)
 {
+		IP_CAPTURE(LESSTHAN, lessThan(a, b), a, b);
 		if (a.isExplicit3D() && b.isExplicit3D()) return lessThan_EE(a, b);
 		if (!a.isExplicit3D() && b.isExplicit3D()) return lessThan_IE(a, b);
 		if (a.isExplicit3D() && !b.isExplicit3D()) return -lessThan_IE(b, a);
@@ -161,6 +162,8 @@ inline int orient2dxy_III(const genericPoint& a, const genericPoint& b, const ge
 
 inline int genericPoint::orient2Dxy(const genericPoint& a, const genericPoint& b, const genericPoint& c)
 {
+	IP_CAPTURE(ORIENT2DXY, orient2Dxy(a, b, c), a, b, c);
+
 	if (a.isExplicit3D() && b.isExplicit3D() && c.isExplicit3D()) return orient2dxy_EEE(a, b, c);
 
 	if (!a.isExplicit3D() && b.isExplicit3D() && c.isExplicit3D()) return orient2dxy_IEE(a, b, c);
@@ -182,6 +185,8 @@ inline int orient2dyz_III(const genericPoint& a, const genericPoint& b, const ge
 
 inline int genericPoint::orient2Dyz(const genericPoint& a, const genericPoint& b, const genericPoint& c)
 {
+	IP_CAPTURE(ORIENT2DYZ, orient2Dyz(a, b, c), a, b, c);
+
 	if (a.isExplicit3D() && b.isExplicit3D() && c.isExplicit3D()) return orient2dyz_EEE(a, b, c);
 
 	if (!a.isExplicit3D() && b.isExplicit3D() && c.isExplicit3D()) return orient2dyz_IEE(a, b, c);
@@ -203,6 +208,8 @@ inline int orient2dzx_III(const genericPoint& a, const genericPoint& b, const ge
 
 inline int genericPoint::orient2Dzx(const genericPoint& a, const genericPoint& b, const genericPoint& c)
 {
+	IP_CAPTURE(ORIENT2DZX, orient2Dzx(a, b, c), a, b, c);
+
 	if (a.isExplicit3D() && b.isExplicit3D() && c.isExplicit3D()) return orient2dzx_EEE(a, b, c);
 
 	if (!a.isExplicit3D() && b.isExplicit3D() && c.isExplicit3D()) return orient2dzx_IEE(a, b, c);
@@ -243,6 +250,8 @@ inline int orient3d_IIIE(const genericPoint& a, const genericPoint& b, const gen
 
 inline int genericPoint::orient3D(const genericPoint& a, const genericPoint& b, const genericPoint& c, const genericPoint& d)
 {
+	IP_CAPTURE(ORIENT3D, orient3D(a, b, c, d), a, b, c, d);
+
 	// Here we implicitly assume that points are 3D. Do not check.
 
 	const int i = a.isExplicit3D() + b.isExplicit3D() + c.isExplicit3D() + d.isExplicit3D();
@@ -278,6 +287,56 @@ inline int genericPoint::orient3D(const genericPoint& a, const genericPoint& b,
 	return orient3d_indirect_IIII(a, b, c, d);
 }
 
+inline int genericPoint::orient3D(const explicitPoint3D& a, const explicitPoint3D& b, const explicitPoint3D& c, const explicitPoint3D& d)
+{
+	IP_CAPTURE(ORIENT3D, orient3D(a, b, c, d), a, b, c, d);
+
+	return orient3d(a.X(), a.Y(), a.Z(), b.X(), b.Y(), b.Z(), c.X(), c.Y(), c.Z(), d.X(), d.Y(), d.Z());
+}
+
+inline int genericPoint::orient3D(const explicitPoint3D& a, const explicitPoint3D& b, const explicitPoint3D& c, const genericPoint& d)
+{
+	IP_CAPTURE(ORIENT3D, orient3D(a, b, c, d), a, b, c, d);
+
+	if (d.isExplicit3D()) return orient3d_EEEE(a, b, c, d);
+	return orient3d_IEEE(d, a, c, b);
+}
+
+inline int genericPoint::orient3D(const genericPoint& a, const genericPoint& b, const genericPoint& c, const explicitPoint3D& d)
+{
+	IP_CAPTURE(ORIENT3D, orient3D(a, b, c, d), a, b, c, d);
+
+	const int i = a.isExplicit3D() + b.isExplicit3D() + c.isExplicit3D();
+
+	if (i == 3) return orient3d_EEEE(a, b, c, d);
+
+	if (i == 2)
+	{
+		if (!a.isExplicit3D()) return orient3d_IEEE(a, b, c, d);
+		if (!b.isExplicit3D()) return orient3d_IEEE(b, c, a, d);
+		return orient3d_IEEE(c, d, a, b);
+	}
+
+	if (i == 1)
+	{
+		if (c.isExplicit3D()) return orient3d_IIEE(a, b, c, d);
+		if (b.isExplicit3D()) return orient3d_IIEE(a, c, d, b);
+		return orient3d_IIEE(b, c, a, d);
+	}
+
+	return orient3d_IIIE(a, b, c, d);
+}
+
+inline int genericPoint::orient3D(const genericPoint& a, const genericPoint& b, const explicitPoint3D& c, const explicitPoint3D& d)
+{
+	IP_CAPTURE(ORIENT3D, orient3D(a, b, c, d), a, b, c, d);
+
+	if (a.isExplicit3D() && b.isExplicit3D()) return orient3d_EEEE(a, b, c, d);
+	if (!a.isExplicit3D() && b.isExplicit3D()) return orient3d_IEEE(a, b, c, d);
+	if (a.isExplicit3D()) return orient3d_IEEE(b, c, a, d);
+	return orient3d_IIEE(a, b, c, d);
+}
+
 inline int inSphere_IEEEE(const genericPoint& a, const genericPoint& b, const genericPoint& c, const genericPoint& d, const genericPoint& e) {
 	return inSphere_IEEEE(a,
 		b.toExplicit3D().X(), b.toExplicit3D().Y(), b.toExplicit3D().Z(),
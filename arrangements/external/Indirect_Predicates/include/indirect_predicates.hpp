@@ -117,10 +117,13 @@ inline int dotProductSign2D_exact(double px, double py, double rx, double ry, do
 inline int dotProductSign2D(double px, double py, double rx, double ry, double qx, double qy)
 {
    int ret;
+   IP_STATS_PREDICATE(dotProductSign2D);
    ret = dotProductSign2D_filtered(px, py, rx, ry, qx, qy);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = dotProductSign2D_interval(px, py, rx, ry, qx, qy);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return dotProductSign2D_exact(px, py, rx, ry, qx, qy);
 }
 
@@ -228,10 +231,13 @@ inline int dotProductSign3D_exact(double px, double py, double pz, double rx, do
 inline int dotProductSign3D(double px, double py, double pz, double rx, double ry, double rz, double qx, double qy, double qz)
 {
    int ret;
+   IP_STATS_PREDICATE(dotProductSign3D);
    ret = dotProductSign3D_filtered(px, py, pz, rx, ry, rz, qx, qy, qz);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = dotProductSign3D_interval(px, py, pz, rx, ry, rz, qx, qy, qz);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return dotProductSign3D_exact(px, py, pz, rx, ry, rz, qx, qy, qz);
 }
 
@@ -435,10 +441,13 @@ inline int incircle_exact(double pax, double pay, double pbx, double pby, double
 inline int incircle(double pax, double pay, double pbx, double pby, double pcx, double pcy, double pdx, double pdy)
 {
    int ret;
+   IP_STATS_PREDICATE(incircle);
    ret = incircle_filtered(pax, pay, pbx, pby, pcx, pcy, pdx, pdy);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = incircle_interval(pax, pay, pbx, pby, pcx, pcy, pdx, pdy);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return incircle_exact(pax, pay, pbx, pby, pcx, pcy, pdx, pdy);
 }
 
@@ -911,10 +920,13 @@ inline int inSphere_exact(double pax, double pay, double paz, double pbx, double
 inline int inSphere(double pax, double pay, double paz, double pbx, double pby, double pbz, double pcx, double pcy, double pcz, double pdx, double pdy, double pdz, double pex, double pey, double pez)
 {
    int ret;
+   IP_STATS_PREDICATE(inSphere);
    ret = inSphere_filtered(pax, pay, paz, pbx, pby, pbz, pcx, pcy, pcz, pdx, pdy, pdz, pex, pey, pez);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = inSphere_interval(pax, pay, paz, pbx, pby, pbz, pcx, pcy, pcz, pdx, pdy, pdz, pex, pey, pez);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return inSphere_exact(pax, pay, paz, pbx, pby, pbz, pcx, pcy, pcz, pdx, pdy, pdz, pex, pey, pez);
 }
 
@@ -1011,7 +1023,7 @@ inline int dotProductSign2D_EEI_exact(const genericPoint& q, double px, double p
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = dotProductSign2D_EEI_bigfloat(q, px, py, rx, ry);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = dotProductSign2D_EEI_bigfloat(q, px, py, rx, ry); }
 #endif
 
 
@@ -1024,8 +1036,11 @@ inline int dotProductSign2D_EEI_exact(const genericPoint& q, double px, double p
 inline int dotProductSign2D_EEI(const genericPoint& q, double px, double py, double rx, double ry)
 {
    int ret;
+   IP_STATS_PREDICATE(dotProductSign2D_EEI);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = dotProductSign2D_EEI_interval(q, px, py, rx, ry);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return dotProductSign2D_EEI_exact(q, px, py, rx, ry);
 }
 
@@ -1110,7 +1125,7 @@ inline int dotProductSign2D_IEE_exact(const genericPoint& p, double rx, double r
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = dotProductSign2D_IEE_bigfloat(p, rx, ry, qx, qy);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = dotProductSign2D_IEE_bigfloat(p, rx, ry, qx, qy); }
 #endif
 
 
@@ -1123,8 +1138,11 @@ inline int dotProductSign2D_IEE_exact(const genericPoint& p, double rx, double r
 inline int dotProductSign2D_IEE(const genericPoint& p, double rx, double ry, double qx, double qy)
 {
    int ret;
+   IP_STATS_PREDICATE(dotProductSign2D_IEE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = dotProductSign2D_IEE_interval(p, rx, ry, qx, qy);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return dotProductSign2D_IEE_exact(p, rx, ry, qx, qy);
 }
 
@@ -1239,7 +1257,7 @@ inline int dotProductSign2D_IEI_exact(const genericPoint& p, const genericPoint&
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = dotProductSign2D_IEI_bigfloat(p, q, rx, ry);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = dotProductSign2D_IEI_bigfloat(p, q, rx, ry); }
 #endif
 
  if (lpx_p != lpx) FreeDoubles(lpx);
@@ -1258,8 +1276,11 @@ inline int dotProductSign2D_IEI_exact(const genericPoint& p, const genericPoint&
 inline int dotProductSign2D_IEI(const genericPoint& p, const genericPoint& q, double rx, double ry)
 {
    int ret;
+   IP_STATS_PREDICATE(dotProductSign2D_IEI);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = dotProductSign2D_IEI_interval(p, q, rx, ry);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return dotProductSign2D_IEI_exact(p, q, rx, ry);
 }
 
@@ -1359,7 +1380,7 @@ inline int dotProductSign2D_IIE_exact(const genericPoint& p, const genericPoint&
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = dotProductSign2D_IIE_bigfloat(p, r, qx, qy);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = dotProductSign2D_IIE_bigfloat(p, r, qx, qy); }
 #endif
 
  if (lpx_p != lpx) FreeDoubles(lpx);
@@ -1378,8 +1399,11 @@ inline int dotProductSign2D_IIE_exact(const genericPoint& p, const genericPoint&
 inline int dotProductSign2D_IIE(const genericPoint& p, const genericPoint& r, double qx, double qy)
 {
    int ret;
+   IP_STATS_PREDICATE(dotProductSign2D_IIE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = dotProductSign2D_IIE_interval(p, r, qx, qy);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return dotProductSign2D_IIE_exact(p, r, qx, qy);
 }
 
@@ -1502,7 +1526,7 @@ inline int dotProductSign2D_III_exact(const genericPoint& p, const genericPoint&
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = dotProductSign2D_III_bigfloat(p, r, q);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = dotProductSign2D_III_bigfloat(p, r, q); }
 #endif
 
  if (lpx_p != lpx) FreeDoubles(lpx);
@@ -1524,8 +1548,11 @@ inline int dotProductSign2D_III_exact(const genericPoint& p, const genericPoint&
 inline int dotProductSign2D_III(const genericPoint& p, const genericPoint& r, const genericPoint& q)
 {
    int ret;
+   IP_STATS_PREDICATE(dotProductSign2D_III);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = dotProductSign2D_III_interval(p, r, q);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return dotProductSign2D_III_exact(p, r, q);
 }
 
@@ -1652,7 +1679,7 @@ inline int dotProductSign3D_EEI_exact(const genericPoint& q, double px, double p
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = dotProductSign3D_EEI_bigfloat(q, px, py, pz, rx, ry, rz);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = dotProductSign3D_EEI_bigfloat(q, px, py, pz, rx, ry, rz); }
 #endif
 
  if (lqx_p != lqx) FreeDoubles(lqx);
@@ -1669,8 +1696,11 @@ inline int dotProductSign3D_EEI_exact(const genericPoint& q, double px, double p
 inline int dotProductSign3D_EEI(const genericPoint& q, double px, double py, double pz, double rx, double ry, double rz)
 {
    int ret;
+   IP_STATS_PREDICATE(dotProductSign3D_EEI);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = dotProductSign3D_EEI_interval(q, px, py, pz, rx, ry, rz);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return dotProductSign3D_EEI_exact(q, px, py, pz, rx, ry, rz);
 }
 
@@ -1779,7 +1809,7 @@ inline int dotProductSign3D_IEE_exact(const genericPoint& p, double rx, double r
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = dotProductSign3D_IEE_bigfloat(p, rx, ry, rz, qx, qy, qz);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = dotProductSign3D_IEE_bigfloat(p, rx, ry, rz, qx, qy, qz); }
 #endif
 
 
@@ -1792,8 +1822,11 @@ inline int dotProductSign3D_IEE_exact(const genericPoint& p, double rx, double r
 inline int dotProductSign3D_IEE(const genericPoint& p, double rx, double ry, double rz, double qx, double qy, double qz)
 {
    int ret;
+   IP_STATS_PREDICATE(dotProductSign3D_IEE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = dotProductSign3D_IEE_interval(p, rx, ry, rz, qx, qy, qz);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return dotProductSign3D_IEE_exact(p, rx, ry, rz, qx, qy, qz);
 }
 
@@ -1943,7 +1976,7 @@ inline int dotProductSign3D_IEI_exact(const genericPoint& p, const genericPoint&
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = dotProductSign3D_IEI_bigfloat(p, q, rx, ry, rz);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = dotProductSign3D_IEI_bigfloat(p, q, rx, ry, rz); }
 #endif
 
  if (lpx_p != lpx) FreeDoubles(lpx);
@@ -1964,8 +1997,11 @@ inline int dotProductSign3D_IEI_exact(const genericPoint& p, const genericPoint&
 inline int dotProductSign3D_IEI(const genericPoint& p, const genericPoint& q, double rx, double ry, double rz)
 {
    int ret;
+   IP_STATS_PREDICATE(dotProductSign3D_IEI);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = dotProductSign3D_IEI_interval(p, q, rx, ry, rz);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return dotProductSign3D_IEI_exact(p, q, rx, ry, rz);
 }
 
@@ -2095,7 +2131,7 @@ inline int dotProductSign3D_IIE_exact(const genericPoint& p, const genericPoint&
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = dotProductSign3D_IIE_bigfloat(p, r, qx, qy, qz);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = dotProductSign3D_IIE_bigfloat(p, r, qx, qy, qz); }
 #endif
 
  if (lpx_p != lpx) FreeDoubles(lpx);
@@ -2116,8 +2152,11 @@ inline int dotProductSign3D_IIE_exact(const genericPoint& p, const genericPoint&
 inline int dotProductSign3D_IIE(const genericPoint& p, const genericPoint& r, double qx, double qy, double qz)
 {
    int ret;
+   IP_STATS_PREDICATE(dotProductSign3D_IIE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = dotProductSign3D_IIE_interval(p, r, qx, qy, qz);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return dotProductSign3D_IIE_exact(p, r, qx, qy, qz);
 }
 
@@ -2280,7 +2319,7 @@ inline int dotProductSign3D_III_exact(const genericPoint& p, const genericPoint&
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = dotProductSign3D_III_bigfloat(p, r, q);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = dotProductSign3D_III_bigfloat(p, r, q); }
 #endif
 
  if (lpx_p != lpx) FreeDoubles(lpx);
@@ -2305,8 +2344,11 @@ inline int dotProductSign3D_III_exact(const genericPoint& p, const genericPoint&
 inline int dotProductSign3D_III(const genericPoint& p, const genericPoint& r, const genericPoint& q)
 {
    int ret;
+   IP_STATS_PREDICATE(dotProductSign3D_III);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = dotProductSign3D_III_interval(p, r, q);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return dotProductSign3D_III_exact(p, r, q);
 }
 
@@ -2500,7 +2542,7 @@ inline int incirclexy_indirect_IEEE_exact(const genericPoint& p1, double pbx, do
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = incirclexy_indirect_IEEE_bigfloat(p1, pbx, pby, pcx, pcy, pdx, pdy);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = incirclexy_indirect_IEEE_bigfloat(p1, pbx, pby, pcx, pcy, pdx, pdy); }
 #endif
 
  if (l1x_p != l1x) FreeDoubles(l1x);
@@ -2517,8 +2559,11 @@ inline int incirclexy_indirect_IEEE_exact(const genericPoint& p1, double pbx, do
 inline int incirclexy_indirect_IEEE(const genericPoint& p1, double pbx, double pby, double pcx, double pcy, double pdx, double pdy)
 {
    int ret;
+   IP_STATS_PREDICATE(incirclexy_indirect_IEEE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = incirclexy_indirect_IEEE_interval(p1, pbx, pby, pcx, pcy, pdx, pdy);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return incirclexy_indirect_IEEE_exact(p1, pbx, pby, pcx, pcy, pdx, pdy);
 }
 
@@ -2738,7 +2783,7 @@ inline int incirclexy_indirect_IIEE_exact(const genericPoint& p1, const genericP
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = incirclexy_indirect_IIEE_bigfloat(p1, p2, pcx, pcy, pdx, pdy);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = incirclexy_indirect_IIEE_bigfloat(p1, p2, pcx, pcy, pdx, pdy); }
 #endif
 
  if (l1x_p != l1x) FreeDoubles(l1x);
@@ -2759,8 +2804,11 @@ inline int incirclexy_indirect_IIEE_exact(const genericPoint& p1, const genericP
 inline int incirclexy_indirect_IIEE(const genericPoint& p1, const genericPoint& p2, double pcx, double pcy, double pdx, double pdy)
 {
    int ret;
+   IP_STATS_PREDICATE(incirclexy_indirect_IIEE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = incirclexy_indirect_IIEE_interval(p1, p2, pcx, pcy, pdx, pdy);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return incirclexy_indirect_IIEE_exact(p1, p2, pcx, pcy, pdx, pdy);
 }
 
@@ -3008,7 +3056,7 @@ inline int incirclexy_indirect_IIIE_exact(const genericPoint& p1, const genericP
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = incirclexy_indirect_IIIE_bigfloat(p1, p2, p3, pdx, pdy);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = incirclexy_indirect_IIIE_bigfloat(p1, p2, p3, pdx, pdy); }
 #endif
 
  if (l1x_p != l1x) FreeDoubles(l1x);
@@ -3033,8 +3081,11 @@ inline int incirclexy_indirect_IIIE_exact(const genericPoint& p1, const genericP
 inline int incirclexy_indirect_IIIE(const genericPoint& p1, const genericPoint& p2, const genericPoint& p3, double pdx, double pdy)
 {
    int ret;
+   IP_STATS_PREDICATE(incirclexy_indirect_IIIE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = incirclexy_indirect_IIIE_interval(p1, p2, p3, pdx, pdy);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return incirclexy_indirect_IIIE_exact(p1, p2, p3, pdx, pdy);
 }
 
@@ -3315,7 +3366,7 @@ inline int incirclexy_indirect_IIII_exact(const genericPoint& p1, const genericP
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = incirclexy_indirect_IIII_bigfloat(p1, p2, p3, p4);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = incirclexy_indirect_IIII_bigfloat(p1, p2, p3, p4); }
 #endif
 
  if (l1x_p != l1x) FreeDoubles(l1x);
@@ -3344,8 +3395,11 @@ inline int incirclexy_indirect_IIII_exact(const genericPoint& p1, const genericP
 inline int incirclexy_indirect_IIII(const genericPoint& p1, const genericPoint& p2, const genericPoint& p3, const genericPoint& p4)
 {
    int ret;
+   IP_STATS_PREDICATE(incirclexy_indirect_IIII);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = incirclexy_indirect_IIII_interval(p1, p2, p3, p4);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return incirclexy_indirect_IIII_exact(p1, p2, p3, p4);
 }
 
@@ -3539,7 +3593,7 @@ inline int incircle_indirect_IEEE_exact(const genericPoint& p1, double pbx, doub
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = incircle_indirect_IEEE_bigfloat(p1, pbx, pby, pcx, pcy, pdx, pdy);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = incircle_indirect_IEEE_bigfloat(p1, pbx, pby, pcx, pcy, pdx, pdy); }
 #endif
 
  if (l1x_p != l1x) FreeDoubles(l1x);
@@ -3555,8 +3609,11 @@ inline int incircle_indirect_IEEE_exact(const genericPoint& p1, double pbx, doub
 inline int incircle_indirect_IEEE(const genericPoint& p1, double pbx, double pby, double pcx, double pcy, double pdx, double pdy)
 {
    int ret;
+   IP_STATS_PREDICATE(incircle_indirect_IEEE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = incircle_indirect_IEEE_interval(p1, pbx, pby, pcx, pcy, pdx, pdy);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return incircle_indirect_IEEE_exact(p1, pbx, pby, pcx, pcy, pdx, pdy);
 }
 
@@ -3776,7 +3833,7 @@ inline int incircle_indirect_IIEE_exact(const genericPoint& p1, const genericPoi
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = incircle_indirect_IIEE_bigfloat(p1, p2, pcx, pcy, pdx, pdy);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = incircle_indirect_IIEE_bigfloat(p1, p2, pcx, pcy, pdx, pdy); }
 #endif
 
  if (l1x_p != l1x) FreeDoubles(l1x);
@@ -3795,8 +3852,11 @@ inline int incircle_indirect_IIEE_exact(const genericPoint& p1, const genericPoi
 inline int incircle_indirect_IIEE(const genericPoint& p1, const genericPoint& p2, double pcx, double pcy, double pdx, double pdy)
 {
    int ret;
+   IP_STATS_PREDICATE(incircle_indirect_IIEE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = incircle_indirect_IIEE_interval(p1, p2, pcx, pcy, pdx, pdy);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return incircle_indirect_IIEE_exact(p1, p2, pcx, pcy, pdx, pdy);
 }
 
@@ -4044,7 +4104,7 @@ inline int incircle_indirect_IIIE_exact(const genericPoint& p1, const genericPoi
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = incircle_indirect_IIIE_bigfloat(p1, p2, p3, pdx, pdy);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = incircle_indirect_IIIE_bigfloat(p1, p2, p3, pdx, pdy); }
 #endif
 
  if (l1x_p != l1x) FreeDoubles(l1x);
@@ -4066,8 +4126,11 @@ inline int incircle_indirect_IIIE_exact(const genericPoint& p1, const genericPoi
 inline int incircle_indirect_IIIE(const genericPoint& p1, const genericPoint& p2, const genericPoint& p3, double pdx, double pdy)
 {
    int ret;
+   IP_STATS_PREDICATE(incircle_indirect_IIIE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = incircle_indirect_IIIE_interval(p1, p2, p3, pdx, pdy);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return incircle_indirect_IIIE_exact(p1, p2, p3, pdx, pdy);
 }
 
@@ -4348,7 +4411,7 @@ inline int incircle_indirect_IIII_exact(const genericPoint& p1, const genericPoi
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = incircle_indirect_IIII_bigfloat(p1, p2, p3, p4);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = incircle_indirect_IIII_bigfloat(p1, p2, p3, p4); }
 #endif
 
  if (l1x_p != l1x) FreeDoubles(l1x);
@@ -4373,8 +4436,11 @@ inline int incircle_indirect_IIII_exact(const genericPoint& p1, const genericPoi
 inline int incircle_indirect_IIII(const genericPoint& p1, const genericPoint& p2, const genericPoint& p3, const genericPoint& p4)
 {
    int ret;
+   IP_STATS_PREDICATE(incircle_indirect_IIII);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = incircle_indirect_IIII_interval(p1, p2, p3, p4);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return incircle_indirect_IIII_exact(p1, p2, p3, p4);
 }
 
@@ -4796,7 +4862,7 @@ inline int inSphere_IEEEE_exact(const genericPoint& p1, double pbx, double pby,
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = inSphere_IEEEE_bigfloat(p1, pbx, pby, pbz, pcx, pcy, pcz, pdx, pdy, pdz, pex, pey, pez);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = inSphere_IEEEE_bigfloat(p1, pbx, pby, pbz, pcx, pcy, pcz, pdx, pdy, pdz, pex, pey, pez); }
 #endif
 
  if (l1x_p != l1x) FreeDoubles(l1x);
@@ -4813,8 +4879,11 @@ inline int inSphere_IEEEE_exact(const genericPoint& p1, double pbx, double pby,
 inline int inSphere_IEEEE(const genericPoint& p1, double pbx, double pby, double pbz, double pcx, double pcy, double pcz, double pdx, double pdy, double pdz, double pex, double pey, double pez)
 {
    int ret;
+   IP_STATS_PREDICATE(inSphere_IEEEE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = inSphere_IEEEE_interval(p1, pbx, pby, pbz, pcx, pcy, pcz, pdx, pdy, pdz, pex, pey, pez);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return inSphere_IEEEE_exact(p1, pbx, pby, pbz, pcx, pcy, pcz, pdx, pdy, pdz, pex, pey, pez);
 }
 
@@ -5277,7 +5346,7 @@ inline int inSphere_IIEEE_exact(const genericPoint& p1, const genericPoint& p2,
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = inSphere_IIEEE_bigfloat(p1, p2, pcx, pcy, pcz, pdx, pdy, pdz, pex, pey, pez);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = inSphere_IIEEE_bigfloat(p1, p2, pcx, pcy, pcz, pdx, pdy, pdz, pex, pey, pez); }
 #endif
 
  if (l1x_p != l1x) FreeDoubles(l1x);
@@ -5298,8 +5367,11 @@ inline int inSphere_IIEEE_exact(const genericPoint& p1, const genericPoint& p2,
 inline int inSphere_IIEEE(const genericPoint& p1, const genericPoint& p2, double pcx, double pcy, double pcz, double pdx, double pdy, double pdz, double pex, double pey, double pez)
 {
    int ret;
+   IP_STATS_PREDICATE(inSphere_IIEEE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = inSphere_IIEEE_interval(p1, p2, pcx, pcy, pcz, pdx, pdy, pdz, pex, pey, pez);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return inSphere_IIEEE_exact(p1, p2, pcx, pcy, pcz, pdx, pdy, pdz, pex, pey, pez);
 }
 
@@ -5800,7 +5872,7 @@ inline int inSphere_IIIEE_exact(const genericPoint& p1, const genericPoint& p2,
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = inSphere_IIIEE_bigfloat(p1, p2, p3, pdx, pdy, pdz, pex, pey, pez);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = inSphere_IIIEE_bigfloat(p1, p2, p3, pdx, pdy, pdz, pex, pey, pez); }
 #endif
 
  if (l1x_p != l1x) FreeDoubles(l1x);
@@ -5825,8 +5897,11 @@ inline int inSphere_IIIEE_exact(const genericPoint& p1, const genericPoint& p2,
 inline int inSphere_IIIEE(const genericPoint& p1, const genericPoint& p2, const genericPoint& p3, double pdx, double pdy, double pdz, double pex, double pey, double pez)
 {
    int ret;
+   IP_STATS_PREDICATE(inSphere_IIIEE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = inSphere_IIIEE_interval(p1, p2, p3, pdx, pdy, pdz, pex, pey, pez);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return inSphere_IIIEE_exact(p1, p2, p3, pdx, pdy, pdz, pex, pey, pez);
 }
 
@@ -6362,7 +6437,7 @@ inline int inSphere_IIIIE_exact(const genericPoint& p1, const genericPoint& p2,
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = inSphere_IIIIE_bigfloat(p1, p2, p3, p4, pex, pey, pez);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = inSphere_IIIIE_bigfloat(p1, p2, p3, p4, pex, pey, pez); }
 #endif
 
  if (l1x_p != l1x) FreeDoubles(l1x);
@@ -6391,8 +6466,11 @@ inline int inSphere_IIIIE_exact(const genericPoint& p1, const genericPoint& p2,
 inline int inSphere_IIIIE(const genericPoint& p1, const genericPoint& p2, const genericPoint& p3, const genericPoint& p4, double pex, double pey, double pez)
 {
    int ret;
+   IP_STATS_PREDICATE(inSphere_IIIIE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = inSphere_IIIIE_interval(p1, p2, p3, p4, pex, pey, pez);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return inSphere_IIIIE_exact(p1, p2, p3, p4, pex, pey, pez);
 }
 
@@ -6991,7 +7069,7 @@ inline int inSphere_IIIII_exact(const genericPoint& p1, const genericPoint& p2,
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = inSphere_IIIII_bigfloat(p1, p2, p3, p4, p5);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = inSphere_IIIII_bigfloat(p1, p2, p3, p4, p5); }
 #endif
 
  if (l1x_p != l1x) FreeDoubles(l1x);
@@ -7024,8 +7102,11 @@ inline int inSphere_IIIII_exact(const genericPoint& p1, const genericPoint& p2,
 inline int inSphere_IIIII(const genericPoint& p1, const genericPoint& p2, const genericPoint& p3, const genericPoint& p4, const genericPoint& p5)
 {
    int ret;
+   IP_STATS_PREDICATE(inSphere_IIIII);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = inSphere_IIIII_interval(p1, p2, p3, p4, p5);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return inSphere_IIIII_exact(p1, p2, p3, p4, p5);
 }
 
@@ -7909,7 +7990,7 @@ inline int lessThanOnX_IE_exact(const genericPoint& p1, double bx)
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = lessThanOnX_IE_bigfloat(p1, bx);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = lessThanOnX_IE_bigfloat(p1, bx); }
 #endif
 
 
@@ -7922,8 +8003,11 @@ inline int lessThanOnX_IE_exact(const genericPoint& p1, double bx)
 inline int lessThanOnX_IE(const genericPoint& p1, double bx)
 {
    int ret;
+   IP_STATS_PREDICATE(lessThanOnX_IE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = lessThanOnX_IE_interval(p1, bx);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return lessThanOnX_IE_exact(p1, bx);
 }
 
@@ -7983,7 +8067,7 @@ inline int lessThanOnX_II_exact(const genericPoint& p1, const genericPoint& p2)
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = lessThanOnX_II_bigfloat(p1, p2);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = lessThanOnX_II_bigfloat(p1, p2); }
 #endif
 
 
@@ -7996,8 +8080,11 @@ inline int lessThanOnX_II_exact(const genericPoint& p1, const genericPoint& p2)
 inline int lessThanOnX_II(const genericPoint& p1, const genericPoint& p2)
 {
    int ret;
+   IP_STATS_PREDICATE(lessThanOnX_II);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = lessThanOnX_II_interval(p1, p2);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return lessThanOnX_II_exact(p1, p2);
 }
 
@@ -8049,7 +8136,7 @@ inline int lessThanOnY_IE_exact(const genericPoint& p1, double by)
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = lessThanOnY_IE_bigfloat(p1, by);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = lessThanOnY_IE_bigfloat(p1, by); }
 #endif
 
 
@@ -8062,8 +8149,11 @@ inline int lessThanOnY_IE_exact(const genericPoint& p1, double by)
 inline int lessThanOnY_IE(const genericPoint& p1, double by)
 {
    int ret;
+   IP_STATS_PREDICATE(lessThanOnY_IE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = lessThanOnY_IE_interval(p1, by);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return lessThanOnY_IE_exact(p1, by);
 }
 
@@ -8123,7 +8213,7 @@ inline int lessThanOnY_II_exact(const genericPoint& p1, const genericPoint& p2)
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = lessThanOnY_II_bigfloat(p1, p2);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = lessThanOnY_II_bigfloat(p1, p2); }
 #endif
 
 
@@ -8136,8 +8226,11 @@ inline int lessThanOnY_II_exact(const genericPoint& p1, const genericPoint& p2)
 inline int lessThanOnY_II(const genericPoint& p1, const genericPoint& p2)
 {
    int ret;
+   IP_STATS_PREDICATE(lessThanOnY_II);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = lessThanOnY_II_interval(p1, p2);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return lessThanOnY_II_exact(p1, p2);
 }
 
@@ -8189,7 +8282,7 @@ inline int lessThanOnZ_IE_exact(const genericPoint& p1, double bz)
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = lessThanOnZ_IE_bigfloat(p1, bz);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = lessThanOnZ_IE_bigfloat(p1, bz); }
 #endif
 
 
@@ -8202,8 +8295,11 @@ inline int lessThanOnZ_IE_exact(const genericPoint& p1, double bz)
 inline int lessThanOnZ_IE(const genericPoint& p1, double bz)
 {
    int ret;
+   IP_STATS_PREDICATE(lessThanOnZ_IE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = lessThanOnZ_IE_interval(p1, bz);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return lessThanOnZ_IE_exact(p1, bz);
 }
 
@@ -8263,7 +8359,7 @@ inline int lessThanOnZ_II_exact(const genericPoint& p1, const genericPoint& p2)
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = lessThanOnZ_II_bigfloat(p1, p2);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = lessThanOnZ_II_bigfloat(p1, p2); }
 #endif
 
 
@@ -8276,8 +8372,11 @@ inline int lessThanOnZ_II_exact(const genericPoint& p1, const genericPoint& p2)
 inline int lessThanOnZ_II(const genericPoint& p1, const genericPoint& p2)
 {
    int ret;
+   IP_STATS_PREDICATE(lessThanOnZ_II);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = lessThanOnZ_II_interval(p1, p2);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return lessThanOnZ_II_exact(p1, p2);
 }
 
@@ -8364,7 +8463,7 @@ inline int orient2dxy_indirect_IEE_exact(const genericPoint& p1, double p2x, dou
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = orient2dxy_indirect_IEE_bigfloat(p1, p2x, p2y, p3x, p3y);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = orient2dxy_indirect_IEE_bigfloat(p1, p2x, p2y, p3x, p3y); }
 #endif
 
 
@@ -8377,8 +8476,11 @@ inline int orient2dxy_indirect_IEE_exact(const genericPoint& p1, double p2x, dou
 inline int orient2dxy_indirect_IEE(const genericPoint& p1, double p2x, double p2y, double p3x, double p3y)
 {
    int ret;
+   IP_STATS_PREDICATE(orient2dxy_indirect_IEE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = orient2dxy_indirect_IEE_interval(p1, p2x, p2y, p3x, p3y);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return orient2dxy_indirect_IEE_exact(p1, p2x, p2y, p3x, p3y);
 }
 
@@ -8488,7 +8590,7 @@ inline int orient2dxy_indirect_IIE_exact(const genericPoint& p1, const genericPo
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = orient2dxy_indirect_IIE_bigfloat(p1, p2, op3x, op3y);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = orient2dxy_indirect_IIE_bigfloat(p1, p2, op3x, op3y); }
 #endif
 
  if (l1x_p != l1x) FreeDoubles(l1x);
@@ -8509,8 +8611,11 @@ inline int orient2dxy_indirect_IIE_exact(const genericPoint& p1, const genericPo
 inline int orient2dxy_indirect_IIE(const genericPoint& p1, const genericPoint& p2, double op3x, double op3y)
 {
    int ret;
+   IP_STATS_PREDICATE(orient2dxy_indirect_IIE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = orient2dxy_indirect_IIE_interval(p1, p2, op3x, op3y);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return orient2dxy_indirect_IIE_exact(p1, p2, op3x, op3y);
 }
 
@@ -8633,7 +8738,7 @@ inline int orient2dxy_indirect_III_exact(const genericPoint& p1, const genericPo
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = orient2dxy_indirect_III_bigfloat(p1, p2, p3);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = orient2dxy_indirect_III_bigfloat(p1, p2, p3); }
 #endif
 
  if (l1x_p != l1x) FreeDoubles(l1x);
@@ -8658,8 +8763,11 @@ inline int orient2dxy_indirect_III_exact(const genericPoint& p1, const genericPo
 inline int orient2dxy_indirect_III(const genericPoint& p1, const genericPoint& p2, const genericPoint& p3)
 {
    int ret;
+   IP_STATS_PREDICATE(orient2dxy_indirect_III);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = orient2dxy_indirect_III_interval(p1, p2, p3);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return orient2dxy_indirect_III_exact(p1, p2, p3);
 }
 
@@ -8746,7 +8854,7 @@ inline int orient2dyz_indirect_IEE_exact(const genericPoint& p1, double p2x, dou
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = orient2dyz_indirect_IEE_bigfloat(p1, p2x, p2y, p3x, p3y);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = orient2dyz_indirect_IEE_bigfloat(p1, p2x, p2y, p3x, p3y); }
 #endif
 
 
@@ -8759,8 +8867,11 @@ inline int orient2dyz_indirect_IEE_exact(const genericPoint& p1, double p2x, dou
 inline int orient2dyz_indirect_IEE(const genericPoint& p1, double p2x, double p2y, double p3x, double p3y)
 {
    int ret;
+   IP_STATS_PREDICATE(orient2dyz_indirect_IEE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = orient2dyz_indirect_IEE_interval(p1, p2x, p2y, p3x, p3y);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return orient2dyz_indirect_IEE_exact(p1, p2x, p2y, p3x, p3y);
 }
 
@@ -8870,7 +8981,7 @@ inline int orient2dyz_indirect_IIE_exact(const genericPoint& p1, const genericPo
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = orient2dyz_indirect_IIE_bigfloat(p1, p2, op3x, op3y);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = orient2dyz_indirect_IIE_bigfloat(p1, p2, op3x, op3y); }
 #endif
 
  if (l1z_p != l1z) FreeDoubles(l1z);
@@ -8891,8 +9002,11 @@ inline int orient2dyz_indirect_IIE_exact(const genericPoint& p1, const genericPo
 inline int orient2dyz_indirect_IIE(const genericPoint& p1, const genericPoint& p2, double op3x, double op3y)
 {
    int ret;
+   IP_STATS_PREDICATE(orient2dyz_indirect_IIE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = orient2dyz_indirect_IIE_interval(p1, p2, op3x, op3y);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return orient2dyz_indirect_IIE_exact(p1, p2, op3x, op3y);
 }
 
@@ -9015,7 +9129,7 @@ inline int orient2dyz_indirect_III_exact(const genericPoint& p1, const genericPo
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = orient2dyz_indirect_III_bigfloat(p1, p2, p3);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = orient2dyz_indirect_III_bigfloat(p1, p2, p3); }
 #endif
 
  if (l1z_p != l1z) FreeDoubles(l1z);
@@ -9040,8 +9154,11 @@ inline int orient2dyz_indirect_III_exact(const genericPoint& p1, const genericPo
 inline int orient2dyz_indirect_III(const genericPoint& p1, const genericPoint& p2, const genericPoint& p3)
 {
    int ret;
+   IP_STATS_PREDICATE(orient2dyz_indirect_III);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = orient2dyz_indirect_III_interval(p1, p2, p3);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return orient2dyz_indirect_III_exact(p1, p2, p3);
 }
 
@@ -9128,7 +9245,7 @@ inline int orient2dzx_indirect_IEE_exact(const genericPoint& p1, double p2x, dou
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = orient2dzx_indirect_IEE_bigfloat(p1, p2x, p2y, p3x, p3y);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = orient2dzx_indirect_IEE_bigfloat(p1, p2x, p2y, p3x, p3y); }
 #endif
 
 
@@ -9141,8 +9258,11 @@ inline int orient2dzx_indirect_IEE_exact(const genericPoint& p1, double p2x, dou
 inline int orient2dzx_indirect_IEE(const genericPoint& p1, double p2x, double p2y, double p3x, double p3y)
 {
    int ret;
+   IP_STATS_PREDICATE(orient2dzx_indirect_IEE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = orient2dzx_indirect_IEE_interval(p1, p2x, p2y, p3x, p3y);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return orient2dzx_indirect_IEE_exact(p1, p2x, p2y, p3x, p3y);
 }
 
@@ -9252,7 +9372,7 @@ inline int orient2dzx_indirect_IIE_exact(const genericPoint& p1, const genericPo
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = orient2dzx_indirect_IIE_bigfloat(p1, p2, op3x, op3y);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = orient2dzx_indirect_IIE_bigfloat(p1, p2, op3x, op3y); }
 #endif
 
  if (l1y_p != l1y) FreeDoubles(l1y);
@@ -9273,8 +9393,11 @@ inline int orient2dzx_indirect_IIE_exact(const genericPoint& p1, const genericPo
 inline int orient2dzx_indirect_IIE(const genericPoint& p1, const genericPoint& p2, double op3x, double op3y)
 {
    int ret;
+   IP_STATS_PREDICATE(orient2dzx_indirect_IIE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = orient2dzx_indirect_IIE_interval(p1, p2, op3x, op3y);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return orient2dzx_indirect_IIE_exact(p1, p2, op3x, op3y);
 }
 
@@ -9397,7 +9520,7 @@ inline int orient2dzx_indirect_III_exact(const genericPoint& p1, const genericPo
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = orient2dzx_indirect_III_bigfloat(p1, p2, p3);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = orient2dzx_indirect_III_bigfloat(p1, p2, p3); }
 #endif
 
  if (l1y_p != l1y) FreeDoubles(l1y);
@@ -9422,8 +9545,11 @@ inline int orient2dzx_indirect_III_exact(const genericPoint& p1, const genericPo
 inline int orient2dzx_indirect_III(const genericPoint& p1, const genericPoint& p2, const genericPoint& p3)
 {
    int ret;
+   IP_STATS_PREDICATE(orient2dzx_indirect_III);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = orient2dzx_indirect_III_interval(p1, p2, p3);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return orient2dzx_indirect_III_exact(p1, p2, p3);
 }
 
@@ -9510,7 +9636,7 @@ inline int orient2d_indirect_IEE_exact(const genericPoint& p1, double p2x, doubl
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = orient2d_indirect_IEE_bigfloat(p1, p2x, p2y, p3x, p3y);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = orient2d_indirect_IEE_bigfloat(p1, p2x, p2y, p3x, p3y); }
 #endif
 
 
@@ -9523,8 +9649,11 @@ inline int orient2d_indirect_IEE_exact(const genericPoint& p1, double p2x, doubl
 inline int orient2d_indirect_IEE(const genericPoint& p1, double p2x, double p2y, double p3x, double p3y)
 {
    int ret;
+   IP_STATS_PREDICATE(orient2d_indirect_IEE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = orient2d_indirect_IEE_interval(p1, p2x, p2y, p3x, p3y);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return orient2d_indirect_IEE_exact(p1, p2x, p2y, p3x, p3y);
 }
 
@@ -9634,7 +9763,7 @@ inline int orient2d_indirect_IIE_exact(const genericPoint& p1, const genericPoin
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = orient2d_indirect_IIE_bigfloat(p1, p2, p3x, p3y);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = orient2d_indirect_IIE_bigfloat(p1, p2, p3x, p3y); }
 #endif
 
  if (l1x_p != l1x) FreeDoubles(l1x);
@@ -9653,8 +9782,11 @@ inline int orient2d_indirect_IIE_exact(const genericPoint& p1, const genericPoin
 inline int orient2d_indirect_IIE(const genericPoint& p1, const genericPoint& p2, double p3x, double p3y)
 {
    int ret;
+   IP_STATS_PREDICATE(orient2d_indirect_IIE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = orient2d_indirect_IIE_interval(p1, p2, p3x, p3y);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return orient2d_indirect_IIE_exact(p1, p2, p3x, p3y);
 }
 
@@ -9777,7 +9909,7 @@ inline int orient2d_indirect_III_exact(const genericPoint& p1, const genericPoin
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = orient2d_indirect_III_bigfloat(p1, p2, p3);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = orient2d_indirect_III_bigfloat(p1, p2, p3); }
 #endif
 
  if (l1x_p != l1x) FreeDoubles(l1x);
@@ -9799,8 +9931,11 @@ inline int orient2d_indirect_III_exact(const genericPoint& p1, const genericPoin
 inline int orient2d_indirect_III(const genericPoint& p1, const genericPoint& p2, const genericPoint& p3)
 {
    int ret;
+   IP_STATS_PREDICATE(orient2d_indirect_III);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = orient2d_indirect_III_interval(p1, p2, p3);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return orient2d_indirect_III_exact(p1, p2, p3);
 }
 
@@ -9966,7 +10101,7 @@ inline int orient3d_indirect_IEEE_exact(const genericPoint& p1, double ax, doubl
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = orient3d_indirect_IEEE_bigfloat(p1, ax, ay, az, bx, by, bz, cx, cy, cz);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = orient3d_indirect_IEEE_bigfloat(p1, ax, ay, az, bx, by, bz, cx, cy, cz); }
 #endif
 
  if (l1x_p != l1x) FreeDoubles(l1x);
@@ -9983,8 +10118,11 @@ inline int orient3d_indirect_IEEE_exact(const genericPoint& p1, double ax, doubl
 inline int orient3d_indirect_IEEE(const genericPoint& p1, double ax, double ay, double az, double bx, double by, double bz, double cx, double cy, double cz)
 {
    int ret;
+   IP_STATS_PREDICATE(orient3d_indirect_IEEE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = orient3d_indirect_IEEE_interval(p1, ax, ay, az, bx, by, bz, cx, cy, cz);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return orient3d_indirect_IEEE_exact(p1, ax, ay, az, bx, by, bz, cx, cy, cz);
 }
 
@@ -10171,7 +10309,7 @@ inline int orient3d_indirect_IIEE_exact(const genericPoint& p1, const genericPoi
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = orient3d_indirect_IIEE_bigfloat(p1, p2, p3x, p3y, p3z, p4x, p4y, p4z);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = orient3d_indirect_IIEE_bigfloat(p1, p2, p3x, p3y, p3z, p4x, p4y, p4z); }
 #endif
 
  if (l1x_p != l1x) FreeDoubles(l1x);
@@ -10192,8 +10330,11 @@ inline int orient3d_indirect_IIEE_exact(const genericPoint& p1, const genericPoi
 inline int orient3d_indirect_IIEE(const genericPoint& p1, const genericPoint& p2, double p3x, double p3y, double p3z, double p4x, double p4y, double p4z)
 {
    int ret;
+   IP_STATS_PREDICATE(orient3d_indirect_IIEE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = orient3d_indirect_IIEE_interval(p1, p2, p3x, p3y, p3z, p4x, p4y, p4z);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return orient3d_indirect_IIEE_exact(p1, p2, p3x, p3y, p3z, p4x, p4y, p4z);
 }
 
@@ -10401,7 +10542,7 @@ inline int orient3d_indirect_IIIE_exact(const genericPoint& p1, const genericPoi
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = orient3d_indirect_IIIE_bigfloat(p1, p2, p3, p4x, p4y, p4z);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = orient3d_indirect_IIIE_bigfloat(p1, p2, p3, p4x, p4y, p4z); }
 #endif
 
  if (l1x_p != l1x) FreeDoubles(l1x);
@@ -10426,8 +10567,11 @@ inline int orient3d_indirect_IIIE_exact(const genericPoint& p1, const genericPoi
 inline int orient3d_indirect_IIIE(const genericPoint& p1, const genericPoint& p2, const genericPoint& p3, double p4x, double p4y, double p4z)
 {
    int ret;
+   IP_STATS_PREDICATE(orient3d_indirect_IIIE);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = orient3d_indirect_IIIE_interval(p1, p2, p3, p4x, p4y, p4z);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return orient3d_indirect_IIIE_exact(p1, p2, p3, p4x, p4y, p4z);
 }
 
@@ -10683,7 +10827,7 @@ inline int orient3d_indirect_IIII_exact(const genericPoint& p1, const genericPoi
  }
 
 #if defined(CHECK_FOR_XYZERFLOWS) &&  defined(FE_UNDERFLOW) &&  defined(FE_OVERFLOW)
-   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) return_value = orient3d_indirect_IIII_bigfloat(p1, p2, p3, p4);
+   if (fetestexcept(FE_UNDERFLOW | FE_OVERFLOW)) { IP_STATS_BIGFLOAT(); return_value = orient3d_indirect_IIII_bigfloat(p1, p2, p3, p4); }
 #endif
 
  if (l1x_p != l1x) FreeDoubles(l1x);
@@ -10712,8 +10856,11 @@ inline int orient3d_indirect_IIII_exact(const genericPoint& p1, const genericPoi
 inline int orient3d_indirect_IIII(const genericPoint& p1, const genericPoint& p2, const genericPoint& p3, const genericPoint& p4)
 {
    int ret;
+   IP_STATS_PREDICATE(orient3d_indirect_IIII);
+   IP_STATS_STAGE(STAGE_INTERVAL);
    ret = orient3d_indirect_IIII_interval(p1, p2, p3, p4);
    if (ret != Filtered_Sign::UNCERTAIN) return ret;
+   IP_STATS_STAGE(STAGE_EXACT);
    return orient3d_indirect_IIII_exact(p1, p2, p3, p4);
 }
 
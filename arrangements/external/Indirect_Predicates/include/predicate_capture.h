@@ -0,0 +1,192 @@
+/****************************************************************************
+* Indirect predicates for geometric constructions					        *
+*                                                                           *
+* Capture of the predicate arguments: while a capture is running, every     *
+* call to genericPoint::orient3D, orient2Dxy/yz/zx and lessThan is appended *
+* to a binary file together with its result, so that the exact argument     *
+* distribution of a real run can be replayed in isolation later on.         *
+*                                                                           *
+* The capture is compiled in only when ENABLE_PREDICATE_CAPTURE is nonzero. *
+* Otherwise the IP_CAPTURE macro used by the predicates expands to nothing  *
+* and start() always fails.                                                 *
+*                                                                           *
+* File layout (native endianness):                                          *
+*   char magic[8] = "IPCAPT01"                                              *
+*   records, each one made of                                               *
+*     uint8  predicate (Predicate below)                                    *
+*     int8   result                                                         *
+*     for each of the numArgs(predicate) arguments                          *
+*       uint8  point type (Point_Type)                                      *
+*       double coordinates of the explicit points that define the point:    *
+*              EXPLICIT3D: x y z                                            *
+*              LPI:        p q r s t            (15 doubles)                *
+*              TPI:        v1 v2 v3 w1 w2 w3 u1 u2 u3 (27 doubles)          *
+*              LNC:        p q, then the parameter t (7 doubles)            *
+****************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+#ifndef ENABLE_PREDICATE_CAPTURE
+#define ENABLE_PREDICATE_CAPTURE 0
+#endif
+
+namespace predicate_capture {
+
+enum Predicate : uint8_t { ORIENT3D, ORIENT2DXY, ORIENT2DYZ, ORIENT2DZX, LESSTHAN, NUM_PREDICATES };
+
+static constexpr char MAGIC[8] = { 'I', 'P', 'C', 'A', 'P', 'T', '0', '1' };
+
+inline uint32_t numArgs(Predicate p) { return p == ORIENT3D ? 4 : (p == LESSTHAN ? 2 : 3); }
+
+// number of doubles stored for a point of the given type, 0 if the type cannot be captured
+inline uint32_t numCoords(uint8_t point_type)
+{
+	switch (point_type)
+	{
+	case EXPLICIT3D: return 3;
+	case LPI:        return 15;
+	case TPI:        return 27;
+	case LNC:        return 7;
+	default:         return 0;
+	}
+}
+
+// starts appending the calls to the file at path, up to max_records of them (0 = no limit).
+// Returns false if the capture is not compiled in, a capture is already running or the file cannot be created
+inline bool start(const char* path, uint64_t max_records = 0);
+
+// stops the capture, closes the file and returns the number of records written
+inline uint64_t stop();
+
+} // namespace predicate_capture
+
+#if ENABLE_PREDICATE_CAPTURE
+
+#include <atomic>
+#include <mutex>
+#include <stdio.h>
+
+namespace predicate_capture {
+
+struct State
+{
+	std::mutex mutex;
+	FILE* file = nullptr;
+	uint64_t num_records = 0, max_records = 0;
+	std::atomic<bool> active{false};
+};
+
+inline State& state()
+{
+	static State s;
+	return s;
+}
+
+inline bool start(const char* path, uint64_t max_records)
+{
+	State& s = state();
+	std::lock_guard<std::mutex> lock(s.mutex);
+	if (s.file) return false;
+	s.file = fopen(path, "wb");
+	if (!s.file) return false;
+	setvbuf(s.file, nullptr, _IOFBF, 1 << 20);
+	fwrite(MAGIC, 1, sizeof(MAGIC), s.file);
+	s.num_records = 0;
+	s.max_records = max_records;
+	s.active.store(true, std::memory_order_release);
+	return true;
+}
+
+inline uint64_t stop()
+{
+	State& s = state();
+	std::lock_guard<std::mutex> lock(s.mutex);
+	s.active.store(false, std::memory_order_release);
+	if (s.file) fclose(s.file);
+	s.file = nullptr;
+	return s.num_records;
+}
+
+inline void writePoint(FILE* f, const genericPoint& p)
+{
+	const uint8_t type = (uint8_t)p.getType();
+	double c[27];
+	uint32_t n = 0;
+	auto put = [&](const explicitPoint3D& e) { c[n++] = e.X(); c[n++] = e.Y(); c[n++] = e.Z(); };
+
+	if (p.isExplicit3D()) put(p.toExplicit3D());
+	else if (p.isLPI())
+	{
+		const implicitPoint3D_LPI& l = p.toLPI();
+		put(l.P()); put(l.Q()); put(l.R()); put(l.S()); put(l.T());
+	}
+	else if (p.isTPI())
+	{
+		const implicitPoint3D_TPI& t = p.toTPI();
+		put(t.V1()); put(t.V2()); put(t.V3()); put(t.W1()); put(t.W2()); put(t.W3()); put(t.U1()); put(t.U2()); put(t.U3());
+	}
+	else if (p.isLNC())
+	{
+		const implicitPoint3D_LNC& l = p.toLNC();
+		put(l.P()); put(l.Q()); c[n++] = l.T();
+	}
+
+	fwrite(&type, 1, 1, f);
+	fwrite(c, sizeof(double), n, f);
+}
+
+template<typename... Points>
+inline int record(Predicate predicate, int result, const Points&... points)
+{
+	State& s = state();
+	std::lock_guard<std::mutex> lock(s.mutex);
+	if (!s.file) return result;
+	if (s.max_records && s.num_records == s.max_records) { s.active.store(false, std::memory_order_relaxed); return result; }
+
+	const uint8_t p = predicate;
+	const int8_t r = (int8_t)result;
+	fwrite(&p, 1, 1, s.file);
+	fwrite(&r, 1, 1, s.file);
+	(writePoint(s.file, points), ...);
+	s.num_records++;
+	return result;
+}
+
+// true only for the outermost predicate call of a running capture: the captured predicate calls itself again
+// to get the result, and that inner call must not be recorded twice
+class Reentry
+{
+public:
+	Reentry() : outer(state().active.load(std::memory_order_relaxed) && !inside()) { if (outer) inside() = true; }
+	~Reentry() { if (outer) inside() = false; }
+
+	bool outermost() const { return outer; }
+
+private:
+	bool outer;
+
+	static bool& inside()
+	{
+		thread_local bool b = false;
+		return b;
+	}
+};
+
+} // namespace predicate_capture
+
+#define IP_CAPTURE(predicate, call, ...) \
+	if (predicate_capture::Reentry ip_capture_reentry; ip_capture_reentry.outermost()) \
+		return predicate_capture::record(predicate_capture::predicate, call, __VA_ARGS__)
+
+#else // ENABLE_PREDICATE_CAPTURE
+
+namespace predicate_capture {
+inline bool start(const char*, uint64_t) { return false; }
+inline uint64_t stop() { return 0; }
+} // namespace predicate_capture
+
+#define IP_CAPTURE(predicate, call, ...)
+
+#endif // ENABLE_PREDICATE_CAPTURE
@@ -0,0 +1,245 @@
+/****************************************************************************
+* Indirect predicates for geometric constructions					        *
+*                                                                           *
+* Per-predicate statistics: how many times each predicate is called and     *
+* how many of the calls reach the interval, exact (expansion) and bigfloat  *
+* stages, together with the time spent in the predicate and in its exact    *
+* stage.                                                                    *
+*                                                                           *
+* The counters are compiled in only when ENABLE_PREDICATE_STATS is nonzero. *
+* Otherwise the IP_STATS_* macros used by the predicates expand to nothing  *
+* and collect() returns an empty list.                                      *
+*                                                                           *
+* Each thread counts in its own table, so the predicates never share cache  *
+* lines or take locks. collect() sums the tables of the running threads and *
+* the totals left by the threads that have already exited.                  *
+****************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#ifndef ENABLE_PREDICATE_STATS
+#define ENABLE_PREDICATE_STATS 0
+#endif
+
+namespace predicate_stats {
+
+struct PredicateStats
+{
+	const char* name;   // static string, valid for the whole program lifetime
+	uint64_t calls;     // calls to the predicate (i.e. semi-static filter hits, if the predicate has one)
+	uint64_t interval;  // calls that reached the interval arithmetic stage
+	uint64_t exact;     // calls that reached the floating point expansion stage
+	uint64_t bigfloat;  // calls that fell back to bigfloat because of an underflow/overflow
+	uint64_t total_ns;  // time spent in the predicate
+	uint64_t exact_ns;  // time spent in the exact and bigfloat stages
+};
+
+// statistics of all the predicates called at least once since the last reset()
+inline std::vector<PredicateStats> collect();
+
+// clears all the counters. Not synchronized with the predicates running on other threads
+inline void reset();
+
+} // namespace predicate_stats
+
+#if ENABLE_PREDICATE_STATS
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace predicate_stats {
+
+enum Stage { STAGE_INTERVAL, STAGE_EXACT, STAGE_BIGFLOAT };
+
+static constexpr uint32_t MAX_PREDICATES = 256;
+
+// counters of one predicate in one thread. Only the owner thread writes them, so the relaxed load + store
+// pairs in bump() are enough: atomics are only needed to read them safely from collect()
+struct Counters
+{
+	std::atomic<uint64_t> calls{0}, interval{0}, exact{0}, bigfloat{0}, total_ns{0}, exact_ns{0};
+};
+
+inline void bump(std::atomic<uint64_t>& c, uint64_t v = 1)
+{
+	c.store(c.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+}
+
+struct ThreadTable
+{
+	Counters c[MAX_PREDICATES];
+
+	inline ThreadTable();
+	inline ~ThreadTable();
+};
+
+struct Registry
+{
+	std::mutex mutex;
+	const char* names[MAX_PREDICATES] = {};
+	std::atomic<uint32_t> num_predicates{0};
+	std::vector<ThreadTable*> live_tables;
+	std::vector<PredicateStats> retired; // totals of the exited threads, indexed by predicate id
+
+	Registry() : retired(MAX_PREDICATES, PredicateStats{}) {}
+};
+
+inline Registry& registry()
+{
+	static Registry r;
+	return r;
+}
+
+inline ThreadTable& threadTable()
+{
+	thread_local ThreadTable t;
+	return t;
+}
+
+inline ThreadTable::ThreadTable()
+{
+	Registry& r = registry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+	r.live_tables.push_back(this);
+}
+
+inline ThreadTable::~ThreadTable()
+{
+	Registry& r = registry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+	for (uint32_t i = 0; i < MAX_PREDICATES; i++)
+	{
+		r.retired[i].calls += c[i].calls.load(std::memory_order_relaxed);
+		r.retired[i].interval += c[i].interval.load(std::memory_order_relaxed);
+		r.retired[i].exact += c[i].exact.load(std::memory_order_relaxed);
+		r.retired[i].bigfloat += c[i].bigfloat.load(std::memory_order_relaxed);
+		r.retired[i].total_ns += c[i].total_ns.load(std::memory_order_relaxed);
+		r.retired[i].exact_ns += c[i].exact_ns.load(std::memory_order_relaxed);
+	}
+	r.live_tables.erase(std::find(r.live_tables.begin(), r.live_tables.end(), this));
+}
+
+// called once per predicate, through the function-local static in IP_STATS_PREDICATE
+inline uint32_t registerPredicate(const char* name)
+{
+	Registry& r = registry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+	uint32_t id = r.num_predicates.load(std::memory_order_relaxed);
+	if (id == MAX_PREDICATES) { fprintf(stderr, "predicate_stats: too many predicates\n"); exit(1); }
+	r.names[id] = name;
+	r.num_predicates.store(id + 1, std::memory_order_release);
+	return id;
+}
+
+// lives for the duration of a predicate call: counts the call, the stages it reaches and its time
+class Scope
+{
+public:
+	explicit Scope(uint32_t id) : c(threadTable().c[id]), prev(current()), start(now())
+	{
+		bump(c.calls);
+		current() = this;
+	}
+
+	~Scope()
+	{
+		uint64_t end = now();
+		bump(c.total_ns, end - start);
+		if (exact_start) bump(c.exact_ns, end - exact_start);
+		current() = prev;
+	}
+
+	void reached(Stage s)
+	{
+		switch (s)
+		{
+		case STAGE_INTERVAL: bump(c.interval); break;
+		case STAGE_EXACT:    bump(c.exact); exact_start = now(); break;
+		case STAGE_BIGFLOAT: bump(c.bigfloat); break;
+		}
+	}
+
+	// the bigfloat fallback is taken inside the _exact functions, which do not see the Scope of the dispatcher
+	static void reachedBigfloat()
+	{
+		if (current()) current()->reached(STAGE_BIGFLOAT);
+	}
+
+private:
+	Counters& c;
+	Scope* prev;
+	uint64_t start, exact_start = 0;
+
+	static Scope*& current()
+	{
+		thread_local Scope* s = nullptr;
+		return s;
+	}
+
+	static uint64_t now()
+	{
+		return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+};
+
+inline std::vector<PredicateStats> collect()
+{
+	Registry& r = registry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+
+	std::vector<PredicateStats> stats;
+	for (uint32_t i = 0; i < r.num_predicates.load(std::memory_order_acquire); i++)
+	{
+		PredicateStats s = r.retired[i];
+		s.name = r.names[i];
+		for (const ThreadTable* t : r.live_tables)
+		{
+			s.calls += t->c[i].calls.load(std::memory_order_relaxed);
+			s.interval += t->c[i].interval.load(std::memory_order_relaxed);
+			s.exact += t->c[i].exact.load(std::memory_order_relaxed);
+			s.bigfloat += t->c[i].bigfloat.load(std::memory_order_relaxed);
+			s.total_ns += t->c[i].total_ns.load(std::memory_order_relaxed);
+			s.exact_ns += t->c[i].exact_ns.load(std::memory_order_relaxed);
+		}
+		if (s.calls) stats.push_back(s);
+	}
+	return stats;
+}
+
+inline void reset()
+{
+	Registry& r = registry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+
+	std::fill(r.retired.begin(), r.retired.end(), PredicateStats{});
+	for (ThreadTable* t : r.live_tables)
+		for (Counters& c : t->c)
+			c.calls = c.interval = c.exact = c.bigfloat = c.total_ns = c.exact_ns = 0;
+}
+
+} // namespace predicate_stats
+
+#define IP_STATS_PREDICATE(name) static const uint32_t ip_stats_id = predicate_stats::registerPredicate(#name); \
+                                 predicate_stats::Scope ip_stats_scope(ip_stats_id)
+#define IP_STATS_STAGE(stage)    ip_stats_scope.reached(predicate_stats::stage)
+#define IP_STATS_BIGFLOAT()      predicate_stats::Scope::reachedBigfloat()
+
+#else // ENABLE_PREDICATE_STATS
+
+namespace predicate_stats {
+inline std::vector<PredicateStats> collect() { return {}; }
+inline void reset() {}
+} // namespace predicate_stats
+
+#define IP_STATS_PREDICATE(name)
+#define IP_STATS_STAGE(stage)
+#define IP_STATS_BIGFLOAT()
+
+#endif // ENABLE_PREDICATE_STATS
@@ -0,0 +1,607 @@
+#include <cmb.h>
+
+#ifdef _MSC_VER // Workaround for known bugs and issues on MSVC
+    #define _HAS_STD_BYTE 0  // https://developercommunity.visualstudio.com/t/error-c2872-byte-ambiguous-symbol/93889
+    #define NOMINMAX // https://stackoverflow.com/questions/1825904/error-c2589-on-stdnumeric-limitsdoublemin
+#endif
+#include "io_functions.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#ifdef _WIN32
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+// cmb_bench: runs the boolean scenarios below on the meshes in data/ and writes one record per run, as JSON or CSV.
+//  - pairs:     every operation on each pair of bunny/cow/cactus, at 25k, 50k and 100k triangles
+//  - spheres:   union of the first N meshes in data/spheres, N = 2, 4, ..., 128
+//  - cylinders: cmb_boolean_substract_mesh_cylinders on bunny25k with 1, 2, 4, ..., 32 cylinders, then all of them
+//               through cmb_boolean_subtract_primitives, tessellated within a tolerance of 1e-1, 1e-2, 1e-3 of the radius
+//  - toolpath:  cmb_boolean_subtract_toolpath on bunny25k, a ball end tool along a zigzag pocket of 1, 2, 4, ..., 16
+//               overlapping rows, each one sampled at 100 points as CAM software outputs it
+//  - resolve:   cmb_resolve_self_intersections on bunny and cow merged into one mesh, at 25k, 50k and 100k triangles
+//  - coplanar:  a box drilled 1, 2, 4 and 8 times, one drill after the other, without and with cmb_Options::mergeCoplanar.
+//               The differences between the two results go to stderr
+//  - repeat:    the same operation called several times, one record per call, to expose warm-cache effects
+//  - batch:     unions of disjoint pairs of the meshes in data/spheres, one cmb_boolean call after the other and then
+//               through cmb_boolean_batch with 1, 2, 4, ... threads, up to the hardware threads
+//  - snap:      every operation on each pair of the 25k meshes, without and with the input snapped to a lattice of
+//               --snap-bits bits (cmb_Options::snapBits). The differences between the two results go to stderr
+
+struct Mesh {
+    std::vector<float> positions;
+    std::vector<uint32_t> indices;
+
+    cmb_InputMesh input() { return { uint32_t(positions.size() / 3), uint32_t(indices.size() / 3), positions.data(), indices.data() }; }
+};
+
+struct Record {
+    std::string scenario;
+    std::string name;
+    std::string op;
+    uint32_t iteration = 0;
+    uint64_t inTriangles = 0;
+    uint64_t outTriangles = 0;
+    double seconds = 0;
+    double stageSeconds[CMB_STAGE_COUNT] = {};
+    uint64_t peakRssBytes = 0;
+    uint32_t snapBits = 0;
+    double volume = 0; // enclosed by the output mesh
+};
+
+struct Options {
+    std::string dataDir = "data";
+    std::string outFile;
+    std::string format = "json";
+    std::vector<std::string> scenarios = { "pairs", "spheres", "cylinders", "repeat" };
+    uint32_t repeat = 10;
+    uint32_t snapBits = 26;
+    bool quick = false;
+};
+
+static const char* stageNames[CMB_STAGE_COUNT] = {
+    "vertex_merge", "degenerate_removal", "triangle_soup", "broad_phase", "classification", "triangulation",
+    "mesh_build", "patches", "inside_out", "op_selection", "final_extraction", "result_packing" };
+
+static const char* opNames[] = { "union", "intersection", "subtraction", "xor" };
+
+static uint64_t peakRssBytes()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return pmc.PeakWorkingSetSize;
+    return 0;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    #ifdef __APPLE__
+        return uint64_t(usage.ru_maxrss); // bytes
+    #else
+        return uint64_t(usage.ru_maxrss) * 1024; // kilobytes
+    #endif
+#endif
+}
+
+static bool loadMesh(const std::string& path, Mesh& mesh)
+{
+    if (!std::filesystem::exists(path)) return false;
+
+    std::vector<double> positions;
+    std::vector<uint> indices;
+    std::vector<uint> labels;
+    loadMultipleFiles({ path }, positions, indices, labels);
+
+    mesh.positions.assign(positions.begin(), positions.end());
+    mesh.indices.assign(indices.begin(), indices.end());
+    return true;
+}
+
+// copies a result so that it can be used as the input of another operation. The results are returned with the
+// opposite winding with respect to the inputs, so the triangles are flipped back
+static Mesh resultToMesh(cmb_Result* result)
+{
+    Mesh mesh;
+    const float* positions = cmb_positions(result);
+    const uint32_t* indices = cmb_indices(result);
+    mesh.positions.assign(positions, positions + 3 * cmb_numVertices(result));
+    mesh.indices.assign(indices, indices + 3 * cmb_numTriangles(result));
+    for (size_t i = 0; i < mesh.indices.size(); i += 3)
+        std::swap(mesh.indices[i + 1], mesh.indices[i + 2]);
+    return mesh;
+}
+
+// the results are returned with the opposite winding with respect to the inputs, hence the minus sign
+static double enclosedVolume(cmb_Result* result)
+{
+    const float* p = cmb_positions(result);
+    const uint32_t* t = cmb_indices(result);
+    double volume = 0;
+    for (uint32_t i = 0; i < cmb_numTriangles(result); i++) {
+        const float *a = p + 3 * t[3 * i], *b = p + 3 * t[3 * i + 1], *c = p + 3 * t[3 * i + 2];
+        volume -= (double(a[0]) * (double(b[1]) * c[2] - double(b[2]) * c[1]) +
+                   double(a[1]) * (double(b[2]) * c[0] - double(b[0]) * c[2]) +
+                   double(a[2]) * (double(b[0]) * c[1] - double(b[1]) * c[0])) / 6.0;
+    }
+    return volume;
+}
+
+// runs fn, which returns a result, and fills the time, output size, stage times and memory of the record
+template<typename Fn>
+static void measure(Record& record, const Fn& fn, Mesh* output = nullptr)
+{
+    auto start = std::chrono::steady_clock::now();
+    cmb_Result* result = fn();
+    record.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const cmb_Stats* stats = cmb_stats(result);
+    for (uint32_t s = 0; s < CMB_STAGE_COUNT; s++)
+        record.stageSeconds[s] += stats->stages[s].seconds;
+    record.outTriangles = cmb_numTriangles(result);
+    record.volume = enclosedVolume(result);
+
+    if (output) *output = resultToMesh(result);
+    cmb_release(result);
+
+    record.peakRssBytes = peakRssBytes();
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+static void benchPairs(const Options& opt, std::vector<Record>& records)
+{
+    const std::vector<std::string> models = { "bunny", "cow", "cactus" };
+    const std::vector<std::string> resolutions = opt.quick ? std::vector<std::string>{ "25k" } : std::vector<std::string>{ "25k", "50k", "100k" };
+
+    for (const std::string& res : resolutions) {
+        std::vector<Mesh> meshes(models.size());
+        std::vector<bool> found(models.size());
+        for (size_t m = 0; m < models.size(); m++) {
+            std::string path = opt.dataDir + "/" + models[m] + res + ".obj";
+            std::string upperPath = opt.dataDir + "/" + models[m] + res.substr(0, res.size() - 1) + "K.obj"; // e.g. cow100K.obj
+            found[m] = loadMesh(path, meshes[m]) || loadMesh(upperPath, meshes[m]);
+        }
+
+        for (size_t a = 0; a < models.size(); a++)
+            for (size_t b = a + 1; b < models.size(); b++) {
+                if (!found[a] || !found[b]) continue;
+                for (uint32_t op = CMB_UNION; op <= CMB_XOR; op++) {
+                    Record record;
+                    record.scenario = "pairs";
+                    record.name = models[a] + res + "-" + models[b] + res;
+                    record.op = opNames[op];
+                    record.inTriangles = meshes[a].indices.size() / 3 + meshes[b].indices.size() / 3;
+                    measure(record, [&] { return cmb_boolean(cmb_BooleanType(op), meshes[a].input(), meshes[b].input()); });
+                    records.push_back(record);
+                }
+            }
+    }
+}
+
+static void benchSpheres(const Options& opt, std::vector<Record>& records)
+{
+    const uint32_t maxSpheres = opt.quick ? 16 : 128;
+
+    std::vector<Mesh> spheres;
+    for (uint32_t i = 0; i < maxSpheres; i++) {
+        Mesh sphere;
+        if (!loadMesh(opt.dataDir + "/spheres/" + std::to_string(i) + ".obj", sphere)) break;
+        spheres.push_back(std::move(sphere));
+    }
+
+    for (uint32_t n = 2; n <= spheres.size(); n *= 2) {
+        Record record;
+        record.scenario = "spheres";
+        record.name = std::to_string(n) + "_spheres";
+        record.op = "union";
+
+        Mesh acc = spheres[0];
+        record.inTriangles = acc.indices.size() / 3;
+        for (uint32_t i = 1; i < n; i++) {
+            record.inTriangles += spheres[i].indices.size() / 3;
+            measure(record, [&] { return cmb_boolean(CMB_UNION, acc.input(), spheres[i].input()); }, &acc);
+        }
+        records.push_back(record);
+    }
+}
+
+static void benchCylinders(const Options& opt, std::vector<Record>& records)
+{
+    Mesh mesh;
+    if (!loadMesh(opt.dataDir + "/bunny25k.obj", mesh)) return;
+
+    float bbMin[3] = { FLT_MAX, FLT_MAX, FLT_MAX }, bbMax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (size_t i = 0; i < mesh.positions.size(); i++) {
+        bbMin[i % 3] = std::min(bbMin[i % 3], mesh.positions[i]);
+        bbMax[i % 3] = std::max(bbMax[i % 3], mesh.positions[i]);
+    }
+    const float diag = std::sqrt((bbMax[0] - bbMin[0]) * (bbMax[0] - bbMin[0]) + (bbMax[1] - bbMin[1]) * (bbMax[1] - bbMin[1]) +
+                                 (bbMax[2] - bbMin[2]) * (bbMax[2] - bbMin[2]));
+
+    // the same pseudo random drills for every run, so that the runs are comparable across releases. The drills are
+    // parallel to Y and placed on a jittered 16x16 grid over the central part of the box, so that they never touch
+    // each other: crossing drills produce fully implicit patches, which make the library give up. Beyond 32 drills the
+    // chained subtractions hit the same limit
+    const uint32_t grid = 16;
+    const uint32_t maxCylinders = opt.quick ? 16 : 32;
+    const float cellX = 0.6f * (bbMax[0] - bbMin[0]) / grid, cellZ = 0.6f * (bbMax[2] - bbMin[2]) / grid;
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    std::vector<cmb_CylinderInfo> cylinders(grid * grid);
+    for (uint32_t i = 0; i < grid * grid; i++) {
+        cmb_CylinderInfo& c = cylinders[i];
+        c.radius = std::min(cellX, cellZ) * (0.15f + 0.2f * unit(rng));
+        c.posX = bbMin[0] + 0.2f * (bbMax[0] - bbMin[0]) + cellX * ((i % grid) + 0.5f + 0.3f * (unit(rng) - 0.5f));
+        c.posY = 0.5f * (bbMin[1] + bbMax[1]);
+        c.posZ = bbMin[2] + 0.2f * (bbMax[2] - bbMin[2]) + cellZ * ((i / grid) + 0.5f + 0.3f * (unit(rng) - 0.5f));
+        c.dirX = 0; c.dirY = 1; c.dirZ = 0;
+        c.halfHeight = diag;
+    }
+    std::shuffle(cylinders.begin(), cylinders.end(), rng); // the first n drills are spread over the whole grid
+
+    for (uint32_t n = 1; n <= maxCylinders; n *= 2) {
+        Record record;
+        record.scenario = "cylinders";
+        record.name = "bunny25k-" + std::to_string(n) + "_cylinders";
+        record.op = "subtraction";
+        record.inTriangles = mesh.indices.size() / 3;
+        measure(record, [&] { return cmb_boolean_substract_mesh_cylinders(mesh.input(), n, cylinders.data()); });
+        records.push_back(record);
+    }
+
+    for (float tolerance : { 1e-1f, 1e-2f, 1e-3f }) {
+        std::vector<cmb_Primitive> primitives(maxCylinders);
+        for (uint32_t i = 0; i < maxCylinders; i++) {
+            const cmb_CylinderInfo& c = cylinders[i];
+            cmb_Primitive& p = primitives[i];
+            p = {};
+            p.type = CMB_PRIMITIVE_CYLINDER;
+            p.posX = c.posX; p.posY = c.posY; p.posZ = c.posZ;
+            p.dirX = c.dirX; p.dirY = c.dirY; p.dirZ = c.dirZ;
+            p.radius = c.radius;
+            p.halfHeight = c.halfHeight;
+            p.tolerance = tolerance * c.radius;
+        }
+
+        Record record;
+        record.scenario = "cylinders";
+        std::ostringstream name;
+        name << "bunny25k-" << maxCylinders << "_cylinders-tol" << tolerance;
+        record.name = name.str();
+        record.op = "subtraction";
+        record.inTriangles = mesh.indices.size() / 3;
+        measure(record, [&] { return cmb_boolean_subtract_primitives(mesh.input(), maxCylinders, primitives.data(), nullptr); });
+        records.push_back(record);
+    }
+}
+
+static void benchToolpath(const Options& opt, std::vector<Record>& records)
+{
+    Mesh mesh;
+    if (!loadMesh(opt.dataDir + "/bunny25k.obj", mesh)) return;
+
+    float bbMin[3] = { FLT_MAX, FLT_MAX, FLT_MAX }, bbMax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (size_t i = 0; i < mesh.positions.size(); i++) {
+        bbMin[i % 3] = std::min(bbMin[i % 3], mesh.positions[i]);
+        bbMax[i % 3] = std::max(bbMax[i % 3], mesh.positions[i]);
+    }
+
+    // rows along X over the central part of the box, 1.5 radii apart, at 70% of its height along Z
+    const uint32_t maxRows = opt.quick ? 4 : 16;
+    const uint32_t samplesPerRow = 100;
+    cmb_Tool tool = {};
+    tool.radius = 0.02f * (bbMax[2] - bbMin[2]);
+    tool.tolerance = 1e-2f * tool.radius;
+    const float x0 = bbMin[0] + 0.2f * (bbMax[0] - bbMin[0]), x1 = bbMax[0] - 0.2f * (bbMax[0] - bbMin[0]);
+    const float y0 = 0.5f * (bbMin[1] + bbMax[1]) - 0.75f * tool.radius * maxRows;
+    const float z = bbMin[2] + 0.7f * (bbMax[2] - bbMin[2]);
+    std::vector<float> points;
+    for (uint32_t row = 0; row < maxRows; row++) {
+        for (uint32_t i = 0; i < samplesPerRow; i++) {
+            const float t = float(i) / (samplesPerRow - 1);
+            points.push_back(row % 2 ? x1 + t * (x0 - x1) : x0 + t * (x1 - x0));
+            points.push_back(y0 + 1.5f * tool.radius * row);
+            points.push_back(z);
+        }
+    }
+
+    for (uint32_t n = 1; n <= maxRows; n *= 2) {
+        Record record;
+        record.scenario = "toolpath";
+        record.name = "bunny25k-" + std::to_string(n) + "_rows";
+        record.op = "subtraction";
+        record.inTriangles = mesh.indices.size() / 3;
+        measure(record, [&] { return cmb_boolean_subtract_toolpath(mesh.input(), n * samplesPerRow, points.data(), &tool, nullptr); });
+        records.push_back(record);
+    }
+}
+
+static void benchResolve(const Options& opt, std::vector<Record>& records)
+{
+    const std::vector<std::string> resolutions = opt.quick ? std::vector<std::string>{ "25k" } : std::vector<std::string>{ "25k", "50k", "100k" };
+
+    for (const std::string& res : resolutions) {
+        Mesh a, b;
+        const std::string upperRes = res.substr(0, res.size() - 1) + "K"; // e.g. cow100K.obj
+        if (!(loadMesh(opt.dataDir + "/bunny" + res + ".obj", a) || loadMesh(opt.dataDir + "/bunny" + upperRes + ".obj", a)) ||
+            !(loadMesh(opt.dataDir + "/cow" + res + ".obj", b) || loadMesh(opt.dataDir + "/cow" + upperRes + ".obj", b)))
+            continue;
+
+        // the two meshes cross each other: as a single mesh, it intersects itself along the same curves as their union
+        Mesh mesh = a;
+        const uint32_t numVerticesA = uint32_t(a.positions.size() / 3);
+        mesh.positions.insert(mesh.positions.end(), b.positions.begin(), b.positions.end());
+        for (uint32_t i : b.indices)
+            mesh.indices.push_back(numVerticesA + i);
+
+        Record record;
+        record.scenario = "resolve";
+        record.name = "bunny" + res + "+cow" + res;
+        record.op = "resolve";
+        record.inTriangles = mesh.indices.size() / 3;
+        measure(record, [&] { return cmb_resolve_self_intersections(mesh.input(), nullptr); });
+        records.push_back(record);
+    }
+}
+
+static void benchCoplanar(const Options& opt, std::vector<Record>& records)
+{
+    Mesh box;
+    box.positions = { -1, -1, -1, 1, -1, -1, 1, 1, -1, -1, 1, -1, -1, -1, 1, 1, -1, 1, 1, 1, 1, -1, 1, 1 };
+    box.indices = { 0, 2, 1, 0, 3, 2, 4, 5, 6, 4, 6, 7, 0, 1, 5, 0, 5, 4, 1, 2, 6, 1, 6, 5, 2, 3, 7, 2, 7, 6, 3, 0, 4, 3, 4, 7 };
+
+    // drills along Y in the back half of the box and along X in the front half, so that they never cross each other
+    const uint32_t maxDrills = opt.quick ? 4 : 8;
+    std::vector<cmb_Primitive> drills(maxDrills);
+    for (uint32_t i = 0; i < maxDrills; i++) {
+        cmb_Primitive& p = drills[i];
+        p = {};
+        p.type = CMB_PRIMITIVE_CYLINDER;
+        const float offset = -0.75f + 0.5f * (i / 2 % 4);
+        if (i % 2 == 0) { p.posX = offset; p.posZ = -0.5f; p.dirY = 1; }
+        else            { p.posY = offset; p.posZ = 0.5f; p.dirX = 1; }
+        p.radius = 0.1f;
+        p.halfHeight = 2;
+        p.tolerance = 1e-2f * p.radius;
+    }
+
+    cmb_Options merged = {};
+    merged.mergeCoplanar = true;
+
+    for (uint32_t n = 1; n <= maxDrills; n *= 2) {
+        Record record[2];
+        for (uint32_t m = 0; m < 2; m++) {
+            record[m].scenario = "coplanar";
+            record[m].name = "box-" + std::to_string(n) + "_drills" + (m ? "-merged" : "");
+            record[m].op = "subtraction";
+            record[m].inTriangles = box.indices.size() / 3;
+
+            // one drill after the other, as an interactive modeller does
+            Mesh acc = box;
+            for (uint32_t i = 0; i < n; i++)
+                measure(record[m], [&] { return cmb_boolean_subtract_primitives(acc.input(), 1, &drills[i], m ? &merged : nullptr); }, &acc);
+            records.push_back(record[m]);
+        }
+        std::cerr << "coplanar " << record[0].name << ": " << record[0].outTriangles << " -> " << record[1].outTriangles
+                  << " triangles, volume difference " << std::abs(record[1].volume - record[0].volume) << ", "
+                  << record[0].seconds << " -> " << record[1].seconds << " s" << std::endl;
+    }
+}
+
+static void benchRepeat(const Options& opt, std::vector<Record>& records)
+{
+    Mesh a, b;
+    if (!loadMesh(opt.dataDir + "/bunny25k.obj", a) || !loadMesh(opt.dataDir + "/cow25k.obj", b)) return;
+
+    for (uint32_t i = 0; i < opt.repeat; i++) {
+        Record record;
+        record.scenario = "repeat";
+        record.name = "bunny25k-cow25k";
+        record.op = "subtraction";
+        record.iteration = i;
+        record.inTriangles = a.indices.size() / 3 + b.indices.size() / 3;
+        measure(record, [&] { return cmb_boolean(CMB_DIFFERENCE, a.input(), b.input()); });
+        records.push_back(record);
+    }
+}
+
+static void benchBatch(const Options& opt, std::vector<Record>& records)
+{
+    const uint32_t maxSpheres = opt.quick ? 32 : 128;
+
+    std::vector<Mesh> spheres;
+    for (uint32_t i = 0; i < maxSpheres; i++) {
+        Mesh sphere;
+        if (!loadMesh(opt.dataDir + "/spheres/" + std::to_string(i) + ".obj", sphere)) break;
+        spheres.push_back(std::move(sphere));
+    }
+
+    std::vector<cmb_BooleanJob> jobs;
+    uint64_t inTriangles = 0;
+    for (uint32_t i = 0; i + 1 < spheres.size(); i += 2) {
+        jobs.push_back({ CMB_UNION, spheres[i].input(), spheres[i + 1].input() });
+        inTriangles += spheres[i].indices.size() / 3 + spheres[i + 1].indices.size() / 3;
+    }
+    if (jobs.empty()) return;
+
+    // numThreads = 0 stands for the sequential cmb_boolean calls
+    const uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<cmb_Result*> results(jobs.size());
+    for (uint32_t numThreads = 0; numThreads <= maxThreads; numThreads = std::max(1u, 2 * numThreads)) {
+        Record record;
+        record.scenario = "batch";
+        record.name = std::to_string(jobs.size()) + "_sphere_pairs-" + (numThreads ? std::to_string(numThreads) + "_threads" : "sequential");
+        record.op = "union";
+        record.inTriangles = inTriangles;
+
+        auto start = std::chrono::steady_clock::now();
+        if (numThreads == 0)
+            for (size_t i = 0; i < jobs.size(); i++)
+                results[i] = cmb_boolean(jobs[i].type, jobs[i].meshA, jobs[i].meshB);
+        else
+            cmb_boolean_batch(jobs.data(), uint32_t(jobs.size()), results.data(), numThreads, nullptr);
+        record.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        for (cmb_Result* result : results) {
+            const cmb_Stats* stats = cmb_stats(result);
+            for (uint32_t s = 0; s < CMB_STAGE_COUNT; s++)
+                record.stageSeconds[s] += stats->stages[s].seconds;
+            record.outTriangles += cmb_numTriangles(result);
+            record.volume += enclosedVolume(result);
+            cmb_release(result);
+        }
+        record.peakRssBytes = peakRssBytes();
+        records.push_back(record);
+    }
+}
+
+static void benchSnap(const Options& opt, std::vector<Record>& records)
+{
+    const std::vector<std::string> models = { "bunny", "cow", "cactus" };
+    std::vector<Mesh> meshes(models.size());
+    std::vector<bool> found(models.size());
+    for (size_t m = 0; m < models.size(); m++)
+        found[m] = loadMesh(opt.dataDir + "/" + models[m] + "25k.obj", meshes[m]);
+
+    cmb_Options snapped = {};
+    snapped.snapBits = opt.snapBits;
+
+    for (size_t a = 0; a < models.size(); a++)
+        for (size_t b = a + 1; b < models.size(); b++) {
+            if (!found[a] || !found[b]) continue;
+            for (uint32_t op = CMB_UNION; op <= CMB_XOR; op++) {
+                Record record[2];
+                for (uint32_t i = 0; i < 2; i++) {
+                    record[i].scenario = "snap";
+                    record[i].name = models[a] + "25k-" + models[b] + "25k";
+                    record[i].op = opNames[op];
+                    record[i].snapBits = i ? opt.snapBits : 0;
+                    record[i].inTriangles = meshes[a].indices.size() / 3 + meshes[b].indices.size() / 3;
+                    measure(record[i], [&] { return cmb_boolean_ex(cmb_BooleanType(op), meshes[a].input(), meshes[b].input(), i ? &snapped : nullptr); });
+                    records.push_back(record[i]);
+                }
+                const double volumeDiff = std::abs(record[1].volume - record[0].volume);
+                std::cerr << "snap " << record[0].name << " " << record[0].op << ": " << record[0].outTriangles << " -> "
+                          << record[1].outTriangles << " triangles, volume difference " << volumeDiff << " ("
+                          << (record[0].volume != 0 ? volumeDiff / std::abs(record[0].volume) : 0.0) << " relative), "
+                          << record[0].seconds << " -> " << record[1].seconds << " s" << std::endl;
+            }
+        }
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+static double trianglesPerSecond(const Record& r)
+{
+    return r.seconds > 0 ? double(r.inTriangles) / r.seconds : 0;
+}
+
+static void writeJSON(std::ostream& os, const std::vector<Record>& records)
+{
+    os << "{\n  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n  \"records\": [\n";
+    for (size_t i = 0; i < records.size(); i++) {
+        const Record& r = records[i];
+        os << "    {\"scenario\": \"" << r.scenario << "\", \"name\": \"" << r.name << "\", \"op\": \"" << r.op << "\""
+           << ", \"iteration\": " << r.iteration << ", \"in_triangles\": " << r.inTriangles << ", \"out_triangles\": " << r.outTriangles
+           << ", \"seconds\": " << r.seconds << ", \"triangles_per_second\": " << trianglesPerSecond(r)
+           << ", \"peak_rss_bytes\": " << r.peakRssBytes << ", \"snap_bits\": " << r.snapBits << ", \"volume\": " << r.volume
+           << ", \"stages\": {";
+        for (uint32_t s = 0; s < CMB_STAGE_COUNT; s++)
+            os << (s ? ", " : "") << "\"" << stageNames[s] << "\": " << r.stageSeconds[s];
+        os << "}}" << (i + 1 < records.size() ? "," : "") << "\n";
+    }
+    os << "  ]\n}\n";
+}
+
+static void writeCSV(std::ostream& os, const std::vector<Record>& records)
+{
+    os << "scenario,name,op,iteration,in_triangles,out_triangles,seconds,triangles_per_second,peak_rss_bytes,snap_bits,volume";
+    for (uint32_t s = 0; s < CMB_STAGE_COUNT; s++)
+        os << "," << stageNames[s];
+    os << "\n";
+
+    for (const Record& r : records) {
+        os << r.scenario << "," << r.name << "," << r.op << "," << r.iteration << "," << r.inTriangles << "," << r.outTriangles << ","
+           << r.seconds << "," << trianglesPerSecond(r) << "," << r.peakRssBytes << "," << r.snapBits << "," << r.volume;
+        for (uint32_t s = 0; s < CMB_STAGE_COUNT; s++)
+            os << "," << r.stageSeconds[s];
+        os << "\n";
+    }
+}
+
+static std::vector<std::string> splitCommas(const std::string& s)
+{
+    std::vector<std::string> items;
+    std::stringstream ss(s);
+    for (std::string item; std::getline(ss, item, ',');)
+        if (!item.empty()) items.push_back(item);
+    return items;
+}
+
+int main(int argc, char **argv)
+{
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--data" && hasValue)            opt.dataDir = argv[++i];
+        else if (arg == "--out" && hasValue)        opt.outFile = argv[++i];
+        else if (arg == "--format" && hasValue)     opt.format = argv[++i];
+        else if (arg == "--scenarios" && hasValue)  opt.scenarios = splitCommas(argv[++i]);
+        else if (arg == "--repeat" && hasValue)     opt.repeat = uint32_t(std::stoul(argv[++i]));
+        else if (arg == "--snap-bits" && hasValue)  opt.snapBits = uint32_t(std::stoul(argv[++i]));
+        else if (arg == "--quick")                  opt.quick = true;
+        else {
+            std::cout << "usage: ./cmb_bench [--data DIR] [--out FILE|-] [--format json|csv] [--scenarios pairs,spheres,cylinders,toolpath,resolve,coplanar,repeat,batch,snap]"
+                         " [--repeat N] [--snap-bits N] [--quick]" << std::endl;
+            return -1;
+        }
+    }
+    if (opt.snapBits < 2 || opt.snapBits > 31) {
+        printf("Invalid snap bits %u\n", opt.snapBits);
+        return -1;
+    }
+    if (opt.format != "json" && opt.format != "csv") {
+        printf("Invalid format %s\n", opt.format.c_str());
+        return -1;
+    }
+    // the library and the loaders print warnings on stdout, so the records go to a file unless "--out -" is given
+    if (opt.outFile.empty()) opt.outFile = "cmb_bench." + opt.format;
+
+    std::vector<Record> records;
+    for (const std::string& scenario : opt.scenarios) {
+        size_t first = records.size();
+        if (scenario == "pairs")            benchPairs(opt, records);
+        else if (scenario == "spheres")     benchSpheres(opt, records);
+        else if (scenario == "cylinders")   benchCylinders(opt, records);
+        else if (scenario == "toolpath")    benchToolpath(opt, records);
+        else if (scenario == "resolve")     benchResolve(opt, records);
+        else if (scenario == "coplanar")    benchCoplanar(opt, records);
+        else if (scenario == "repeat")      benchRepeat(opt, records);
+        else if (scenario == "batch")       benchBatch(opt, records);
+        else if (scenario == "snap")        benchSnap(opt, records);
+        else {
+            printf("Invalid scenario %s\n", scenario.c_str());
+            return -1;
+        }
+        if (records.size() == first)
+            std::cerr << "scenario " << scenario << ": no input meshes found in " << opt.dataDir << std::endl;
+    }
+
+    std::ofstream file;
+    if (opt.outFile != "-") file.open(opt.outFile);
+    std::ostream& os = opt.outFile == "-" ? std::cout : file;
+    os.precision(9);
+
+    if (opt.format == "json") writeJSON(os, records);
+    else                      writeCSV(os, records);
+
+    return 0;
+}
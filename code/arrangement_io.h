@@ -0,0 +1,103 @@
+/*****************************************************************************************
+ *              MIT License                                                              *
+ *                                                                                       *
+ * Copyright (c) 2022 G. Cherchi, F. Pellacini, M. Attene and M. Livesu                  *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION     *
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                *
+ *                                                                                       *
+ * Authors:                                                                              *
+ *      Gianmarco Cherchi (g.cherchi@unica.it)                                           *
+ *      https://www.gianmarcocherchi.com                                                 *
+ *                                                                                       *
+ *      Fabio Pellacini (fabio.pellacini@uniroma1.it)                                    *
+ *      https://pellacini.di.uniroma1.it                                                 *
+ *                                                                                       *
+ *      Marco Attene (marco.attene@ge.imati.cnr.it)                                      *
+ *      https://www.cnr.it/en/people/marco.attene/                                       *
+ *                                                                                       *
+ *      Marco Livesu (marco.livesu@ge.imati.cnr.it)                                      *
+ *      http://pers.ge.imati.cnr.it/livesu/                                              *
+ *                                                                                       *
+ * ***************************************************************************************/
+
+#ifndef EXACT_BOOLEANS_ARRANGEMENT_IO_H
+#define EXACT_BOOLEANS_ARRANGEMENT_IO_H
+
+#include "booleans.h"
+
+#include <cstdint>
+#include <string>
+
+/* Binary files of labelled arrangements, to compute an arrangement once and extract the boolean operations
+ * from it later (see extractBooleanOp). A loaded arrangement holds the vertices, the triangles, the labels
+ * and the patches: the input triangles and the octree are only needed to compute the labels and are not stored.
+ *
+ * Layout (native byte order, every section starts at a multiple of 8 bytes from the start of the file, so that
+ * a mapped file can be used in place):
+ *   ArrangementFileHeader
+ *   VERT_TYPES    uint8_t  per vertex, its Point_Type (EXPLICIT3D, LPI or TPI)
+ *   COORDS        double   x y z of each explicit vertex, in vertex order
+ *   IMPLICIT      uint32_t ids of the explicit vertices that define each implicit vertex, in vertex order:
+ *                          p q r s t for an LPI, v1 v2 v3 w1 w2 w3 u1 u2 u3 for a TPI
+ *   TRIS          uint32_t 3 vertex ids per triangle
+ *   SURFACE       uint32_t surface label bits of each triangle
+ *   INSIDE        uint32_t inside label bits of each triangle
+ *   PATCH_OFFSETS uint32_t num_patches + 1 offsets into PATCH_TRIS
+ *   PATCH_TRIS    uint32_t triangle ids of each patch, sorted */
+
+static constexpr char     ARRANGEMENT_FILE_MAGIC[8] = {'C', 'M', 'B', 'A', 'R', 'R', 'N', 'G'};
+static constexpr uint32_t ARRANGEMENT_FILE_VERSION  = 1;
+
+enum ArrangementFileSection
+{
+    SECTION_VERT_TYPES,
+    SECTION_COORDS,
+    SECTION_IMPLICIT,
+    SECTION_TRIS,
+    SECTION_SURFACE,
+    SECTION_INSIDE,
+    SECTION_PATCH_OFFSETS,
+    SECTION_PATCH_TRIS,
+    NUM_ARRANGEMENT_FILE_SECTIONS
+};
+
+struct ArrangementFileHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t num_labels;
+    uint32_t num_verts;
+    uint32_t num_explicit;
+    uint32_t num_implicit_ids;
+    uint32_t num_tris;
+    uint32_t num_patches;
+    uint32_t num_patch_tris;
+    uint64_t section_offset[NUM_ARRANGEMENT_FILE_SECTIONS]; // bytes from the start of the file
+    uint64_t file_size;
+};
+
+// false if the file cannot be written or the arrangement has vertices that cannot be stored
+inline bool saveLabelledArrangement(const std::string &filename, const LabelledArrangement &arr);
+
+// fills an empty arrangement. False if the file cannot be read, is not an arrangement file, has another version
+// or is inconsistent: arr is then left partially filled and must be discarded
+inline bool loadLabelledArrangement(const std::string &filename, LabelledArrangement &arr);
+
+#include "arrangement_io.inl"
+
+#endif // EXACT_BOOLEANS_ARRANGEMENT_IO_H
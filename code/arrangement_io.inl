@@ -0,0 +1,271 @@
+/*****************************************************************************************
+ *              MIT License                                                              *
+ *                                                                                       *
+ * Copyright (c) 2022 G. Cherchi, F. Pellacini, M. Attene and M. Livesu                  *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION     *
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                *
+ *                                                                                       *
+ * Authors:                                                                              *
+ *      Gianmarco Cherchi (g.cherchi@unica.it)                                           *
+ *      https://www.gianmarcocherchi.com                                                 *
+ *                                                                                       *
+ *      Fabio Pellacini (fabio.pellacini@uniroma1.it)                                    *
+ *      https://pellacini.di.uniroma1.it                                                 *
+ *                                                                                       *
+ *      Marco Attene (marco.attene@ge.imati.cnr.it)                                      *
+ *      https://www.cnr.it/en/people/marco.attene/                                       *
+ *                                                                                       *
+ *      Marco Livesu (marco.livesu@ge.imati.cnr.it)                                      *
+ *      http://pers.ge.imati.cnr.it/livesu/                                              *
+ *                                                                                       *
+ * ***************************************************************************************/
+
+#include "arrangement_io.h"
+
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+static_assert(NBIT <= 32, "labels are stored as 32 bit words");
+
+inline uint64_t alignedArrangementOffset(uint64_t offset)
+{
+    return (offset + 7) & ~uint64_t(7);
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline bool saveLabelledArrangement(const std::string &filename, const LabelledArrangement &arr)
+{
+    assert(arr.tm && "arrangement not computed");
+    const StaticTrimesh &tm = *arr.tm;
+
+    // ids of the explicit vertices, to store the implicit ones as tuples of ids
+    phmap::flat_hash_map<const explicitPoint3D*, uint> explicit_ids;
+    for(uint v_id = 0; v_id < tm.numVerts(); v_id++)
+        if(tm.vert(v_id)->isExplicit3D()) explicit_ids[&tm.vert(v_id)->toExplicit3D()] = v_id;
+
+    std::vector<uint8_t> vert_types(tm.numVerts());
+    std::vector<double> coords;
+    std::vector<uint32_t> implicit_ids;
+    bool ok = true;
+    auto id = [&](const explicitPoint3D &p)
+    {
+        auto it = explicit_ids.find(&p);
+        if(it == explicit_ids.end()) { ok = false; return uint32_t(0); }
+        return uint32_t(it->second);
+    };
+
+    for(uint v_id = 0; v_id < tm.numVerts(); v_id++)
+    {
+        const genericPoint *v = tm.vert(v_id);
+        vert_types[v_id] = static_cast<uint8_t>(v->getType());
+
+        if(v->isExplicit3D())
+        {
+            const explicitPoint3D &e = v->toExplicit3D();
+            coords.insert(coords.end(), {e.X(), e.Y(), e.Z()});
+        }
+        else if(v->isLPI())
+        {
+            const implicitPoint3D_LPI &l = v->toLPI();
+            implicit_ids.insert(implicit_ids.end(), {id(l.P()), id(l.Q()), id(l.R()), id(l.S()), id(l.T())});
+        }
+        else if(v->isTPI())
+        {
+            const implicitPoint3D_TPI &t = v->toTPI();
+            implicit_ids.insert(implicit_ids.end(), {id(t.V1()), id(t.V2()), id(t.V3()), id(t.W1()), id(t.W2()), id(t.W3()),
+                                                     id(t.U1()), id(t.U2()), id(t.U3())});
+        }
+        else ok = false; // the arrangement only builds LPIs and TPIs
+    }
+    if(!ok) return false;
+
+    // the flips of the last extraction are not part of the arrangement
+    std::vector<uint32_t> tris(arr.out_tris.begin(), arr.out_tris.end());
+
+    std::vector<uint32_t> surface(tm.numTris()), inside(tm.numTris());
+    for(uint t_id = 0; t_id < tm.numTris(); t_id++)
+    {
+        surface[t_id] = static_cast<uint32_t>(arr.labels.surface[t_id].to_ulong());
+        inside[t_id]  = static_cast<uint32_t>(arr.labels.inside[t_id].to_ulong());
+    }
+
+    std::vector<uint32_t> patch_offsets(1, 0), patch_tris;
+    for(const auto &patch : arr.patches)
+    {
+        size_t first = patch_tris.size();
+        patch_tris.insert(patch_tris.end(), patch.begin(), patch.end());
+        std::sort(patch_tris.begin() + first, patch_tris.end());
+        patch_offsets.push_back(static_cast<uint32_t>(patch_tris.size()));
+    }
+
+    const void *data[NUM_ARRANGEMENT_FILE_SECTIONS] = {vert_types.data(), coords.data(), implicit_ids.data(), tris.data(),
+                                                       surface.data(), inside.data(), patch_offsets.data(), patch_tris.data()};
+    const size_t bytes[NUM_ARRANGEMENT_FILE_SECTIONS] = {vert_types.size(), coords.size() * sizeof(double),
+                                                         implicit_ids.size() * sizeof(uint32_t), tris.size() * sizeof(uint32_t),
+                                                         surface.size() * sizeof(uint32_t), inside.size() * sizeof(uint32_t),
+                                                         patch_offsets.size() * sizeof(uint32_t), patch_tris.size() * sizeof(uint32_t)};
+
+    ArrangementFileHeader header = {};
+    memcpy(header.magic, ARRANGEMENT_FILE_MAGIC, sizeof(header.magic));
+    header.version          = ARRANGEMENT_FILE_VERSION;
+    header.num_labels       = arr.labels.num;
+    header.num_verts        = tm.numVerts();
+    header.num_explicit     = static_cast<uint32_t>(coords.size() / 3);
+    header.num_implicit_ids = static_cast<uint32_t>(implicit_ids.size());
+    header.num_tris         = tm.numTris();
+    header.num_patches      = static_cast<uint32_t>(arr.patches.size());
+    header.num_patch_tris   = static_cast<uint32_t>(patch_tris.size());
+
+    uint64_t offset = alignedArrangementOffset(sizeof(ArrangementFileHeader));
+    for(uint s = 0; s < NUM_ARRANGEMENT_FILE_SECTIONS; s++)
+    {
+        header.section_offset[s] = offset;
+        offset = alignedArrangementOffset(offset + bytes[s]);
+    }
+    header.file_size = offset;
+
+    FILE *fp = fopen(filename.c_str(), "wb");
+    if(!fp) return false;
+
+    const char zeros[8] = {};
+    uint64_t written = fwrite(&header, 1, sizeof(header), fp);
+    for(uint s = 0; s < NUM_ARRANGEMENT_FILE_SECTIONS; s++)
+    {
+        written += fwrite(zeros, 1, header.section_offset[s] - written, fp);
+        if(bytes[s]) written += fwrite(data[s], 1, bytes[s], fp);
+    }
+    written += fwrite(zeros, 1, header.file_size - written, fp);
+
+    return (fclose(fp) == 0) && (written == header.file_size);
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline bool loadLabelledArrangement(const std::string &filename, LabelledArrangement &arr)
+{
+    assert(!arr.tm && arr.verts.empty() && "the arrangement must be empty");
+
+    FILE *fp = fopen(filename.c_str(), "rb");
+    if(!fp) return false;
+
+    // 8 byte words, so that the sections are aligned in memory as they are in the file
+    std::vector<uint64_t> buffer;
+    bool read_ok = (fseek(fp, 0, SEEK_END) == 0);
+    long size = read_ok ? ftell(fp) : -1;
+    if(size >= static_cast<long>(sizeof(ArrangementFileHeader)))
+    {
+        buffer.resize((static_cast<size_t>(size) + 7) / 8);
+        read_ok = (fseek(fp, 0, SEEK_SET) == 0) && (fread(buffer.data(), 1, size, fp) == static_cast<size_t>(size));
+    }
+    else read_ok = false;
+    fclose(fp);
+    if(!read_ok) return false;
+
+    const char *file = reinterpret_cast<const char*>(buffer.data());
+    ArrangementFileHeader header;
+    memcpy(&header, file, sizeof(header));
+    if(memcmp(header.magic, ARRANGEMENT_FILE_MAGIC, sizeof(header.magic)) != 0 || header.version != ARRANGEMENT_FILE_VERSION ||
+       header.file_size != static_cast<uint64_t>(size) || header.num_labels > NBIT)
+        return false;
+
+    const uint64_t bytes[NUM_ARRANGEMENT_FILE_SECTIONS] = {header.num_verts, uint64_t(header.num_explicit) * 3 * sizeof(double),
+                                                           uint64_t(header.num_implicit_ids) * sizeof(uint32_t),
+                                                           uint64_t(header.num_tris) * 3 * sizeof(uint32_t),
+                                                           uint64_t(header.num_tris) * sizeof(uint32_t), uint64_t(header.num_tris) * sizeof(uint32_t),
+                                                           (uint64_t(header.num_patches) + 1) * sizeof(uint32_t),
+                                                           uint64_t(header.num_patch_tris) * sizeof(uint32_t)};
+    for(uint s = 0; s < NUM_ARRANGEMENT_FILE_SECTIONS; s++)
+        if(header.section_offset[s] % 8 != 0 || header.section_offset[s] > header.file_size ||
+           bytes[s] > header.file_size - header.section_offset[s])
+            return false;
+
+    const uint8_t  *vert_types    = reinterpret_cast<const uint8_t*>(file + header.section_offset[SECTION_VERT_TYPES]);
+    const double   *coords        = reinterpret_cast<const double*>(file + header.section_offset[SECTION_COORDS]);
+    const uint32_t *implicit_ids  = reinterpret_cast<const uint32_t*>(file + header.section_offset[SECTION_IMPLICIT]);
+    const uint32_t *tris          = reinterpret_cast<const uint32_t*>(file + header.section_offset[SECTION_TRIS]);
+    const uint32_t *surface       = reinterpret_cast<const uint32_t*>(file + header.section_offset[SECTION_SURFACE]);
+    const uint32_t *inside        = reinterpret_cast<const uint32_t*>(file + header.section_offset[SECTION_INSIDE]);
+    const uint32_t *patch_offsets = reinterpret_cast<const uint32_t*>(file + header.section_offset[SECTION_PATCH_OFFSETS]);
+    const uint32_t *patch_tris    = reinterpret_cast<const uint32_t*>(file + header.section_offset[SECTION_PATCH_TRIS]);
+
+    // explicit vertices first, since the implicit ones refer to them. init is reserved, so the addresses are stable
+    arr.verts.resize(header.num_verts, nullptr);
+    arr.arena.init.reserve(header.num_explicit);
+    for(uint v_id = 0; v_id < header.num_verts; v_id++)
+    {
+        if(vert_types[v_id] != EXPLICIT3D) continue;
+        if(arr.arena.init.size() == header.num_explicit) return false;
+        const double *c = coords + 3 * arr.arena.init.size();
+        arr.verts[v_id] = &arr.arena.init.emplace_back(c[0], c[1], c[2]);
+    }
+
+    uint64_t next_id = 0;
+    bool ok = true;
+    auto e = [&]() -> const explicitPoint3D&
+    {
+        uint32_t v_id = (next_id < header.num_implicit_ids) ? implicit_ids[next_id] : std::numeric_limits<uint32_t>::max();
+        next_id++;
+        if(v_id >= header.num_verts || !arr.verts[v_id] || !arr.verts[v_id]->isExplicit3D()) { ok = false; return arr.arena.init[0]; }
+        return arr.verts[v_id]->toExplicit3D();
+    };
+
+    for(uint v_id = 0; ok && v_id < header.num_verts; v_id++)
+    {
+        if(vert_types[v_id] == EXPLICIT3D) continue;
+        if(header.num_explicit == 0) return false;
+
+        if(vert_types[v_id] == LPI)
+        {
+            const explicitPoint3D &p = e(), &q = e(), &r = e(), &s = e(), &t = e();
+            if(ok) arr.verts[v_id] = &arr.arena.edges.emplace_back(p, q, r, s, t);
+        }
+        else if(vert_types[v_id] == TPI)
+        {
+            const explicitPoint3D &v1 = e(), &v2 = e(), &v3 = e(), &w1 = e(), &w2 = e(), &w3 = e(), &u1 = e(), &u2 = e(), &u3 = e();
+            if(ok) arr.verts[v_id] = &arr.arena.tpi.emplace_back(v1, v2, v3, w1, w2, w3, u1, u2, u3);
+        }
+        else ok = false;
+    }
+    if(!ok || next_id != header.num_implicit_ids) return false;
+
+    arr.out_tris.assign(tris, tris + 3 * uint64_t(header.num_tris));
+    for(uint v_id : arr.out_tris)
+        if(v_id >= header.num_verts) return false;
+
+    arr.labels.num = header.num_labels;
+    arr.labels.surface.resize(header.num_tris);
+    arr.labels.inside.resize(header.num_tris);
+    for(uint t_id = 0; t_id < header.num_tris; t_id++)
+    {
+        arr.labels.surface[t_id] = std::bitset<NBIT>(surface[t_id]);
+        arr.labels.inside[t_id]  = std::bitset<NBIT>(inside[t_id]);
+    }
+
+    if(patch_offsets[0] != 0 || patch_offsets[header.num_patches] != header.num_patch_tris) return false;
+    arr.patches.resize(header.num_patches);
+    for(uint p_id = 0; p_id < header.num_patches; p_id++)
+    {
+        if(patch_offsets[p_id] > patch_offsets[p_id + 1]) return false;
+        arr.patches[p_id].insert(patch_tris + patch_offsets[p_id], patch_tris + patch_offsets[p_id + 1]);
+    }
+
+    arr.tm.emplace(arr.verts, arr.out_tris, ENABLE_MULTITHREADING);
+    return true;
+}
@@ -43,9 +43,16 @@
 #include "triangle_soup.h"
 #include "intersection_classification.h"
 #include "triangulation.h"
+#include "static_trimesh.h"
 #include <cinolib/octree.h>
 
+#include <algorithm>
 #include <bitset>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <optional>
 
 struct Labels
 {
@@ -71,68 +78,222 @@ struct DuplTriInfo
 
 enum BoolOp {UNION, INTERSECTION, SUBTRACTION, XOR, NONE};
 
+enum PipelineStage
+{
+    STAGE_VERTEX_MERGE,
+    STAGE_DEGENERATE_REMOVAL,
+    STAGE_TRIANGLE_SOUP,
+    STAGE_BROAD_PHASE,
+    STAGE_CLASSIFICATION,
+    STAGE_TRIANGULATION,
+    STAGE_MESH_BUILD,
+    STAGE_PATCHES,
+    STAGE_INSIDE_OUT,
+    STAGE_OP_SELECTION,
+    STAGE_FINAL_EXTRACTION,
+    STAGE_RESULT_PACKING, // filled by the caller of booleanPipeline
+    NUM_PIPELINE_STAGES
+};
+
+struct StageStats
+{
+    double time            = 0; // seconds
+    uint   num_tris        = 0; // triangles of the working mesh at the end of the stage
+    uint   num_points      = 0; // points of the working mesh at the end of the stage
+    size_t arena_bytes     = 0; // bytes of the point arena at the end of the stage
+    size_t structure_bytes = 0; // bytes of the structure built by the stage, if any (aux structure, mesh)
+};
+
+struct PipelineStats
+{
+    StageStats stages[NUM_PIPELINE_STAGES];
+    const point_arena *arena = nullptr;
+    std::chrono::time_point<std::chrono::system_clock> stage_start;
+    ProgressMonitor *progress = nullptr; // if set, told of each stage, and checked for cancellation, by endStage
+
+    inline void startStage();
+    inline void endStage(PipelineStage s, uint num_tris, uint num_points, size_t structure_bytes = 0);
+};
+
+struct PipelineOptions
+{
+    // when nonzero, the input is snapped to a lattice of signed integers of snap_bits bits per axis (see
+    // computeLatticeMultiplier) and the arrangement works on those integers. Coincident and degenerate features
+    // closer than the lattice pitch collapse, and the predicates mostly see small integer coordinates
+    uint snap_bits = 0;
+
+    // budget of the operation (none by default): past the deadline, or beyond max_intersection_pairs pairs of
+    // intersecting triangles or max_implicit_points implicit points, booleanPipeline stops with OperationCancelled.
+    // The pairs are checked after the broad phase, the points and the time at every checkpoint of stats.progress
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+    uint max_intersection_pairs = 0;
+    uint max_implicit_points = 0;
+    // tells the callers of booleanPipeline to fall back to previewBooleanOp when the budget is exceeded
+    bool preview_on_budget = false;
+
+    // the last num_welded_verts input vertices are distinct from each other (e.g. generated primitives), so the vertex
+    // merge only looks them up among the others. Ignored with snap_bits, which can make them coincide
+    uint num_welded_verts = 0;
+
+    // the result is re-triangulated by mergeCoplanarRegions: fewer triangles on planar faces split by the
+    // intersection curves, for some more time in STAGE_FINAL_EXTRACTION
+    bool merge_coplanar = false;
+
+    bool hasBudget() const { return deadline || max_intersection_pairs || max_implicit_points; }
+};
+
 enum IntersInfo {DISCARD, NO_INT, INT_IN_V0, INT_IN_V1, INT_IN_V2, INT_IN_EDGE01, INT_IN_EDGE12, INT_IN_EDGE20, INT_IN_TRI};
 
-struct less_than_GP_on_X // lessThan GenericPoint along X
+struct less_than_LPI_on_X // lessThan between line-plane intersections along X
 {
-    bool operator() (const std::pair<genericPoint*, uint> &p0, const std::pair<genericPoint*, uint> &p1) const
+    bool operator() (const std::pair<implicitPoint3D_LPI*, uint> &p0, const std::pair<implicitPoint3D_LPI*, uint> &p1) const
     {
-        return (genericPoint::lessThanOnX(*p0.first, *p1.first) <= 0);
+        return (lessThanOnX_II(*p0.first, *p1.first) <= 0);
     }
 };
 
-struct less_than_GP_on_Y // lessThan GenericPoint along Y
+struct less_than_LPI_on_Y // lessThan between line-plane intersections along Y
 {
-    bool operator() (const std::pair<genericPoint*, uint> &p0, const std::pair<genericPoint*, uint> &p1) const
+    bool operator() (const std::pair<implicitPoint3D_LPI*, uint> &p0, const std::pair<implicitPoint3D_LPI*, uint> &p1) const
     {
-        return (genericPoint::lessThanOnY(*p0.first, *p1.first) <= 0);
+        return (lessThanOnY_II(*p0.first, *p1.first) <= 0);
     }
 };
 
-struct less_than_GP_on_Z // lessThan GenericPoint along Z
+struct less_than_LPI_on_Z // lessThan between line-plane intersections along Z
 {
-    bool operator() (const std::pair<genericPoint*, uint> &p0, const std::pair<genericPoint*, uint> &p1) const
+    bool operator() (const std::pair<implicitPoint3D_LPI*, uint> &p0, const std::pair<implicitPoint3D_LPI*, uint> &p1) const
     {
-        return (genericPoint::lessThanOnZ(*p0.first, *p1.first) <= 0);
+        return (lessThanOnZ_II(*p0.first, *p1.first) <= 0);
     }
 };
 
+/* Everything the boolean operations have in common: the arrangement of the input meshes, with each of its
+ * triangles labelled inside/outside each input, and the mesh the results are selected from.
+ * computeLabelledArrangement fills it once, then extractBooleanOp gives the result of any operation on it,
+ * in time linear in the number of triangles. Not copyable: tm refers to verts */
+struct LabelledArrangement
+{
+    point_arena arena;
+    std::vector<genericPoint*> verts;
+    std::vector<uint> in_tris, out_tris;
+    std::vector<std::bitset<NBIT>> in_labels;
+    std::vector<DuplTriInfo> dupl_triangles;
+    Labels labels;
+    std::vector<phmap::flat_hash_set<uint>> patches;
+    cinolib::Octree octree;
+    std::optional<StaticTrimesh> tm;
+
+    LabelledArrangement() = default;
+    LabelledArrangement(const LabelledArrangement &) = delete;
+    LabelledArrangement &operator=(const LabelledArrangement &) = delete;
+};
+
+inline void computeLabelledArrangement(const std::vector<double> &in_coords, const std::vector<uint> &in_tris,
+                                       const std::vector<uint> &in_labels, LabelledArrangement &arr, PipelineStats &stats,
+                                       const PipelineOptions &options = {});
+
+/* storage of booleanPipeline kept from one operation to the next on the same thread, so that a sequence of small
+ * operations does not allocate the point arena and the per-triangle arrays every time. The octree is rebuilt by each
+ * operation. A workspace serves one pipeline at a time */
+struct PipelineWorkspace
+{
+    point_arena arena;
+    std::vector<genericPoint*> verts;
+    std::vector<uint> in_tris, out_tris;
+    std::vector<std::bitset<NBIT>> in_labels;
+    std::vector<DuplTriInfo> dupl_triangles;
+    Labels labels;
+    std::vector<phmap::flat_hash_set<uint>> patches;
+
+    // empties everything, keeping the storage
+    inline void clear();
+};
+
+// minuend: the label that all the others are subtracted from, when op is SUBTRACTION. See PipelineOptions for merge_coplanar
+inline void extractBooleanOp(LabelledArrangement &arr, const BoolOp &op, std::vector<double> &bool_coords, std::vector<uint> &bool_tris,
+                             std::vector< std::bitset<NBIT>> &bool_labels, PipelineStats &stats, uint minuend = 0,
+                             bool merge_coplanar = false);
+
+// patches and inside/outside labels of the triangles of tm
+inline void labelArrangement(StaticTrimesh &tm, std::vector<genericPoint*>& arr_verts, std::vector<uint>& arr_in_tris,
+                             std::vector<std::bitset<NBIT>>& arr_in_labels, std::vector<DuplTriInfo>& dupl_triangles, Labels& labels,
+                             std::vector<phmap::flat_hash_set<uint>>& patches, cinolib::Octree& octree, PipelineStats &stats);
+
+// selects the triangles of op and extracts them, re-triangulated by mergeCoplanarRegions if merge_coplanar.
+// The triangles of tm may be flipped
+inline void selectAndExtractBooleanOp(StaticTrimesh &tm, const Labels &labels, const BoolOp &op, std::vector<double> &bool_coords,
+                                      std::vector<uint> &bool_tris, std::vector< std::bitset<NBIT>> &bool_labels, PipelineStats &stats,
+                                      uint minuend = 0, bool merge_coplanar = false);
+
 inline void customBooleanPipeline(std::vector<genericPoint*>& arr_verts, std::vector<uint>& arr_in_tris,
                                   std::vector<uint>& arr_out_tris, std::vector<std::bitset<NBIT>>& arr_in_labels,
                                   std::vector<DuplTriInfo>& dupl_triangles, Labels& labels,
                                   std::vector<phmap::flat_hash_set<uint>>& patches, cinolib::Octree& octree,
                                   const BoolOp &op, std::vector<double> &bool_coords, std::vector<uint> &bool_tris,
-                                  std::vector< std::bitset<NBIT>> &bool_labels);
+                                  std::vector< std::bitset<NBIT>> &bool_labels, PipelineStats &stats, bool merge_coplanar = false);
 
 inline void booleanPipeline(const std::vector<double> &in_coords, const std::vector<uint> &in_tris,
                             const std::vector<uint> &in_labels, const BoolOp &op, std::vector<double> &bool_coords,
                             std::vector<uint> &bool_tris, std::vector< std::bitset<NBIT> > &bool_labels);
 
+inline void booleanPipeline(const std::vector<double> &in_coords, const std::vector<uint> &in_tris,
+                            const std::vector<uint> &in_labels, const BoolOp &op, std::vector<double> &bool_coords,
+                            std::vector<uint> &bool_tris, std::vector< std::bitset<NBIT> > &bool_labels, PipelineStats &stats,
+                            const PipelineOptions &options = {});
+
+// the budget of options is only enforced if stats.progress is set
+inline void booleanPipeline(const std::vector<double> &in_coords, const std::vector<uint> &in_tris,
+                            const std::vector<uint> &in_labels, const BoolOp &op, std::vector<double> &bool_coords,
+                            std::vector<uint> &bool_tris, std::vector< std::bitset<NBIT> > &bool_labels, PipelineStats &stats,
+                            const PipelineOptions &options, PipelineWorkspace &ws);
+
+/* self-intersections of a single mesh resolved by its arrangement: the triangles are split along the curves where
+ * they cross each other, so that they only meet at shared edges and vertices. Nothing is selected, so the parts of
+ * the mesh inside itself stay; only the degenerate and duplicated triangles go. Runs the arrangement stages of
+ * booleanPipeline (broad phase on the octree, classification, triangulation) with the same workspace and budget,
+ * then STAGE_FINAL_EXTRACTION. The output keeps the orientation of the input triangles */
+inline void resolveSelfIntersections(const std::vector<double> &in_coords, const std::vector<uint> &in_tris,
+                                     std::vector<double> &out_coords, std::vector<uint> &out_tris, PipelineStats &stats,
+                                     const PipelineOptions &options, PipelineWorkspace &ws);
+
+/* cheap approximation of booleanPipeline for interactive previews, e.g. when the exact operation exceeds its budget.
+ * The input triangles are not split: each one is kept or discarded as a whole, by the parity of the crossings of a
+ * vertical ray from its barycenter with the triangles of each other label, in floating point. Same output as
+ * booleanPipeline, with jagged borders along the intersection curves and no guarantee on degenerate inputs */
+inline void previewBooleanOp(const std::vector<double> &in_coords, const std::vector<uint> &in_tris,
+                             const std::vector<uint> &in_labels, const BoolOp &op, std::vector<double> &bool_coords,
+                             std::vector<uint> &bool_tris, std::vector< std::bitset<NBIT> > &bool_labels, uint minuend = 0);
+
 
 inline void customArrangementPipeline(const std::vector<double> &in_coords, const std::vector<uint> &in_tris, const std::vector<uint> &in_labels,
                                       std::vector<uint> &arr_in_tris, std::vector< std::bitset<NBIT>> &arr_in_labels,
                                       point_arena& arena, std::vector<genericPoint *> &vertices, std::vector<uint> &arr_out_tris, Labels &labels,
-                                      cinolib::Octree &octree, std::vector<DuplTriInfo> &dupl_triangles, bool parallel);
+                                      cinolib::Octree &octree, std::vector<DuplTriInfo> &dupl_triangles, PipelineStats &stats, bool parallel,
+                                      const PipelineOptions &options = {});
+
+inline void findDegenerateTriangles(const std::vector<genericPoint *> &verts, const std::vector<uint> &tris,
+                                    std::vector<uint8_t> &degenerate, bool parallel);
 
 inline void customRemoveDegenerateAndDuplicatedTriangles(const std::vector<genericPoint*> &verts, std::vector<uint> &tris,
                                                          std::vector< std::bitset<NBIT> > &labels, std::vector<DuplTriInfo> &dupl_triangles,
                                                          bool parallel);
 
-inline void customDetectIntersections(const TriangleSoup &ts, std::vector<std::pair<uint, uint> > &intersection_list, cinolib::Octree &o);
+inline void customDetectIntersections(const TriangleSoup &ts, std::vector<std::pair<uint, uint> > &intersection_list, cinolib::Octree &o,
+                                      ProgressMonitor *progress = nullptr);
 
 inline void addDuplicateTrisInfoInStructures(const std::vector<DuplTriInfo> &dupl_tris, std::vector<uint> &in_tris,
                                              std::vector<std::bitset<NBIT>> &in_labels, cinolib::Octree &octree);
 
-inline void computeAllPatches(FastTrimesh &tm, const Labels &labels, std::vector<phmap::flat_hash_set<uint>> &patches, bool parallel);
+inline void computeAllPatches(StaticTrimesh &tm, const Labels &labels, std::vector<phmap::flat_hash_set<uint>> &patches);
 
-inline void computeSinglePatch(FastTrimesh &tm, uint seed_t, const Labels &labels, phmap::flat_hash_set<uint> &patch);
-inline void computeSinglePatch(FastTrimesh &tm, uint seed_t, const Labels &labels, phmap::flat_hash_set<uint> &patch, const std::vector<std::array<uint, 3>>& adjT2E);
+inline void computeSinglePatch(StaticTrimesh &tm, uint seed_t, const Labels &labels, phmap::flat_hash_set<uint> &patch);
 
-inline void findRayEndpoints(const FastTrimesh &tm, const phmap::flat_hash_set<uint> &patch, const cinolib::vec3d &max_coords, Ray &ray);
+inline void findRayEndpoints(const StaticTrimesh &tm, const phmap::flat_hash_set<uint> &patch, const cinolib::vec3d &max_coords, Ray &ray);
 
 inline bool intersects_box(const cinolib::Octree& tree, const cinolib::AABB & b, phmap::flat_hash_set<uint> & ids);
 
-inline void computeInsideOut(const FastTrimesh &tm, const std::vector<phmap::flat_hash_set<uint>> &patches, const cinolib::Octree &octree,
+inline void computeInsideOut(const StaticTrimesh &tm, const std::vector<phmap::flat_hash_set<uint>> &patches, const cinolib::Octree &octree,
                              const std::vector<genericPoint *> &in_verts, const std::vector<uint> &in_tris,
                              const std::vector<std::bitset<NBIT>> &in_labels, const cinolib::vec3d &max_coords, Labels &labels);
 
@@ -183,16 +344,37 @@ inline uint checkTriangleOrientation(const Ray &ray, const explicitPoint3D &tv0,
 
 inline void propagateInnerLabelsOnPatch(const phmap::flat_hash_set<uint> &patch_tris, const std::bitset<NBIT> &patch_inner_label, Labels &labels);
 
-inline void computeFinalExplicitResult(const FastTrimesh &tm, const Labels &labels, uint num_tris_in_final_res,
+inline void computeFinalExplicitResult(const StaticTrimesh &tm, const Labels &labels, uint num_tris_in_final_res,
                                        std::vector<double> &out_coords, std::vector<uint> &out_tris, std::vector<std::bitset<NBIT>> &out_label, bool flat_array);
 
-inline uint boolIntersection(FastTrimesh &tm, const Labels &labels);
+// same as the flat_array version above, for triangles that are not (all) in tm: tris holds vertex ids of tm, which
+// are replaced by the ids of the compacted output vertices
+inline void computeFinalExplicitResult(const StaticTrimesh &tm, std::vector<uint> &tris, std::vector<double> &out_coords);
+
+/* the selected triangles of tm with the same surface label, on the same plane, facing the same side and joined by
+ * edges that only they share form a coplanar region. mergeCoplanarRegions re-triangulates each region without the
+ * vertices that do not shape it: the ones inside it and the ones on straight stretches of its border, as long as
+ * every region around them can drop them too, so the result stays watertight. The triangles are then as few as the
+ * borders of the regions allow. All the tests are exact, on the implicit points; the regions are processed in
+ * parallel. out_tris holds vertex ids of tm */
+inline void mergeCoplanarRegions(const StaticTrimesh &tm, const Labels &labels, std::vector<uint> &out_tris,
+                                 std::vector<std::bitset<NBIT>> &out_labels);
+
+// ordered link of a vertex, from the edges (a, b) opposite to it in its triangles: true if they form a single chain,
+// written from its first to its last vertex, or a single cycle (closed)
+inline bool vertexLink(const std::vector<std::pair<uint, uint>> &edges, std::vector<uint> &link, bool &closed);
+
+// ear clipping of the simple polygon poly, best shaped ears first. Its vertices are coplanar and turn as sign on the
+// plane of axis n_max. False if it finds no ear, e.g. on a polygon that is not simple
+inline bool triangulatePolygon(const StaticTrimesh &tm, std::vector<uint> &poly, int n_max, int sign, std::vector<uint> &out_tris);
+
+inline uint boolIntersection(StaticTrimesh &tm, const Labels &labels);
 
-inline uint boolUnion(FastTrimesh &tm, const Labels &labels);
+inline uint boolUnion(StaticTrimesh &tm, const Labels &labels);
 
-inline uint boolSubtraction(FastTrimesh &tm, const Labels &labels);
+inline uint boolSubtraction(StaticTrimesh &tm, const Labels &labels, uint minuend = 0);
 
-inline uint boolXOR(FastTrimesh &tm, const Labels &labels);
+inline uint boolXOR(StaticTrimesh &tm, const Labels &labels);
 
 inline uint bitsetToUint(const std::bitset<NBIT> &b);
 
@@ -50,32 +50,76 @@
     }
 #endif
 
+inline void PipelineStats::startStage()
+{
+    stage_start = startChrono();
+}
+
+inline void PipelineStats::endStage(PipelineStage s, uint num_tris, uint num_points, size_t structure_bytes)
+{
+    StageStats &st = stages[s];
+    st.time = stopChrono(stage_start);
+    st.num_tris = num_tris;
+    st.num_points = num_points;
+    st.arena_bytes = arena ? arena->memoryFootprint() : 0;
+    st.structure_bytes = structure_bytes;
+
+    if(progress) progress->beginStage(s + 1);
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 inline void customBooleanPipeline(std::vector<genericPoint*>& arr_verts, std::vector<uint>& arr_in_tris,
                                   std::vector<uint>& arr_out_tris, std::vector<std::bitset<NBIT>>& arr_in_labels,
                                   std::vector<DuplTriInfo>& dupl_triangles, Labels& labels,
                                   std::vector<phmap::flat_hash_set<uint>>& patches, cinolib::Octree& octree,
                                   const BoolOp &op, std::vector<double> &bool_coords, std::vector<uint> &bool_tris,
-                                  std::vector< std::bitset<NBIT>> &bool_labels)
+                                  std::vector< std::bitset<NBIT>> &bool_labels, PipelineStats &stats, bool merge_coplanar)
 {
-    FastTrimesh tm(arr_verts, arr_out_tris, ENABLE_MULTITHREADING);
+    stats.startStage();
+    StaticTrimesh tm(arr_verts, arr_out_tris, ENABLE_MULTITHREADING);
+    stats.endStage(STAGE_MESH_BUILD, tm.numTris(), tm.numVerts(), tm.memoryFootprint());
+
+    labelArrangement(tm, arr_verts, arr_in_tris, arr_in_labels, dupl_triangles, labels, patches, octree, stats);
+
+    selectAndExtractBooleanOp(tm, labels, op, bool_coords, bool_tris, bool_labels, stats, 0, merge_coplanar);
+}
 
-    computeAllPatches(tm, labels, patches, ENABLE_MULTITHREADING);
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline void labelArrangement(StaticTrimesh &tm, std::vector<genericPoint*>& arr_verts, std::vector<uint>& arr_in_tris,
+                             std::vector<std::bitset<NBIT>>& arr_in_labels, std::vector<DuplTriInfo>& dupl_triangles, Labels& labels,
+                             std::vector<phmap::flat_hash_set<uint>>& patches, cinolib::Octree& octree, PipelineStats &stats)
+{
+    stats.startStage();
+    computeAllPatches(tm, labels, patches);
+    stats.endStage(STAGE_PATCHES, tm.numTris(), tm.numVerts());
 
+    stats.startStage();
     // the informations about duplicated triangles (removed in arrangements) are restored in the original structures
     addDuplicateTrisInfoInStructures(dupl_triangles, arr_in_tris, arr_in_labels, octree);
 
     // parse patches with octree and rays
     cinolib::vec3d max_coords(octree.root->bbox.max.x() +0.5, octree.root->bbox.max.y() +0.5, octree.root->bbox.max.z() +0.5);
     computeInsideOut(tm, patches, octree, arr_verts, arr_in_tris, arr_in_labels, max_coords, labels);
+    stats.endStage(STAGE_INSIDE_OUT, tm.numTris(), tm.numVerts());
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+inline void selectAndExtractBooleanOp(StaticTrimesh &tm, const Labels &labels, const BoolOp &op, std::vector<double> &bool_coords,
+                                      std::vector<uint> &bool_tris, std::vector< std::bitset<NBIT>> &bool_labels, PipelineStats &stats,
+                                      uint minuend, bool merge_coplanar)
+{
     // booleand operations
+    stats.startStage();
     uint num_tris_in_final_solution;
     if(op == INTERSECTION)
         num_tris_in_final_solution = boolIntersection(tm, labels);
     else if(op == UNION)
         num_tris_in_final_solution = boolUnion(tm, labels);
     else if(op == SUBTRACTION)
-        num_tris_in_final_solution = boolSubtraction(tm, labels);
+        num_tris_in_final_solution = boolSubtraction(tm, labels, minuend);
     else if(op == XOR)
         num_tris_in_final_solution = boolXOR(tm, labels);
     else
@@ -83,41 +127,296 @@ inline void customBooleanPipeline(std::vector<genericPoint*>& arr_verts, std::ve
         std::cerr << "boolean operation not implemented yet" << std::endl;
         std::exit(EXIT_FAILURE);
     }
+    stats.endStage(STAGE_OP_SELECTION, num_tris_in_final_solution, tm.numVerts());
 
-    computeFinalExplicitResult(tm, labels, num_tris_in_final_solution, bool_coords, bool_tris, bool_labels, true);
+    stats.startStage();
+    if(merge_coplanar)
+    {
+        mergeCoplanarRegions(tm, labels, bool_tris, bool_labels);
+        computeFinalExplicitResult(tm, bool_tris, bool_coords);
+    }
+    else
+        computeFinalExplicitResult(tm, labels, num_tris_in_final_solution, bool_coords, bool_tris, bool_labels, true);
+    stats.endStage(STAGE_FINAL_EXTRACTION, static_cast<uint>(bool_tris.size() / 3), static_cast<uint>(bool_coords.size() / 3));
 }
 
-extern int arr_time;
-extern int bool_time;
-extern std::vector<std::string> files;
-
 inline void booleanPipeline(const std::vector<double> &in_coords, const std::vector<uint> &in_tris,
                             const std::vector<uint> &in_labels, const BoolOp &op, std::vector<double> &bool_coords,
                             std::vector<uint> &bool_tris, std::vector< std::bitset<NBIT> > &bool_labels)
+{
+    PipelineStats stats;
+    booleanPipeline(in_coords, in_tris, in_labels, op, bool_coords, bool_tris, bool_labels, stats);
+}
+
+inline void booleanPipeline(const std::vector<double> &in_coords, const std::vector<uint> &in_tris,
+                            const std::vector<uint> &in_labels, const BoolOp &op, std::vector<double> &bool_coords,
+                            std::vector<uint> &bool_tris, std::vector< std::bitset<NBIT> > &bool_labels, PipelineStats &stats,
+                            const PipelineOptions &options)
+{
+    PipelineWorkspace workspace;
+    booleanPipeline(in_coords, in_tris, in_labels, op, bool_coords, bool_tris, bool_labels, stats, options, workspace);
+}
+
+inline void booleanPipeline(const std::vector<double> &in_coords, const std::vector<uint> &in_tris,
+                            const std::vector<uint> &in_labels, const BoolOp &op, std::vector<double> &bool_coords,
+                            std::vector<uint> &bool_tris, std::vector< std::bitset<NBIT> > &bool_labels, PipelineStats &stats,
+                            const PipelineOptions &options, PipelineWorkspace &ws)
 {
     initFPU();
 
-    point_arena arena;
-    std::vector<genericPoint*> arr_verts; // <- it contains the original expl verts + the new_impl verts
-    std::vector<uint> arr_in_tris, arr_out_tris;
-    std::vector<std::bitset<NBIT>> arr_in_labels;
-    std::vector<DuplTriInfo> dupl_triangles;
-    Labels labels;
-    std::vector<phmap::flat_hash_set<uint>> patches;
-    cinolib::Octree octree; // built with arr_in_tris and arr_in_labels
+    ws.clear();
+    stats.arena = &ws.arena;
+    if(stats.progress)
+    {
+        stats.progress->setBudget(options.deadline, options.max_intersection_pairs, options.max_implicit_points);
+        stats.progress->beginStage(STAGE_VERTEX_MERGE);
+    }
+    cinolib::Octree octree; // built with ws.in_tris and ws.in_labels
 
     bool enableMultithreading = false;
 #if EMSCRIPTEN
     enableMultithreading = false;
 #endif
-    customArrangementPipeline(in_coords, in_tris, in_labels, arr_in_tris, arr_in_labels, arena, arr_verts,
-                              arr_out_tris, labels, octree, dupl_triangles, enableMultithreading);
+    customArrangementPipeline(in_coords, in_tris, in_labels, ws.in_tris, ws.in_labels, ws.arena, ws.verts,
+                              ws.out_tris, ws.labels, octree, ws.dupl_triangles, stats, enableMultithreading, options);
+
+    customBooleanPipeline(ws.verts, ws.in_tris, ws.out_tris, ws.in_labels, ws.dupl_triangles, ws.labels,
+                          ws.patches, octree, op, bool_coords, bool_tris, bool_labels, stats, options.merge_coplanar);
 
-    customBooleanPipeline(arr_verts, arr_in_tris, arr_out_tris, arr_in_labels, dupl_triangles, labels,
-                          patches, octree, op, bool_coords, bool_tris, bool_labels);
+    stats.arena = nullptr;
 }
 
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+inline void PipelineWorkspace::clear()
+{
+    arena.clear();
+    verts.clear();
+    in_tris.clear();
+    out_tris.clear();
+    in_labels.clear();
+    dupl_triangles.clear();
+    labels.surface.clear();
+    labels.inside.clear();
+    labels.num = 0;
+    patches.clear();
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline void resolveSelfIntersections(const std::vector<double> &in_coords, const std::vector<uint> &in_tris,
+                                     std::vector<double> &out_coords, std::vector<uint> &out_tris, PipelineStats &stats,
+                                     const PipelineOptions &options, PipelineWorkspace &ws)
+{
+    initFPU();
+
+    ws.clear();
+    stats.arena = &ws.arena;
+    if(stats.progress)
+    {
+        stats.progress->setBudget(options.deadline, options.max_intersection_pairs, options.max_implicit_points);
+        stats.progress->beginStage(STAGE_VERTEX_MERGE);
+    }
+    cinolib::Octree octree;
+
+    const std::vector<uint> in_labels(in_tris.size() / 3, 0);
+    customArrangementPipeline(in_coords, in_tris, in_labels, ws.in_tris, ws.in_labels, ws.arena, ws.verts,
+                              ws.out_tris, ws.labels, octree, ws.dupl_triangles, stats, false, options);
+
+    // output, with the vertices compacted as in computeFinalExplicitResult
+    stats.startStage();
+    std::vector<int> vertex_index(ws.verts.size(), -1);
+    std::vector<uint> used_verts;
+    out_tris.resize(ws.out_tris.size());
+    for(size_t i = 0; i < ws.out_tris.size(); i++)
+    {
+        const uint v_id = ws.out_tris[i];
+        if(vertex_index[v_id] == -1)
+        {
+            vertex_index[v_id] = static_cast<int>(used_verts.size());
+            used_verts.push_back(v_id);
+        }
+        out_tris[i] = static_cast<uint>(vertex_index[v_id]);
+    }
+
+    const double multiplier = ws.verts.back()->toExplicit3D().X(); // the last jolly point, see computeFinalExplicitResult
+    out_coords.resize(3 * used_verts.size());
+    parallelizable_for((uint)0, (uint)used_verts.size(), [&](uint i)
+    {
+        double *c = out_coords.data() + 3 * i;
+        ws.verts[used_verts[i]]->getApproxXYZCoordinates(c[0], c[1], c[2]);
+        for(uint a = 0; a < 3; a++) c[a] /= multiplier;
+    });
+    stats.endStage(STAGE_FINAL_EXTRACTION, static_cast<uint>(out_tris.size() / 3), static_cast<uint>(used_verts.size()));
+
+    stats.arena = nullptr;
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline void previewBooleanOp(const std::vector<double> &in_coords, const std::vector<uint> &in_tris,
+                             const std::vector<uint> &in_labels, const BoolOp &op, std::vector<double> &bool_coords,
+                             std::vector<uint> &bool_tris, std::vector< std::bitset<NBIT> > &bool_labels, uint minuend)
+{
+    const uint num_tris = static_cast<uint>(in_tris.size() / 3);
+    std::bitset<NBIT> mask;
+    for(uint l : in_labels) mask[l] = true;
+    const uint num_labels = static_cast<uint>(mask.count());
+
+    // uniform grid on the XY plane, each cell listing the triangles whose box overlaps it
+    double min[2] = { std::numeric_limits<double>::max(), std::numeric_limits<double>::max() };
+    double max[2] = { std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest() };
+    for(size_t i = 0; i < in_coords.size(); i += 3)
+        for(uint a = 0; a < 2; a++)
+        {
+            min[a] = std::min(min[a], in_coords[i + a]);
+            max[a] = std::max(max[a], in_coords[i + a]);
+        }
+
+    const uint res = std::clamp(static_cast<uint>(std::sqrt(double(num_tris))), 1u, 2048u);
+    double cell[2];
+    for(uint a = 0; a < 2; a++) cell[a] = (max[a] > min[a]) ? (max[a] - min[a]) / res : 1.0;
+    auto cellOf = [&](double c, uint a) { return std::min(static_cast<uint>(std::max(0.0, (c - min[a]) / cell[a])), res - 1); };
+
+    auto triCells = [&](uint t_id, uint c0[2], uint c1[2])
+    {
+        for(uint a = 0; a < 2; a++)
+        {
+            const double *v = in_coords.data() + a;
+            const uint *t = in_tris.data() + 3 * t_id;
+            c0[a] = cellOf(std::min({v[3 * t[0]], v[3 * t[1]], v[3 * t[2]]}), a);
+            c1[a] = cellOf(std::max({v[3 * t[0]], v[3 * t[1]], v[3 * t[2]]}), a);
+        }
+    };
+
+    std::vector<uint> offsets(res * res + 1, 0), cell_tris;
+    for(uint t_id = 0; t_id < num_tris; t_id++)
+    {
+        uint c0[2], c1[2];
+        triCells(t_id, c0, c1);
+        for(uint y = c0[1]; y <= c1[1]; y++)
+            for(uint x = c0[0]; x <= c1[0]; x++) offsets[y * res + x + 1]++;
+    }
+    for(uint c = 0; c < res * res; c++) offsets[c + 1] += offsets[c];
+    cell_tris.resize(offsets.back());
+    std::vector<uint> fill(offsets.begin(), offsets.end() - 1);
+    for(uint t_id = 0; t_id < num_tris; t_id++)
+    {
+        uint c0[2], c1[2];
+        triCells(t_id, c0, c1);
+        for(uint y = c0[1]; y <= c1[1]; y++)
+            for(uint x = c0[0]; x <= c1[0]; x++) cell_tris[fill[y * res + x]++] = t_id;
+    }
+
+    // inside/outside each other label, then the same selection as boolIntersection, boolUnion, boolSubtraction and
+    // boolXOR. keep: 0 = discard, 1 = keep, 2 = keep flipped
+    std::vector<uint8_t> keep(num_tris);
+    parallelizable_for(0u, num_tris, [&](uint t_id)
+    {
+        const uint *t = in_tris.data() + 3 * t_id;
+        double p[3];
+        for(uint a = 0; a < 3; a++) p[a] = (in_coords[3 * t[0] + a] + in_coords[3 * t[1] + a] + in_coords[3 * t[2] + a]) / 3.0;
+
+        std::bitset<NBIT> surface, inside;
+        surface[in_labels[t_id]] = true;
+        const uint c = cellOf(p[1], 1) * res + cellOf(p[0], 0);
+        for(uint i = offsets[c]; i < offsets[c + 1]; i++)
+        {
+            const uint o_id = cell_tris[i];
+            if(in_labels[o_id] == in_labels[t_id]) continue;
+
+            const double *v0 = in_coords.data() + 3 * in_tris[3 * o_id];
+            const double *v1 = in_coords.data() + 3 * in_tris[3 * o_id + 1];
+            const double *v2 = in_coords.data() + 3 * in_tris[3 * o_id + 2];
+            const double w0 = (v1[0] - p[0]) * (v2[1] - p[1]) - (v1[1] - p[1]) * (v2[0] - p[0]);
+            const double w1 = (v2[0] - p[0]) * (v0[1] - p[1]) - (v2[1] - p[1]) * (v0[0] - p[0]);
+            const double w2 = (v0[0] - p[0]) * (v1[1] - p[1]) - (v0[1] - p[1]) * (v1[0] - p[0]);
+            const double area = w0 + w1 + w2;
+            if(area == 0 || !((w0 >= 0 && w1 >= 0 && w2 >= 0) || (w0 <= 0 && w1 <= 0 && w2 <= 0))) continue;
+
+            // the ray goes up from p
+            if((w0 * v0[2] + w1 * v1[2] + w2 * v2[2]) / area > p[2]) inside.flip(in_labels[o_id]);
+        }
+
+        bool k = false, flip = false;
+        if(op == INTERSECTION)     k = (surface ^ inside).count() == num_labels;
+        else if(op == UNION)       k = inside.none();
+        else if(op == SUBTRACTION)
+        {
+            k = surface[minuend] ? inside.none() : (inside[minuend] && inside.count() == 1);
+            flip = !surface[minuend];
+        }
+        else if(op == XOR)
+        {
+            k = inside.none() || (surface ^ inside).count() == num_labels;
+            flip = inside.any();
+        }
+        keep[t_id] = k ? (flip ? 2 : 1) : 0;
+    });
+
+    // output, with the vertices compacted as in computeFinalExplicitResult
+    std::vector<int> vertex_index(in_coords.size() / 3, -1);
+    uint num_vertices = 0;
+    bool_tris.clear();
+    bool_labels.clear();
+    for(uint t_id = 0; t_id < num_tris; t_id++)
+    {
+        if(!keep[t_id]) continue;
+        uint t[3] = { in_tris[3 * t_id], in_tris[3 * t_id + 1], in_tris[3 * t_id + 2] };
+        if(keep[t_id] == 2) std::swap(t[0], t[2]); // as StaticTrimesh::flipTri
+        for(uint v_id : t)
+        {
+            if(vertex_index[v_id] == -1) vertex_index[v_id] = num_vertices++;
+            bool_tris.push_back(vertex_index[v_id]);
+        }
+        std::bitset<NBIT> surface;
+        surface[in_labels[t_id]] = true;
+        bool_labels.push_back(surface);
+    }
+    bool_coords.resize(3 * num_vertices);
+    for(uint v_id = 0; v_id < vertex_index.size(); v_id++)
+        if(vertex_index[v_id] != -1) std::copy_n(in_coords.data() + 3 * v_id, 3, bool_coords.data() + 3 * vertex_index[v_id]);
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline void computeLabelledArrangement(const std::vector<double> &in_coords, const std::vector<uint> &in_tris,
+                                       const std::vector<uint> &in_labels, LabelledArrangement &arr, PipelineStats &stats,
+                                       const PipelineOptions &options)
+{
+    initFPU();
+
+    stats.arena = &arr.arena;
+
+    customArrangementPipeline(in_coords, in_tris, in_labels, arr.in_tris, arr.in_labels, arr.arena, arr.verts,
+                              arr.out_tris, arr.labels, arr.octree, arr.dupl_triangles, stats, false, options);
+
+    stats.startStage();
+    StaticTrimesh &tm = arr.tm.emplace(arr.verts, arr.out_tris, ENABLE_MULTITHREADING);
+    stats.endStage(STAGE_MESH_BUILD, tm.numTris(), tm.numVerts(), tm.memoryFootprint());
+
+    labelArrangement(tm, arr.verts, arr.in_tris, arr.in_labels, arr.dupl_triangles, arr.labels, arr.patches, arr.octree, stats);
+
+    stats.arena = nullptr;
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline void extractBooleanOp(LabelledArrangement &arr, const BoolOp &op, std::vector<double> &bool_coords, std::vector<uint> &bool_tris,
+                             std::vector< std::bitset<NBIT>> &bool_labels, PipelineStats &stats, uint minuend,
+                             bool merge_coplanar)
+{
+    assert(arr.tm && "arrangement not computed");
+    StaticTrimesh &tm = *arr.tm;
+
+    // undo the flips of the previous extraction: flipTri swaps the first and the last vertex of the triangle
+    for(uint t_id = 0; t_id < tm.numTris(); t_id++)
+        if(tm.triVertID(t_id, 0) != arr.out_tris[3 * t_id]) tm.flipTri(t_id);
+
+    stats.arena = &arr.arena;
+    selectAndExtractBooleanOp(tm, arr.labels, op, bool_coords, bool_tris, bool_labels, stats, minuend, merge_coplanar);
+    stats.arena = nullptr;
+}
 
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -125,7 +424,8 @@ inline void booleanPipeline(const std::vector<double> &in_coords, const std::vec
 inline void customArrangementPipeline(const std::vector<double> &in_coords, const std::vector<uint> &in_tris, const std::vector<uint> &in_labels,
                                       std::vector<uint> &arr_in_tris, std::vector< std::bitset<NBIT>> &arr_in_labels,
                                       point_arena& arena, std::vector<genericPoint *> &vertices, std::vector<uint> &arr_out_tris, Labels &labels,
-                                      cinolib::Octree &octree, std::vector<DuplTriInfo> &dupl_triangles, bool parallel)
+                                      cinolib::Octree &octree, std::vector<DuplTriInfo> &dupl_triangles, PipelineStats &stats, bool parallel,
+                                      const PipelineOptions &options)
 {
     arr_in_labels.resize(in_labels.size());
     std::bitset<NBIT> mask;
@@ -139,170 +439,211 @@ inline void customArrangementPipeline(const std::vector<double> &in_coords, cons
     labels.num = mask.count();
 
     initFPU();
-    double multiplier = computeMultiplier(in_coords);
+    double multiplier;
+    std::vector<double> snapped_coords;
+    if(options.snap_bits)
+    {
+        multiplier = computeLatticeMultiplier(in_coords, options.snap_bits);
+        snapped_coords = in_coords;
+        snapToLattice(snapped_coords, multiplier, parallel);
+    }
+    else multiplier = computeMultiplier(in_coords);
 
-    mergeDuplicatedVertices(in_coords, in_tris, arena, vertices, arr_in_tris, parallel);
+    const std::vector<double> &coords = options.snap_bits ? snapped_coords : in_coords;
 
+    stats.startStage();
+    mergeDuplicatedVertices(coords, in_tris, arena, vertices, arr_in_tris, parallel, options.snap_bits ? 0 : options.num_welded_verts);
+    stats.endStage(STAGE_VERTEX_MERGE, static_cast<uint>(arr_in_tris.size() / 3), static_cast<uint>(vertices.size()));
+
+    stats.startStage();
     customRemoveDegenerateAndDuplicatedTriangles(vertices, arr_in_tris, arr_in_labels, dupl_triangles, parallel);
+    stats.endStage(STAGE_DEGENERATE_REMOVAL, static_cast<uint>(arr_in_tris.size() / 3), static_cast<uint>(vertices.size()));
 
+    stats.startStage();
     TriangleSoup ts(arena, vertices, arr_in_tris, arr_in_labels, multiplier, parallel);
+    stats.endStage(STAGE_TRIANGLE_SOUP, ts.numTris(), ts.numVerts());
 
+    stats.startStage();
     AuxiliaryStructure g;
-    customDetectIntersections(ts, g.intersectionList(), octree);
+    customDetectIntersections(ts, g.intersectionList(), octree, stats.progress);
+    stats.endStage(STAGE_BROAD_PHASE, ts.numTris(), ts.numVerts());
+    if(stats.progress) stats.progress->countPairs(g.intersectionList().size());
 
+    stats.startStage();
     g.initFromTriangleSoup(ts);
 
-    classifyIntersections(ts, arena, g);
+    classifyIntersections(ts, arena, g, stats.progress);
+    stats.endStage(STAGE_CLASSIFICATION, ts.numTris(), ts.numVerts(), g.memoryFootprint());
 
-    triangulation(ts, arena, g, arr_out_tris, labels.surface, parallel);
+    stats.startStage();
+    triangulation(ts, arena, g, arr_out_tris, labels.surface, parallel, stats.progress);
     ts.appendJollyPoints();
+    stats.endStage(STAGE_TRIANGULATION, static_cast<uint>(arr_out_tris.size() / 3), ts.numVerts());
 
     labels.inside.resize(arr_out_tris.size() / 3);
 }
 
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-void customRemoveDegenerateAndDuplicatedTriangles(const std::vector<genericPoint *> &verts, std::vector<uint> &tris,
-                                                  std::vector<std::bitset<NBIT>> &labels, std::vector<DuplTriInfo> &dupl_triangles,
-                                                  bool parallel)
+/* semi-static filter for the colinearity test of blocks of DEGENERACY_BLOCK triangles. The three 2d projections
+ * of each triangle are evaluated in floating point lane by lane (the loops have no branches, so they are
+ * vectorized with the SSE2/AVX2/simd128 target flags), and a triangle is certainly not degenerate as soon as one
+ * of the projected areas is larger than its error bound. Only the uncertain lanes go through the exact predicate */
+inline void findDegenerateTriangles(const std::vector<genericPoint *> &verts, const std::vector<uint> &tris,
+                                    std::vector<uint8_t> &degenerate, bool parallel)
 {
-    if(parallel)
-    {
-        using vec3i = std::array<uint, 3>;
-        uint num_orig_tris = static_cast<uint>(tris.size() / 3);
-        vec3i* data_orig_tris = (vec3i*)tris.data();
+    constexpr uint DEGENERACY_BLOCK = 8;
+    // twice the bound of Shewchuk's orient2d stage A, so that it also holds with directed rounding
+    constexpr double ERR_BOUND = 4.0 * std::numeric_limits<double>::epsilon();
+    // below this magnitude the products may underflow and their error is no longer relative
+    constexpr double MIN_SUM = 1e-300;
 
-        // compute colinear
-        auto colinear = vector<bool>(num_orig_tris, false);
-        parallelizable_for((uint)0, num_orig_tris, [data_orig_tris, &colinear, &verts](uint t_id) {
-            auto& t = data_orig_tris[t_id];
-            colinear[t_id] = cinolib::points_are_colinear_3d(
-                verts[t[0]]->toExplicit3D().ptr(),
-                verts[t[1]]->toExplicit3D().ptr(),
-                verts[t[2]]->toExplicit3D().ptr());
-        });
+    uint num_tris = static_cast<uint>(tris.size() / 3);
+    uint num_blocks = (num_tris + DEGENERACY_BLOCK - 1) / DEGENERACY_BLOCK;
+    degenerate.resize(num_tris);
 
-        // loop as before by use simpler way
-        uint t_off = 0, l_off = 0;
+    auto test_block = [&](uint b_id)
+    {
+        uint t_start = b_id * DEGENERACY_BLOCK;
+        uint t_count = std::min(DEGENERACY_BLOCK, num_tris - t_start);
 
-        phmap::flat_hash_map < std::array<uint, 3>, std::pair<uint, uint> > tris_map; // tri_vertices -> <l_off, t_off>
-        tris_map.reserve(num_orig_tris);
+        double p[3][3][DEGENERACY_BLOCK] = {}; // vertex, coordinate, lane
+        for(uint i = 0; i < t_count; i++)
+            for(uint v = 0; v < 3; v++)
+            {
+                const explicitPoint3D &pt = verts[tris[3 * (t_start + i) + v]]->toExplicit3D();
+                p[v][0][i] = pt.X(); p[v][1][i] = pt.Y(); p[v][2][i] = pt.Z();
+            }
 
-        for(uint t_id = 0; t_id < num_orig_tris; t_id++)
+        uint8_t certain[DEGENERACY_BLOCK] = {};
+        for(uint u = 0; u < 3; u++) // projection dropping the coordinate (u + 2) % 3
         {
-            uint v0_id = tris[(3 * t_id)];
-            uint v1_id = tris[(3 * t_id) +1];
-            uint v2_id = tris[(3 * t_id) +2];
-            std::bitset<NBIT> l = labels[t_id];
-
-            if(!colinear[t_id]) // good triangle
+            uint w = (u + 1) % 3;
+            for(uint i = 0; i < DEGENERACY_BLOCK; i++)
             {
-                std::array<uint, 3> tri = {v0_id, v1_id, v2_id};
-                std::sort(tri.begin(), tri.end());
-
-                auto ins= tris_map.insert({tri, std::make_pair(l_off, t_off)});
-
-                if(ins.second) // first time for tri v0, v1, v2
-                {
-                    labels[l_off] = l;
-                    l_off++;
+                double l = (p[0][u][i] - p[2][u][i]) * (p[1][w][i] - p[2][w][i]);
+                double r = (p[0][w][i] - p[2][w][i]) * (p[1][u][i] - p[2][u][i]);
+                double sum = std::fabs(l) + std::fabs(r);
+                certain[i] |= (std::fabs(l - r) > ERR_BOUND * sum) & (sum > MIN_SUM);
+            }
+        }
 
-                    tris[t_off] = v0_id, tris[t_off +1] = v1_id, tris[t_off +2] = v2_id;
-                    t_off += 3;
-                }
-                else // triangle already present
-                {
-                    uint pos = ins.first->second.first;
-                    labels[pos] |= l; // label for duplicates
-                }
+        for(uint i = 0; i < t_count; i++)
+        {
+            const uint *t = &tris[3 * (t_start + i)];
+            if(certain[i])                                        degenerate[t_start + i] = false;
+            else if(t[0] == t[1] || t[1] == t[2] || t[0] == t[2]) degenerate[t_start + i] = true;
+            else degenerate[t_start + i] = cinolib::points_are_colinear_3d(verts[t[0]]->toExplicit3D().ptr(),
+                                                                           verts[t[1]]->toExplicit3D().ptr(),
+                                                                           verts[t[2]]->toExplicit3D().ptr());
+        }
+    };
 
-                if(!ins.second) // triangle already present -> save info about duplicates
-                {
-                    uint orig_tri_off = ins.first->second.second;
+    if(parallel)
+        parallelizable_for((uint)0, num_blocks, test_block);
+    else
+        for(uint b_id = 0; b_id < num_blocks; b_id++) test_block(b_id);
+}
 
-                    uint mesh_l = bitsetToUint(l);
-                    assert(mesh_l >= 0);
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-                    uint curr_tri_verts[] = {v0_id, v1_id, v2_id};
-                    uint orig_tri_verts[] ={tris[orig_tri_off], tris[orig_tri_off +1], tris[orig_tri_off +2]};
+/* degenerate triangles are dropped and duplicated triangles (same vertices, in any order) are found by sorting
+ * the sorted vertex triplets of the good triangles together with their ids, so that all the copies of a triangle
+ * are contiguous and the first one in input order leads its run. The triangle list is then compacted in input
+ * order: the first copy is kept and the others are reported in dupl_triangles, as the hash map version did */
+void customRemoveDegenerateAndDuplicatedTriangles(const std::vector<genericPoint *> &verts, std::vector<uint> &tris,
+                                                  std::vector<std::bitset<NBIT>> &labels, std::vector<DuplTriInfo> &dupl_triangles,
+                                                  bool parallel)
+{
+    uint num_orig_tris = static_cast<uint>(tris.size() / 3);
 
-                    bool w = consistentWinding(curr_tri_verts, orig_tri_verts);
+    std::vector<uint8_t> degenerate;
+    findDegenerateTriangles(verts, tris, degenerate, parallel);
 
-                    dupl_triangles.push_back({orig_tri_off / 3, // original triangle id
-                                            static_cast<uint>(mesh_l), // label of the actual triangle
-                                            w}); // winding with respect to the triangle stored in mesh (true -> same, false -> opposite)
-                }
-            }
-        }
+    std::vector<uint> good_tris;
+    good_tris.reserve(num_orig_tris);
+    for(uint t_id = 0; t_id < num_orig_tris; t_id++)
+        if(!degenerate[t_id]) good_tris.push_back(t_id);
 
-        tris.resize(t_off);
-        labels.resize(l_off);
-    } else {
-        uint num_orig_tris = static_cast<uint>(tris.size() / 3);
-        uint t_off = 0, l_off = 0;
+    using TriKey = std::pair<std::array<uint, 3>, uint>; // sorted tri vertices, t_id
+    std::vector<TriKey> keys(good_tris.size());
 
-        phmap::flat_hash_map < std::array<uint, 3>, std::pair<uint, uint> > tris_map; // tri_vertices -> <l_off, t_off>
-        tris_map.reserve(num_orig_tris);
+    auto build_key = [&](uint i)
+    {
+        uint t_id = good_tris[i];
+        std::array<uint, 3> tri = {tris[3 * t_id], tris[3 * t_id +1], tris[3 * t_id +2]};
+        std::sort(tri.begin(), tri.end());
+        keys[i] = {tri, t_id};
+    };
 
-        for(uint t_id = 0; t_id < num_orig_tris; t_id++)
-        {
-            uint v0_id = tris[(3 * t_id)];
-            uint v1_id = tris[(3 * t_id) +1];
-            uint v2_id = tris[(3 * t_id) +2];
-            std::bitset<NBIT> l = labels[t_id];
+    if(parallel)
+    {
+        #if ENABLE_MULTITHREADING
+        tbb::parallel_for((uint)0, (uint)keys.size(), build_key);
+        tbb::parallel_sort(keys.begin(), keys.end());
+        #endif
+    }
+    else
+    {
+        for(uint i = 0; i < (uint)keys.size(); i++) build_key(i);
+        std::sort(keys.begin(), keys.end());
+    }
 
-            const bool pointAreColinear = cinolib::points_are_colinear_3d(verts[v0_id]->toExplicit3D().ptr(),
-                verts[v1_id]->toExplicit3D().ptr(),
-                verts[v2_id]->toExplicit3D().ptr());
+    // first_copy[t_id] -> id of the first triangle with the same vertices as t_id (t_id itself if it is unique)
+    std::vector<uint> first_copy(num_orig_tris);
+    for(uint i = 0; i < (uint)keys.size(); i++)
+    {
+        bool run_start = (i == 0 || keys[i].first != keys[i -1].first);
+        first_copy[keys[i].second] = run_start ? keys[i].second : first_copy[keys[i -1].second];
+    }
 
-            if(!pointAreColinear) // good triangle
-            {
-                std::array<uint, 3> tri = {v0_id, v1_id, v2_id};
-                std::sort(tri.begin(), tri.end());
+    std::vector<uint> new_tri_id(num_orig_tris); // valid for the triangles that are kept
+    uint t_off = 0, l_off = 0;
 
-                auto ins= tris_map.insert({tri, std::make_pair(l_off, t_off)});
+    for(uint t_id : good_tris)
+    {
+        uint v0_id = tris[(3 * t_id)];
+        uint v1_id = tris[(3 * t_id) +1];
+        uint v2_id = tris[(3 * t_id) +2];
+        std::bitset<NBIT> l = labels[t_id];
 
-                if(ins.second) // first time for tri v0, v1, v2
-                {
-                    labels[l_off] = l;
-                    l_off++;
+        if(first_copy[t_id] == t_id) // first time for tri v0, v1, v2
+        {
+            new_tri_id[t_id] = l_off;
 
-                    tris[t_off] = v0_id, tris[t_off +1] = v1_id, tris[t_off +2] = v2_id;
-                    t_off += 3;
-                }
-                else // triangle already present
-                {
-                    uint pos = ins.first->second.first;
-                    labels[pos] |= l; // label for duplicates
-                }
+            labels[l_off] = l;
+            l_off++;
 
-                if(!ins.second) // triangle already present -> save info about duplicates
-                {
-                    uint orig_tri_off = ins.first->second.second;
+            tris[t_off] = v0_id, tris[t_off +1] = v1_id, tris[t_off +2] = v2_id;
+            t_off += 3;
+        }
+        else // triangle already present -> merge the labels and save info about duplicates
+        {
+            uint orig_t_id = new_tri_id[first_copy[t_id]];
+            labels[orig_t_id] |= l; // label for duplicates
 
-                    uint mesh_l = bitsetToUint(l);
-                    assert(mesh_l >= 0);
+            uint mesh_l = bitsetToUint(l);
+            assert(mesh_l >= 0);
 
-                    uint curr_tri_verts[] = {v0_id, v1_id, v2_id};
-                    uint orig_tri_verts[] ={tris[orig_tri_off], tris[orig_tri_off +1], tris[orig_tri_off +2]};
+            uint curr_tri_verts[] = {v0_id, v1_id, v2_id};
+            uint orig_tri_verts[] = {tris[3 * orig_t_id], tris[3 * orig_t_id +1], tris[3 * orig_t_id +2]};
 
-                    bool w = consistentWinding(curr_tri_verts, orig_tri_verts);
+            bool w = consistentWinding(curr_tri_verts, orig_tri_verts);
 
-                    dupl_triangles.push_back({orig_tri_off / 3, // original triangle id
-                                            static_cast<uint>(mesh_l), // label of the actual triangle
-                                            w}); // winding with respect to the triangle stored in mesh (true -> same, false -> opposite)
-                }
-            }
+            dupl_triangles.push_back({orig_t_id, // original triangle id
+                                      static_cast<uint>(mesh_l), // label of the actual triangle
+                                      w}); // winding with respect to the triangle stored in mesh (true -> same, false -> opposite)
         }
-
-        tris.resize(t_off);
-        labels.resize(l_off);
     }
+
+    tris.resize(t_off);
+    labels.resize(l_off);
 }
 
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-inline void customDetectIntersections(const TriangleSoup &ts, std::vector<std::pair<uint, uint> > &intersection_list, cinolib::Octree &o)
+inline void customDetectIntersections(const TriangleSoup &ts, std::vector<std::pair<uint, uint> > &intersection_list, cinolib::Octree &o,
+                                      ProgressMonitor *progress)
 {
     std::vector<cinolib::vec3d> verts(ts.numVerts());
 
@@ -316,8 +657,12 @@ inline void customDetectIntersections(const TriangleSoup &ts, std::vector<std::p
     #if ENABLE_MULTITHREADING
         tbb::spin_mutex mutex;
     #endif
+    // a leaf holds up to a few hundred pairs of triangles to test, hence the checkpoints every few leaves
+    constexpr uint leaves_per_checkpoint = 16;
+    if(progress) progress->beginItems(o.leaves.size());
     parallelizable_for((uint)0, (uint)o.leaves.size(), [&](uint i)
     {
+        if(progress && i % leaves_per_checkpoint == 0 && i > 0) progress->advance(leaves_per_checkpoint);
         auto & leaf = o.leaves[i];
         if(leaf->item_indices.empty()) return;
         for(uint j=0;   j<leaf->item_indices.size()-1; ++j)
@@ -385,37 +730,23 @@ inline void addDuplicateTrisInfoInStructures(const std::vector<DuplTriInfo> &dup
 
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-inline void computeAllPatches(FastTrimesh &tm, const Labels &labels, std::vector<phmap::flat_hash_set<uint>> &patches, bool parallel)
+inline void computeAllPatches(StaticTrimesh &tm, const Labels &labels, std::vector<phmap::flat_hash_set<uint>> &patches)
 {
-    if(parallel) {
-        tm.resetVerticesInfo();
-        auto adjT2E = tm.adjT2EAll(parallel);
+    tm.resetVerticesInfo();
 
-        for(uint t_id = 0; t_id < tm.numTris(); t_id++)
-        {
-            if(tm.triInfo(t_id) != 1)
-            {
-                patches.emplace_back();
-                computeSinglePatch(tm, t_id, labels, patches.back(), adjT2E);
-            }
-        }
-    } else {
-        tm.resetVerticesInfo();
-
-        for(uint t_id = 0; t_id < tm.numTris(); t_id++)
+    for(uint t_id = 0; t_id < tm.numTris(); t_id++)
+    {
+        if(tm.triInfo(t_id) != 1)
         {
-            if(tm.triInfo(t_id) != 1)
-            {
-                patches.emplace_back();
-                computeSinglePatch(tm, t_id, labels, patches.back());
-            }
+            patches.emplace_back();
+            computeSinglePatch(tm, t_id, labels, patches.back());
         }
     }
 }
 
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-inline void computeSinglePatch(FastTrimesh &tm, uint seed_t, const Labels &labels, phmap::flat_hash_set<uint> &patch)
+inline void computeSinglePatch(StaticTrimesh &tm, uint seed_t, const Labels &labels, phmap::flat_hash_set<uint> &patch)
 {
     std::bitset<NBIT> ref_l = labels.surface[seed_t];
 
@@ -453,47 +784,9 @@ inline void computeSinglePatch(FastTrimesh &tm, uint seed_t, const Labels &label
     }
 }
 
-inline void computeSinglePatch(FastTrimesh &tm, uint seed_t, const Labels &labels, phmap::flat_hash_set<uint> &patch, const std::vector<std::array<uint, 3>>& adjT2E)
-{
-    std::bitset<NBIT> ref_l = labels.surface[seed_t];
-
-    std::stack<uint> tris_stack;
-    tris_stack.push(seed_t);
-
-    while(!tris_stack.empty())
-    {
-        uint curr_t = tris_stack.top();
-        tris_stack.pop();
-
-        tm.setTriInfo(curr_t, 1); // set triangle as visited
-        patch.insert(curr_t);
-
-        for(uint e_id : adjT2E[curr_t])
-        {
-            if(tm.edgeIsManifold(e_id))
-            {
-                for(uint t_id : tm.adjE2T(e_id))
-                {
-                    if(t_id != curr_t && tm.triInfo(t_id) != 1)
-                    {
-                        assert(labels.surface[t_id] == ref_l);
-                        tris_stack.push(t_id);
-                    }
-                }
-            }
-            else // e_id is not manifold -> stop flooding
-            {
-                // we set the vertices in the patch border with 1 (useful for ray computation funcion)
-                tm.setVertInfo(tm.edgeVertID(e_id, 0), 1);
-                tm.setVertInfo(tm.edgeVertID(e_id, 1), 1);
-            }
-        }
-    }
-}
-
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-inline void findRayEndpoints(const FastTrimesh &tm, const phmap::flat_hash_set<uint> &patch, const cinolib::vec3d &max_coords, Ray &ray)
+inline void findRayEndpoints(const StaticTrimesh &tm, const phmap::flat_hash_set<uint> &patch, const cinolib::vec3d &max_coords, Ray &ray)
 {
     // check for an explicit point (all operations with explicits are faster)
     int v_id = -1;
@@ -515,13 +808,16 @@ inline void findRayEndpoints(const FastTrimesh &tm, const phmap::flat_hash_set<u
     }
 
     int tri_counter = 0;
+    const std::vector<double> &approx = tm.approxCoords();
     // parse triangles with all implicit points
     for(uint t_id : patch)
     {
-        double x0, x1, x2, y0, y1, y2, z0, z1, z2;
-        tm.triVert(t_id, 0)->getApproxXYZCoordinates(x0, y0, z0);
-        tm.triVert(t_id, 1)->getApproxXYZCoordinates(x1, y1, z1);
-        tm.triVert(t_id, 2)->getApproxXYZCoordinates(x2, y2, z2);
+        const double *c0 = approx.data() + 3 * tm.triVertID(t_id, 0);
+        const double *c1 = approx.data() + 3 * tm.triVertID(t_id, 1);
+        const double *c2 = approx.data() + 3 * tm.triVertID(t_id, 2);
+        double x0 = c0[0], y0 = c0[1], z0 = c0[2];
+        double x1 = c1[0], y1 = c1[1], z1 = c1[2];
+        double x2 = c2[0], y2 = c2[1], z2 = c2[2];
 
         explicitPoint3D tv0(x0, y0, z0), tv1(x1, y1, z1), tv2(x2, y2, z2);
         if(!genericPoint::misaligned(tv0, tv1, tv2)) continue;
@@ -610,7 +906,7 @@ inline bool intersects_box(const cinolib::Octree& tree, const cinolib::AABB & b,
     return !ids.empty();
 }
 
-inline void computeInsideOut(const FastTrimesh &tm, const std::vector<phmap::flat_hash_set<uint>> &patches, const cinolib::Octree &octree,
+inline void computeInsideOut(const StaticTrimesh &tm, const std::vector<phmap::flat_hash_set<uint>> &patches, const cinolib::Octree &octree,
                              const std::vector<genericPoint *> &in_verts, const std::vector<uint> &in_tris,
                              const std::vector<std::bitset<NBIT>> &in_labels, const cinolib::vec3d &max_coords, Labels &labels)
 {
@@ -1140,7 +1436,7 @@ inline bool checkIntersectionInsideTriangle3DImplPoints(const Ray &ray, const ge
 inline void sortIntersectedTrisAlongX(const Ray &ray, const std::vector<genericPoint*> &in_verts,
                                       const std::vector<uint> &in_tris, std::vector<uint> &inters_tris)
 {
-    phmap::btree_set< std::pair<genericPoint*, uint>, less_than_GP_on_X > inters_set; // <- <t_id, impl_point>
+    phmap::btree_set< std::pair<implicitPoint3D_LPI*, uint>, less_than_LPI_on_X > inters_set; // <- <t_id, impl_point>
     std::vector<implicitPoint3D_LPI> arena;
     arena.reserve(inters_tris.size());
 
@@ -1150,7 +1446,7 @@ inline void sortIntersectedTrisAlongX(const Ray &ray, const std::vector<genericP
         uint v1_id = in_tris[3 * t_id +1];
         uint v2_id = in_tris[3 * t_id +2];
 
-        std::pair<genericPoint*, uint> pair;
+        std::pair<implicitPoint3D_LPI*, uint> pair;
         pair.first = &arena.emplace_back(ray.v0, ray.v1,in_verts[v0_id]->toExplicit3D(),
                                          in_verts[v1_id]->toExplicit3D(), in_verts[v2_id]->toExplicit3D());
         pair.second = t_id;
@@ -1168,20 +1464,28 @@ inline void sortIntersectedTrisAlongX(const Ray &ray, const std::vector<genericP
         const genericPoint *tv1 = in_verts[ray.tv[1]];
         const genericPoint *tv2 = in_verts[ray.tv[2]];
 
+        // the type of the triangle vertices is checked once here instead of at each orient3D in the loops below
+        const bool explicit_tv = tv0->isExplicit3D() && tv1->isExplicit3D() && tv2->isExplicit3D();
+        auto orient = [&](const implicitPoint3D_LPI &p)
+        {
+            if(explicit_tv) return genericPoint::orient3D(tv0->toExplicit3D(), tv1->toExplicit3D(), tv2->toExplicit3D(), p);
+            return genericPoint::orient3D(*tv0, *tv1, *tv2, p);
+        };
+
         if(genericPoint::orient3D(*tv0, *tv1, *tv2, ray.v1) > 0)
         {
-            while(curr_int != inters_set.end() && genericPoint::orient3D(*tv0, *tv1, *tv2, *curr_int->first) < 0)
+            while(curr_int != inters_set.end() && orient(*curr_int->first) < 0)
                 curr_int++;
         }
         else
         {
-            while(curr_int != inters_set.end() && genericPoint::orient3D(*tv0, *tv1, *tv2, *curr_int->first) > 0)
+            while(curr_int != inters_set.end() && orient(*curr_int->first) > 0)
                 curr_int++;
         }
     }
     else // the ray is composed of 2 real explicit points
     {
-        while(curr_int != inters_set.end() && genericPoint::lessThanOnX(*curr_int->first, ray.v0) < 0)
+        while(curr_int != inters_set.end() && lessThanOnX_IE(*curr_int->first, ray.v0.X()) < 0)
             curr_int++;
     }
 
@@ -1198,7 +1502,7 @@ inline void sortIntersectedTrisAlongX(const Ray &ray, const std::vector<genericP
 inline void sortIntersectedTrisAlongY(const Ray &ray, const std::vector<genericPoint*> &in_verts,
                                       const std::vector<uint> &in_tris, std::vector<uint> &inters_tris)
 {
-    phmap::btree_set< std::pair<genericPoint*, uint>, less_than_GP_on_Y > inters_set; // <- <t_id, impl_point>
+    phmap::btree_set< std::pair<implicitPoint3D_LPI*, uint>, less_than_LPI_on_Y > inters_set; // <- <t_id, impl_point>
     std::vector<implicitPoint3D_LPI> arena;
     arena.reserve(inters_tris.size());
 
@@ -1208,7 +1512,7 @@ inline void sortIntersectedTrisAlongY(const Ray &ray, const std::vector<genericP
         uint v1_id = in_tris[3 * t_id +1];
         uint v2_id = in_tris[3 * t_id +2];
 
-        std::pair<genericPoint*, uint> pair;
+        std::pair<implicitPoint3D_LPI*, uint> pair;
         pair.first = &arena.emplace_back(ray.v0, ray.v1,in_verts[v0_id]->toExplicit3D(), in_verts[v1_id]->toExplicit3D(), in_verts[v2_id]->toExplicit3D());
         pair.second = t_id;
 
@@ -1225,20 +1529,28 @@ inline void sortIntersectedTrisAlongY(const Ray &ray, const std::vector<genericP
         const genericPoint *tv1 = in_verts[ray.tv[1]];
         const genericPoint *tv2 = in_verts[ray.tv[2]];
 
+        // the type of the triangle vertices is checked once here instead of at each orient3D in the loops below
+        const bool explicit_tv = tv0->isExplicit3D() && tv1->isExplicit3D() && tv2->isExplicit3D();
+        auto orient = [&](const implicitPoint3D_LPI &p)
+        {
+            if(explicit_tv) return genericPoint::orient3D(tv0->toExplicit3D(), tv1->toExplicit3D(), tv2->toExplicit3D(), p);
+            return genericPoint::orient3D(*tv0, *tv1, *tv2, p);
+        };
+
         if(genericPoint::orient3D(*tv0, *tv1, *tv2, ray.v1) > 0)
         {
-            while(curr_int != inters_set.end() && genericPoint::orient3D(*tv0, *tv1, *tv2, *curr_int->first) < 0)
+            while(curr_int != inters_set.end() && orient(*curr_int->first) < 0)
                 curr_int++;
         }
         else
         {
-            while(curr_int != inters_set.end() && genericPoint::orient3D(*tv0, *tv1, *tv2, *curr_int->first) > 0)
+            while(curr_int != inters_set.end() && orient(*curr_int->first) > 0)
                 curr_int++;
         }
     }
     else // the ray is composed of 2 real explicit points
     {
-        while(curr_int != inters_set.end() && genericPoint::lessThanOnY(*curr_int->first, ray.v0) < 0)
+        while(curr_int != inters_set.end() && lessThanOnY_IE(*curr_int->first, ray.v0.Y()) < 0)
             curr_int++;
     }
 
@@ -1255,7 +1567,7 @@ inline void sortIntersectedTrisAlongY(const Ray &ray, const std::vector<genericP
 inline void sortIntersectedTrisAlongZ(const Ray &ray, const std::vector<genericPoint*> &in_verts,
                                       const std::vector<uint> &in_tris, std::vector<uint> &inters_tris)
 {
-    phmap::btree_set< std::pair<genericPoint*, uint>, less_than_GP_on_Z> inters_set; // <- <t_id, impl_point>
+    phmap::btree_set< std::pair<implicitPoint3D_LPI*, uint>, less_than_LPI_on_Z> inters_set; // <- <t_id, impl_point>
     std::vector<implicitPoint3D_LPI> arena;
     arena.reserve(inters_tris.size());
 
@@ -1265,7 +1577,7 @@ inline void sortIntersectedTrisAlongZ(const Ray &ray, const std::vector<genericP
         uint v1_id = in_tris[3 * t_id +1];
         uint v2_id = in_tris[3 * t_id +2];
 
-        std::pair<genericPoint*, uint> pair;
+        std::pair<implicitPoint3D_LPI*, uint> pair;
         pair.first = &arena.emplace_back(ray.v0, ray.v1,in_verts[v0_id]->toExplicit3D(), in_verts[v1_id]->toExplicit3D(), in_verts[v2_id]->toExplicit3D());
         pair.second = t_id;
 
@@ -1282,20 +1594,28 @@ inline void sortIntersectedTrisAlongZ(const Ray &ray, const std::vector<genericP
         const genericPoint *tv1 = in_verts[ray.tv[1]];
         const genericPoint *tv2 = in_verts[ray.tv[2]];
 
+        // the type of the triangle vertices is checked once here instead of at each orient3D in the loops below
+        const bool explicit_tv = tv0->isExplicit3D() && tv1->isExplicit3D() && tv2->isExplicit3D();
+        auto orient = [&](const implicitPoint3D_LPI &p)
+        {
+            if(explicit_tv) return genericPoint::orient3D(tv0->toExplicit3D(), tv1->toExplicit3D(), tv2->toExplicit3D(), p);
+            return genericPoint::orient3D(*tv0, *tv1, *tv2, p);
+        };
+
         if(genericPoint::orient3D(*tv0, *tv1, *tv2, ray.v1) > 0)
         {
-            while(curr_int != inters_set.end() && genericPoint::orient3D(*tv0, *tv1, *tv2, *curr_int->first) < 0)
+            while(curr_int != inters_set.end() && orient(*curr_int->first) < 0)
                 curr_int++;
         }
         else
         {
-            while(curr_int != inters_set.end() && genericPoint::orient3D(*tv0, *tv1, *tv2, *curr_int->first) > 0)
+            while(curr_int != inters_set.end() && orient(*curr_int->first) > 0)
                 curr_int++;
         }
     }
     else // the ray is composed of 2 real explicit points
     {
-        while(curr_int != inters_set.end() && genericPoint::lessThanOnZ(*curr_int->first, ray.v0) < 0)
+        while(curr_int != inters_set.end() && lessThanOnZ_IE(*curr_int->first, ray.v0.Z()) < 0)
             curr_int++;
     }
 
@@ -1332,7 +1652,7 @@ inline void propagateInnerLabelsOnPatch(const phmap::flat_hash_set<uint> &patch_
 
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-inline void computeFinalExplicitResult(const FastTrimesh &tm, const Labels &labels, uint num_tris_in_final_res,
+inline void computeFinalExplicitResult(const StaticTrimesh &tm, const Labels &labels, uint num_tris_in_final_res,
                                        std::vector<double> &out_coords, std::vector<uint> &out_tris, 
                                        std::vector<std::bitset<NBIT>> &out_label, bool flat_array)
 {
@@ -1361,11 +1681,11 @@ inline void computeFinalExplicitResult(const FastTrimesh &tm, const Labels &labe
         }
 
         // loop over vertices
+        const std::vector<double> &approx = tm.approxCoords();
         out_coords.resize(3 * num_vertices);
         for(uint v_id = 0; v_id < (uint)tm.numVerts(); v_id++) {
             if (vertex_index[v_id] == -1) continue;
-            double* v = out_coords.data() + (3 * vertex_index[v_id]);
-            tm.vert(v_id)->getApproxXYZCoordinates(v[0], v[1], v[2]);
+            std::copy_n(approx.data() + 3 * v_id, 3, out_coords.data() + 3 * vertex_index[v_id]);
         }
 
         // rescale output
@@ -1380,6 +1700,7 @@ inline void computeFinalExplicitResult(const FastTrimesh &tm, const Labels &labe
         uint tri_offset = 0;
 
         double multiplier = tm.vert(tm.numVerts() - 1)->toExplicit3D().X();
+        const std::vector<double> &approx = tm.approxCoords();
 
         for(uint t_id = 0; t_id < tm.numTris(); t_id++)
         {
@@ -1393,13 +1714,7 @@ inline void computeFinalExplicitResult(const FastTrimesh &tm, const Labels &labe
                 auto ins = v_map.insert({v_id[i], fresh_v_id});
 
                 if(ins.second) // vert added
-                {
-                    double x, y, z;
-                    tm.vert(v_id[i])->getApproxXYZCoordinates(x, y, z);
-                    out_coords.push_back(x);
-                    out_coords.push_back(y);
-                    out_coords.push_back(z);
-                }
+                    out_coords.insert(out_coords.end(), approx.data() + 3 * v_id[i], approx.data() + 3 * v_id[i] + 3);
 
                 out_tris[3 * tri_offset + i] = ins.first->second;
             }
@@ -1414,7 +1729,368 @@ inline void computeFinalExplicitResult(const FastTrimesh &tm, const Labels &labe
 
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-inline uint boolIntersection(FastTrimesh &tm, const Labels &labels)
+inline void computeFinalExplicitResult(const StaticTrimesh &tm, std::vector<uint> &tris, std::vector<double> &out_coords)
+{
+    uint num_vertices = 0;
+    std::vector<int> vertex_index(tm.numVerts(), -1);
+    for(uint &v_id : tris)
+    {
+        if(vertex_index[v_id] == -1) vertex_index[v_id] = num_vertices++;
+        v_id = vertex_index[v_id];
+    }
+
+    const std::vector<double> &approx = tm.approxCoords();
+    out_coords.resize(3 * num_vertices);
+    for(uint v_id = 0; v_id < tm.numVerts(); v_id++)
+    {
+        if(vertex_index[v_id] == -1) continue;
+        std::copy_n(approx.data() + 3 * v_id, 3, out_coords.data() + 3 * vertex_index[v_id]);
+    }
+
+    // rescale output
+    double multiplier = tm.vert(tm.numVerts() - 1)->toExplicit3D().X();
+    for(double &c : out_coords) c /= multiplier;
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline void mergeCoplanarRegions(const StaticTrimesh &tm, const Labels &labels, std::vector<uint> &out_tris,
+                                 std::vector<std::bitset<NBIT>> &out_labels)
+{
+    const uint none = std::numeric_limits<uint>::max();
+
+    // the other selected triangle on the edge off of t_id, if the edge has exactly two
+    auto selectedNeighbour = [&](uint t_id, uint off)
+    {
+        uint other = none, count = 0;
+        for(uint n_id : tm.adjE2T(tm.triEdgeID(t_id, off)))
+        {
+            if(tm.triInfo(n_id) == 0) continue;
+            if(n_id != t_id) other = n_id;
+            count++;
+        }
+        return count == 2 ? other : none;
+    };
+
+    // regions, by flood fill of the selected triangles. The ones of region r are region_tris[region_offset[r]...]
+    std::vector<uint> tri_region(tm.numTris(), none), region_offset, region_tris, stack;
+    std::vector<int> region_axis, region_sign; // plane the region is projected on, and turn of its triangles there
+    const std::vector<double> &approx = tm.approxCoords();
+    for(uint seed = 0; seed < tm.numTris(); seed++)
+    {
+        if(tm.triInfo(seed) == 0 || tri_region[seed] != none) continue;
+
+        const uint r = static_cast<uint>(region_offset.size());
+        region_offset.push_back(static_cast<uint>(region_tris.size()));
+
+        // the approximate normal can be wrong on slivers: fall back to the other planes
+        const double *p0 = approx.data() + 3 * tm.triVertID(seed, 0);
+        const double *p1 = approx.data() + 3 * tm.triVertID(seed, 1);
+        const double *p2 = approx.data() + 3 * tm.triVertID(seed, 2);
+        const int n_max = genericPoint::maxComponentInTriangleNormal(p0[0], p0[1], p0[2], p1[0], p1[1], p1[2], p2[0], p2[1], p2[2]);
+        int axis = n_max, sign = 0;
+        for(int i = 0; i < 3 && sign == 0; i++)
+        {
+            axis = (n_max + i) % 3;
+            sign = genericPoint::orient2D(*tm.triVert(seed, 0), *tm.triVert(seed, 1), *tm.triVert(seed, 2), axis);
+        }
+        region_axis.push_back(axis);
+        region_sign.push_back(sign);
+
+        tri_region[seed] = r;
+        stack.push_back(seed);
+        while(!stack.empty())
+        {
+            const uint t_id = stack.back();
+            stack.pop_back();
+            region_tris.push_back(t_id);
+            if(sign == 0) continue; // degenerate triangle, alone in its region
+
+            const uint *t = tm.tri(t_id);
+            for(uint off = 0; off < 3; off++)
+            {
+                const uint n_id = selectedNeighbour(t_id, off);
+                if(n_id == none || tri_region[n_id] != none || labels.surface[n_id] != labels.surface[t_id]) continue;
+
+                // same orientation: n_id runs the edge (t[off], t[off+1]) the other way round
+                const uint *n = tm.tri(n_id);
+                uint k = 0;
+                while(n[k] != t[(off + 1) % 3]) k++;
+                if(n[(k + 1) % 3] != t[off]) continue;
+
+                // same plane, and not folded over t_id
+                if(genericPoint::orient3D(*tm.vert(t[0]), *tm.vert(t[1]), *tm.vert(t[2]), *tm.vert(n[(k + 2) % 3])) != 0) continue;
+                if(genericPoint::orient2D(*tm.vert(n[0]), *tm.vert(n[1]), *tm.vert(n[2]), axis) != sign) continue;
+
+                tri_region[n_id] = r;
+                stack.push_back(n_id);
+            }
+        }
+    }
+    const uint num_regions = static_cast<uint>(region_offset.size());
+    region_offset.push_back(static_cast<uint>(region_tris.size()));
+
+    // vertices that all the regions around them can drop: the ones with no border edge, and the ones inside the
+    // segment of their only two border edges. Either way the triangles of each region around them must form a fan
+    std::vector<uint8_t> removable(tm.numVerts(), 0);
+    parallelizable_for(0u, tm.numVerts(), [&](uint v_id)
+    {
+        std::vector<std::pair<uint, std::pair<uint, uint>>> fan; // region and edge opposite to v_id of its triangles
+        uint ends[2], num_ends = 0;
+        for(uint e_id : tm.adjV2E(v_id))
+        {
+            uint count = 0, region = none;
+            for(uint t_id : tm.adjE2T(e_id))
+            {
+                if(tm.triInfo(t_id) == 0) continue;
+                if(count++ == 0) region = tri_region[t_id];
+                else if(tri_region[t_id] != region) region = none;
+
+                // each triangle is listed once, from the edge it leaves v_id by
+                uint i = 0;
+                while(tm.triVertID(t_id, i) != v_id) i++;
+                if(tm.triEdgeID(t_id, i) == e_id)
+                    fan.push_back({tri_region[t_id], {tm.triVertID(t_id, (i + 1) % 3), tm.triVertID(t_id, (i + 2) % 3)}});
+            }
+            if(count == 0 || (count == 2 && region != none)) continue;
+            if(num_ends == 2) return; // corner
+            ends[num_ends++] = (tm.edgeVertID(e_id, 0) == v_id) ? tm.edgeVertID(e_id, 1) : tm.edgeVertID(e_id, 0);
+        }
+        if(fan.empty() || num_ends == 1) return;
+        if(num_ends == 2 && !genericPoint::pointInInnerSegment(*tm.vert(v_id), *tm.vert(ends[0]), *tm.vert(ends[1]))) return;
+
+        std::sort(fan.begin(), fan.end());
+        std::vector<std::pair<uint, uint>> edges;
+        std::vector<uint> link;
+        for(size_t i = 0, j; i < fan.size(); i = j)
+        {
+            edges.clear();
+            for(j = i; j < fan.size() && fan[j].first == fan[i].first; j++) edges.push_back(fan[j].second);
+
+            bool closed;
+            if(!vertexLink(edges, link, closed) || closed != (num_ends == 0)) return;
+            if(!closed && !((link.front() == ends[0] && link.back() == ends[1]) || (link.front() == ends[1] && link.back() == ends[0])))
+                return;
+        }
+        removable[v_id] = 1;
+    });
+
+    // regions with vertices to drop
+    std::vector<uint> region_active(num_regions, none), active;
+    for(uint r = 0; r < num_regions; r++)
+    {
+        for(uint i = region_offset[r]; i < region_offset[r + 1] && region_active[r] == none; i++)
+            for(uint off = 0; off < 3; off++)
+                if(removable[tm.triVertID(region_tris[i], off)])
+                {
+                    region_active[r] = static_cast<uint>(active.size());
+                    active.push_back(r);
+                    break;
+                }
+    }
+
+    // the vertices are dropped one at a time, by ear clipping the polygon around them
+    std::vector<std::vector<uint>> active_tris(active.size()), active_failed(active.size());
+    auto retriangulate = [&](uint a)
+    {
+        const uint r = active[a];
+        std::vector<uint> &tris = active_tris[a];
+        active_failed[a].clear();
+        tris.clear();
+        for(uint i = region_offset[r]; i < region_offset[r + 1]; i++)
+            tris.insert(tris.end(), tm.tri(region_tris[i]), tm.tri(region_tris[i]) + 3);
+
+        std::vector<uint8_t> alive(tris.size() / 3, 1);
+        phmap::flat_hash_map<uint, std::vector<uint>> v2t; // triangles of each vertex, alive or not
+        std::vector<uint> verts;
+        for(uint i = 0; i < tris.size(); i++)
+        {
+            std::vector<uint> &v_tris = v2t[tris[i]];
+            if(v_tris.empty() && removable[tris[i]]) verts.push_back(tris[i]);
+            v_tris.push_back(i / 3);
+        }
+
+        std::vector<std::pair<uint, uint>> edges;
+        std::vector<uint> star, poly, new_tris;
+        for(uint v_id : verts)
+        {
+            edges.clear();
+            star.clear();
+            for(uint t : v2t[v_id])
+            {
+                if(!alive[t]) continue;
+                uint i = 0;
+                while(tris[3 * t + i] != v_id) i++;
+                edges.push_back({tris[3 * t + (i + 1) % 3], tris[3 * t + (i + 2) % 3]});
+                star.push_back(t);
+            }
+
+            // on a border the link is open, and its ends are the border neighbours of v_id
+            bool closed;
+            new_tris.clear();
+            if(!vertexLink(edges, poly, closed) ||
+               (!closed && !genericPoint::pointInInnerSegment(*tm.vert(v_id), *tm.vert(poly.back()), *tm.vert(poly.front()))) ||
+               !triangulatePolygon(tm, poly, region_axis[r], region_sign[r], new_tris))
+            {
+                active_failed[a].push_back(v_id);
+                continue;
+            }
+
+            for(uint t : star) alive[t] = 0;
+            for(uint i = 0; i < new_tris.size(); i += 3)
+            {
+                const uint t = static_cast<uint>(alive.size());
+                alive.push_back(1);
+                for(uint k = 0; k < 3; k++)
+                {
+                    v2t[new_tris[i + k]].push_back(t);
+                    tris.push_back(new_tris[i + k]);
+                }
+            }
+        }
+
+        uint num_tris = 0;
+        for(uint t = 0; t < alive.size(); t++)
+            if(alive[t]) std::copy_n(tris.data() + 3 * t, 3, tris.data() + 3 * num_tris++);
+        tris.resize(3 * num_tris);
+    };
+
+    // a vertex that a region could not drop stays in all of them: the regions around it are done again
+    std::vector<uint> todo(active.size());
+    std::iota(todo.begin(), todo.end(), 0);
+    while(!todo.empty())
+    {
+        parallelizable_for(0u, static_cast<uint>(todo.size()), [&](uint i) { retriangulate(todo[i]); });
+
+        std::vector<uint8_t> redo(active.size(), 0);
+        for(uint a : todo)
+            for(uint v_id : active_failed[a])
+            {
+                removable[v_id] = 0;
+                for(uint e_id : tm.adjV2E(v_id))
+                    for(uint t_id : tm.adjE2T(e_id))
+                        if(tm.triInfo(t_id) != 0) redo[region_active[tri_region[t_id]]] = 1;
+            }
+
+        todo.clear();
+        for(uint a = 0; a < active.size(); a++)
+            if(redo[a]) todo.push_back(a);
+    }
+
+    out_tris.clear();
+    out_labels.clear();
+    for(uint r = 0; r < num_regions; r++)
+    {
+        if(region_active[r] != none)
+        {
+            const std::vector<uint> &tris = active_tris[region_active[r]];
+            out_tris.insert(out_tris.end(), tris.begin(), tris.end());
+        }
+        else
+        {
+            for(uint i = region_offset[r]; i < region_offset[r + 1]; i++)
+                out_tris.insert(out_tris.end(), tm.tri(region_tris[i]), tm.tri(region_tris[i]) + 3);
+        }
+        out_labels.resize(out_tris.size() / 3, labels.surface[region_tris[region_offset[r]]]);
+    }
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline bool vertexLink(const std::vector<std::pair<uint, uint>> &edges, std::vector<uint> &link, bool &closed)
+{
+    link.clear();
+    if(edges.empty()) return false;
+
+    phmap::flat_hash_map<uint, uint> next, prev;
+    for(const auto &e : edges)
+        if(!next.insert(e).second || !prev.insert({e.second, e.first}).second) return false; // not a fan
+
+    uint start = edges[0].first;
+    closed = true;
+    for(const auto &e : edges)
+    {
+        if(prev.count(e.first) == 0)
+        {
+            start = e.first;
+            closed = false;
+            break;
+        }
+    }
+
+    link.push_back(start);
+    for(auto it = next.find(start); it != next.end() && it->second != start; it = next.find(it->second))
+    {
+        link.push_back(it->second);
+        if(link.size() > edges.size() + 1) return false;
+    }
+
+    // a single chain or cycle goes through all the edges
+    return link.size() == (closed ? edges.size() : edges.size() + 1);
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline bool triangulatePolygon(const StaticTrimesh &tm, std::vector<uint> &poly, int n_max, int sign, std::vector<uint> &out_tris)
+{
+    auto turn = [&](uint a, uint b, uint c) { return genericPoint::orient2D(*tm.vert(a), *tm.vert(b), *tm.vert(c), n_max); };
+
+    // shape of a triangle on the approximate coordinates: twice its area over its longest edge squared
+    const std::vector<double> &approx = tm.approxCoords();
+    auto quality = [&](uint a, uint b, uint c)
+    {
+        const cinolib::vec3d pa(approx.data() + 3 * a), pb(approx.data() + 3 * b), pc(approx.data() + 3 * c);
+        const double longest = std::max({pa.dist_sqrd(pb), pb.dist_sqrd(pc), pc.dist_sqrd(pa)});
+        return longest > 0 ? (pb - pa).cross(pc - pa).norm() / longest : 0;
+    };
+
+    // an ear turns as the polygon, and no other vertex is in its closure
+    auto isEar = [&](size_t i)
+    {
+        const size_t n = poly.size();
+        const uint a = poly[(i + n - 1) % n], b = poly[i], c = poly[(i + 1) % n];
+        if(turn(a, b, c) != sign) return false;
+        for(uint w : poly)
+        {
+            if(w == a || w == b || w == c) continue;
+            if(turn(a, b, w) != -sign && turn(b, c, w) != -sign && turn(c, a, w) != -sign) return false;
+        }
+        return true;
+    };
+
+    if(poly.size() < 3) return false;
+
+    // the best shaped ear first: clipping the first one found makes long fans of slivers
+    std::vector<std::pair<double, size_t>> candidates;
+    while(poly.size() > 3)
+    {
+        const size_t n = poly.size();
+        candidates.clear();
+        for(size_t i = 0; i < n; i++)
+            candidates.push_back({quality(poly[(i + n - 1) % n], poly[i], poly[(i + 1) % n]), i});
+        std::sort(candidates.begin(), candidates.end(), std::greater<>());
+
+        size_t ear = n;
+        for(const auto &c : candidates)
+            if(isEar(c.second))
+            {
+                ear = c.second;
+                break;
+            }
+        if(ear == n) return false;
+
+        out_tris.insert(out_tris.end(), {poly[(ear + n - 1) % n], poly[ear], poly[(ear + 1) % n]});
+        poly.erase(poly.begin() + ear);
+    }
+
+    if(turn(poly[0], poly[1], poly[2]) != sign) return false;
+    out_tris.insert(out_tris.end(), {poly[0], poly[1], poly[2]});
+    return true;
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline uint boolIntersection(StaticTrimesh &tm, const Labels &labels)
 {
     uint num_tris_in_final_solution = 0;
     tm.resetTrianglesInfo();
@@ -1433,7 +2109,7 @@ inline uint boolIntersection(FastTrimesh &tm, const Labels &labels)
 
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-inline uint boolUnion(FastTrimesh &tm, const Labels &labels)
+inline uint boolUnion(StaticTrimesh &tm, const Labels &labels)
 {
     uint num_tris_in_final_solution = 0;
     tm.resetTrianglesInfo();
@@ -1451,20 +2127,20 @@ inline uint boolUnion(FastTrimesh &tm, const Labels &labels)
 }
 
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
-// if more than 2 models -> model 0 - all the others
-inline uint boolSubtraction(FastTrimesh &tm, const Labels &labels)
+// if more than 2 models -> model minuend - all the others
+inline uint boolSubtraction(StaticTrimesh &tm, const Labels &labels, uint minuend)
 {
     uint num_tris_in_final_solution = 0;
     tm.resetTrianglesInfo();
 
     for(uint t_id = 0; t_id < tm.numTris(); t_id++)
     {
-        if(labels.surface[t_id][0] && labels.inside[t_id].count() == 0) // triangle to keep
+        if(labels.surface[t_id][minuend] && labels.inside[t_id].count() == 0) // triangle to keep
         {
             tm.setTriInfo(t_id, 1);
             num_tris_in_final_solution++;
         }
-        else if(!labels.surface[t_id][0] && labels.inside[t_id][0] && labels.inside[t_id].count() == 1)
+        else if(!labels.surface[t_id][minuend] && labels.inside[t_id][minuend] && labels.inside[t_id].count() == 1)
         {
             tm.setTriInfo(t_id, 1);
             num_tris_in_final_solution++;
@@ -1474,7 +2150,7 @@ inline uint boolSubtraction(FastTrimesh &tm, const Labels &labels)
     //fix triangles orientation
     for(uint t_id = 0; t_id < tm.numTris(); t_id++)
     {
-        if(tm.triInfo(t_id) == 1 && labels.surface[t_id][0] != 1)
+        if(tm.triInfo(t_id) == 1 && labels.surface[t_id][minuend] != 1)
             tm.flipTri(t_id);
     }
 
@@ -1483,7 +2159,7 @@ inline uint boolSubtraction(FastTrimesh &tm, const Labels &labels)
 
 //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-inline uint boolXOR(FastTrimesh &tm, const Labels &labels)
+inline uint boolXOR(StaticTrimesh &tm, const Labels &labels)
 {
     uint num_tris_in_final_solution = 0;
     tm.resetTrianglesInfo();
@@ -5,20 +5,66 @@
 
 #include "cmb.h"
 #include "booleans.h"
+#include "arrangement_io.h"
+#include "swept_volume.h"
+#include "io_functions.h"
+#include <atomic>
 #include <span>
+#include <thread>
 
 typedef uint8_t u8;
 typedef uint32_t u32;
 template <typename T> using CSpan = std::span<const T>;
 
 constexpr float PI = 3.14159265f;
-constexpr u32 cylinderResolution = 32;
-constexpr u32 cylinderNumVerts = 2 * cylinderResolution;
-constexpr u32 cylinderNumTris = (cylinderResolution - 1) * 4;
+constexpr u32 defaultResolution = 32; // segments of the cylinders of cmb_boolean_substract_mesh_cylinders
+constexpr u32 maxResolution = 1024;
 
 struct ResultHeader {
 	u32 numVertices;
 	u32 numTriangles;
+	cmb_Status status;
+	cmb_Stats stats;
+};
+
+static_assert(u32(CMB_STAGE_COUNT) == u32(NUM_PIPELINE_STAGES), "cmb_Stage must mirror PipelineStage");
+
+struct cmb_Arrangement {
+	LabelledArrangement arrangement;
+	cmb_Stats stats = {};
+	bool mergeCoplanar = false;
+};
+
+// buffers of the operations run one after the other on the same thread, e.g. by a worker of cmb_boolean_batch
+struct Workspace {
+	PipelineWorkspace pipeline;
+	std::vector<double> positionsA, positionsB, positionsOut;
+	std::vector<uint> indicesA, indicesB, indicesOut, labels;
+	std::vector<std::bitset<NBIT>> outLabels;
+};
+
+struct cmb_Job {
+	cmb_BooleanType type;
+	std::vector<float> positionsA, positionsB;
+	std::vector<u32> indicesA, indicesB;
+	PipelineOptions options;
+	ProgressMonitor progress;
+	std::atomic<cmb_JobStatus> status{ CMB_JOB_RUNNING };
+	cmb_Result* result = nullptr; // written by the job thread before status becomes CMB_JOB_DONE
+	std::thread thread;
+};
+
+// rough share of the time of an operation spent in each stage (cmb_bench, pairs scenario), to turn the stage
+// being run into the progress of cmb_job_poll
+static constexpr float stageWeights[CMB_STAGE_COUNT] = { 1, 4, 5, 69, 9, 4, 5, 2, 0.2f, 0.1f, 0.5f, 0.2f };
+
+struct cmb_MeshFile {
+	explicit cmb_MeshFile(const char* path) : file(path) {}
+
+	MappedFile file;
+	std::vector<float> positions; // float copy of double positions
+	cmb_InputMesh input = {};
+	const uint32_t* labels = nullptr;
 };
 
 // --- Vec3 --------------------
@@ -85,70 +131,221 @@ static void computeNormals(u32 numVertices, u32 numTriangles, const Vec3f* posit
 		normals[i] = normalized(normals[i]);
 }
 
-static void makeCylinder(
+// circle of a surface of revolution, at height y along its axis. A zero radius makes a single vertex (a pole of a
+// sphere, the apex of a cone)
+struct Ring {
+	float y;
+	float radius;
+};
+
+// Tessellates the surface of revolution through the rings, from bottom to top, with resolution segments per ring. The
+// first and last rings are closed by fans unless they are single vertices. The vertices are mapped from the local
+// frame to center + x * basisX + y * basisY + z * basisZ, and the triangles face outwards
+static void makeRevolution(
 	std::vector<double>& positions, std::vector<uint>& triangles,
 	Vec3d center,
 	Vec3d basisX, Vec3d basisY, Vec3d basisZ,
-	float radius, float halfHeight, u32 resolution)
+	CSpan<Ring> rings, u32 resolution)
 {
-	const u32 numVerts = cylinderNumVerts;
-	positions.resize(3 * numVerts);
+	positions.clear();
+	triangles.clear();
+
+	std::vector<uint> firstVert(rings.size());
 	const float deltaAlpha = 2 * PI / resolution;
-	for (u32 i = 0; i < resolution; i++) {
-		const float alpha = i * deltaAlpha;
-		float z = radius * cos(alpha);
-		float x = radius * sin(alpha);
+	for (size_t ringI = 0; ringI < rings.size(); ringI++) {
+		const Ring& ring = rings[ringI];
+		firstVert[ringI] = positions.size() / 3;
+		const u32 numVerts = ring.radius > 0 ? resolution : 1;
+		for (u32 i = 0; i < numVerts; i++) {
+			const float alpha = i * deltaAlpha;
+			float z = ring.radius * cos(alpha);
+			float x = ring.radius * sin(alpha);
+
+			positions.push_back(x);
+			positions.push_back(ring.y);
+			positions.push_back(z);
+		}
+	}
 
-		positions[3*i + 0] = x;
-		positions[3*i + 1] = -halfHeight;
-		positions[3*i + 2] = z;
+	for (size_t i = 0; i < positions.size(); i += 3) {
+		auto& v = *(Vec3d*)&positions[i];
+		v = center + v.x * basisX + v.y * basisY + v.z * basisZ;
 	}
 
-	for (u32 i = 0; i < resolution; i++) {
-		positions[3*(resolution + i) + 0] = positions[3*i + 0];
-		positions[3*(resolution + i) + 1] = -positions[3*i + 1];
-		positions[3*(resolution + i) + 2] = positions[3*i + 2];
+	auto addTriangle = [&](uint i0, uint i1, uint i2) {
+		triangles.push_back(i0);
+		triangles.push_back(i1);
+		triangles.push_back(i2);
+	};
+
+	if (rings.front().radius > 0) {
+		const uint first = firstVert.front();
+		for (uint i = 0; i < resolution - 2; i++)
+			addTriangle(first + i + 1, first, first + i + 2);
+	}
+	if (rings.back().radius > 0) {
+		const uint first = firstVert.back();
+		for (uint i = 0; i < resolution - 2; i++)
+			addTriangle(first, first + i + 1, first + i + 2);
+	}
+	for (size_t ringI = 0; ringI + 1 < rings.size(); ringI++) {
+		const uint lower = firstVert[ringI];
+		const uint upper = firstVert[ringI + 1];
+		for (uint i = 0; i < resolution; i++) {
+			const uint next = (i + 1) % resolution;
+			if (rings[ringI].radius <= 0)
+				addTriangle(upper + next, upper + i, lower);
+			else if (rings[ringI + 1].radius <= 0)
+				addTriangle(upper, lower + i, lower + next);
+			else {
+				addTriangle(upper + next, upper + i, lower + i);
+				addTriangle(upper + next, lower + i, lower + next);
+			}
+		}
 	}
+}
+
+static void makeBox(
+	std::vector<double>& positions, std::vector<uint>& triangles,
+	Vec3d center,
+	Vec3d basisX, Vec3d basisY, Vec3d basisZ,
+	float halfWidth, float halfHeight, float halfDepth)
+{
+	// corner i is on the positive side of X, Y, Z if bit 0, 1, 2 of i is set. Faces are counterclockwise from outside
+	static const uint faces[6][4] = { { 1, 3, 7, 5 }, { 4, 6, 2, 0 }, { 2, 6, 7, 3 }, { 1, 5, 4, 0 }, { 4, 5, 7, 6 }, { 2, 3, 1, 0 } };
 
-	for (u32 i = 0; i < numVerts; i++) {
+	positions.resize(3 * 8);
+	for (u32 i = 0; i < 8; i++) {
 		auto& v = *(Vec3d*)&positions[3 * i];
-		v = center + v.x * basisX + v.y * basisY + v.z * basisZ;
+		v = center +
+			double(i & 1 ? halfWidth : -halfWidth) * basisX +
+			double(i & 2 ? halfHeight : -halfHeight) * basisY +
+			double(i & 4 ? halfDepth : -halfDepth) * basisZ;
+	}
+
+	triangles.resize(3 * 12);
+	for (u32 faceI = 0; faceI < 6; faceI++) {
+		const uint* f = faces[faceI];
+		const uint tri[6] = { f[0], f[1], f[2], f[0], f[2], f[3] };
+		std::copy(tri, tri + 6, &triangles[6 * faceI]);
+	}
+}
+
+// segments around the axis of a round primitive or tool of the given radius, see cmb_Primitive
+static u32 primitiveResolution(u32 resolution, float tolerance, float radius)
+{
+	if (resolution)
+		return std::clamp(resolution, 3u, maxResolution);
+	if (tolerance <= 0)
+		return defaultResolution;
+	if (tolerance >= radius)
+		return 3;
+	// the chords of a circle split in n segments are at most r * (1 - cos(PI / n)) away from it
+	const double n = std::ceil(PI / std::acos(1 - double(tolerance) / radius));
+	return u32(std::min(n, double(maxResolution)));
+}
+
+// Tessellates the primitive into positions and triangles, facing outwards like the input meshes. The vertices are all
+// different from each other. Returns false, leaving the buffers untouched, if the primitive is degenerate
+static bool makePrimitive(const cmb_Primitive& primitive, std::vector<double>& positions, std::vector<uint>& triangles)
+{
+	const cmb_Primitive& p = primitive;
+	const Vec3d center(p.posX, p.posY, p.posZ);
+	const Vec3d basisY(p.dirX, p.dirY, p.dirZ);
+	const Vec3d side = cross(cross(basisY, Vec3d(p.sideX, p.sideY, p.sideZ)), basisY); // side without its component along dir
+	Vec3d axis = abs(basisY.z) > 0.1 ? Vec3d(0, 0, 1) : Vec3d(1, 0, 0);
+	if (abs(dot(axis, basisY)) > 0.9) // too close to dir to make a frame with it, the other one is not
+		axis = Vec3d(axis.z, 0, axis.x);
+	const Vec3d basisX = dot(side, side) > 0 ? normalized(side) : normalized(cross(basisY, axis));
+	const Vec3d basisZ = cross(basisX, basisY);
+
+	// features much smaller than their distance from the origin would round to coincident vertices
+	float minSize, maxSize;
+	if (p.type == CMB_PRIMITIVE_BOX) {
+		minSize = std::min({ p.halfWidth, p.halfHeight, p.halfDepth });
+		maxSize = std::max({ p.halfWidth, p.halfHeight, p.halfDepth });
+	}
+	else {
+		const bool straight = (p.type == CMB_PRIMITIVE_CYLINDER || p.type == CMB_PRIMITIVE_CONE);
+		minSize = straight ? std::min(p.radius, p.halfHeight) : p.radius;
+		maxSize = std::max({ p.radius, p.topRadius, p.halfHeight });
+		if (p.type == CMB_PRIMITIVE_CONE && p.topRadius != 0)
+			minSize = std::min(minSize, p.topRadius);
+		if (p.type == CMB_PRIMITIVE_CAPSULE && p.halfHeight < 0)
+			minSize = 0;
+	}
+	const double scale = std::max({ std::abs(center.x), std::abs(center.y), std::abs(center.z), double(maxSize) });
+	if (!(minSize > 1e-9 * scale) || dot(basisY, basisY) == 0)
+		return false;
+
+	if (p.type == CMB_PRIMITIVE_BOX) {
+		makeBox(positions, triangles, center, basisX, basisY, basisZ, p.halfWidth, p.halfHeight, p.halfDepth);
+		return true;
 	}
 
-	triangles.resize(3 * cylinderNumTris);
-	uint triI = 0;
-	for (uint i = 0; i < resolution - 2; i++) {
-		triangles[3*triI + 0] = i + 1;
-		triangles[3*triI + 1] = 0;
-		triangles[3*triI + 2] = i + 2;
-		triI++;
-	}
-	for (uint i = 0; i < resolution - 2; i++) {
-		triangles[3*triI + 0] = resolution;
-		triangles[3*triI + 1] = resolution + i + 1;
-		triangles[3*triI + 2] = resolution + i + 2;
-		triI++;
-	}
-	for (uint i = 0; i < resolution; i++) {
-		const uint i00 = i;
-		const uint i01 = (i + 1) % resolution;
-		const uint i10 = i + resolution;
-		const uint i11 = i01 + resolution;
-		triangles[3*triI + 0] = i11;
-		triangles[3*triI + 1] = i10;
-		triangles[3*triI + 2] = i00;
-		triI++;
-		triangles[3*triI + 0] = i11;
-		triangles[3*triI + 1] = i00;
-		triangles[3*triI + 2] = i01;
-		triI++;
-	}
-}
-
-// A = A <op> B
-static void calcBooleanOp(BoolOp op,
+	const u32 resolution = primitiveResolution(p.resolution, p.tolerance, std::max(p.radius, p.topRadius));
+	std::vector<Ring> rings;
+	switch (p.type) {
+	case CMB_PRIMITIVE_CYLINDER:
+		rings = { { -p.halfHeight, p.radius }, { p.halfHeight, p.radius } };
+		break;
+	case CMB_PRIMITIVE_CONE:
+		rings = { { -p.halfHeight, p.radius }, { p.halfHeight, p.topRadius } };
+		break;
+	case CMB_PRIMITIVE_SPHERE:
+	case CMB_PRIMITIVE_CAPSULE: {
+		// a capsule is a sphere split at the equator, with halfHeight moving each half away from the centre
+		const float halfHeight = p.type == CMB_PRIMITIVE_CAPSULE ? p.halfHeight : 0;
+		const u32 quarterRings = std::max(resolution / 4, 1u);
+		const float deltaPhi = 0.5f * PI / quarterRings;
+		rings.push_back({ -halfHeight - p.radius, 0 });
+		for (u32 i = 1; i < 2 * quarterRings; i++) {
+			if (i == quarterRings && halfHeight > 0)
+				rings.push_back({ -halfHeight, p.radius });
+			const float phi = i * deltaPhi - 0.5f * PI;
+			rings.push_back({ (i < quarterRings ? -halfHeight : halfHeight) + p.radius * sin(phi), p.radius * cos(phi) });
+		}
+		rings.push_back({ halfHeight + p.radius, 0 });
+		break;
+	}
+	default:
+		assert(false && "unknown primitive type");
+		return false;
+	}
+
+	makeRevolution(positions, triangles, center, basisX, basisY, basisZ, rings, resolution);
+	return true;
+}
+
+static void accumulateStats(cmb_Stats& stats, const PipelineStats& pipelineStats)
+{
+	for (u32 i = 0; i < CMB_STAGE_RESULT_PACKING; i++) {
+		const StageStats& in = pipelineStats.stages[i];
+		cmb_StageStats& out = stats.stages[i];
+		out.seconds += in.time;
+		out.numTriangles = in.num_tris;
+		out.numPoints = in.num_points;
+		out.arenaBytes = std::max<uint64_t>(out.arenaBytes, in.arena_bytes);
+		out.structureBytes = std::max<uint64_t>(out.structureBytes, in.structure_bytes);
+	}
+}
+
+static cmb_Status budgetStatus(StopReason reason)
+{
+	switch (reason) {
+	case OUT_OF_TIME: return CMB_STATUS_OUT_OF_TIME;
+	case TOO_MANY_PAIRS: return CMB_STATUS_TOO_MANY_PAIRS;
+	case TOO_MANY_POINTS: return CMB_STATUS_TOO_MANY_POINTS;
+	default: return CMB_STATUS_OK;
+	}
+}
+
+// A = A <op> B. Over budget, A is emptied or replaced by the preview of the operation, depending on the options.
+// labelsB, if not empty, splits B in several meshes (labels 1 and up), e.g. for a subtraction of all of them at once
+static cmb_Status calcBooleanOp(BoolOp op,
 	std::vector<double>& positionsA, std::vector<uint>& indicesA,
-	CSpan<double> positionsB, CSpan<uint> indicesB)
+	CSpan<double> positionsB, CSpan<uint> indicesB, CSpan<uint> labelsB, const PipelineOptions& options, cmb_Stats& stats,
+	Workspace& ws, ProgressMonitor* progress = nullptr)
 {
 	const uint numTrisA = indicesA.size() / 3;
 	const uint numTrisB = indicesB.size() / 3;
@@ -165,38 +362,58 @@ static void calcBooleanOp(BoolOp op,
 		indicesA.push_back(firstIndB + ind);
 
 	// the labels indicate, for each triangle, what object it belongs to
-	std::vector<uint> labels;
+	std::vector<uint>& labels = ws.labels;
+	labels.clear();
 	labels.reserve(numTrisA + numTrisB);
 	for (uint i = 0; i < numTrisA; i++)
 		labels.push_back(0);
 	for (uint i = 0; i < numTrisB; i++)
-		labels.push_back(1);
-
-	static std::vector<double> positionsOut;
-	static std::vector<uint> indicesOut;
-	static std::vector<std::bitset<NBIT>> outLabels;
-	positionsOut.clear();
-	indicesOut.clear();
-	outLabels.clear();
-	outLabels.reserve(numTrisA + numTrisB);
-
-	booleanPipeline(
-		positionsA, indicesA, labels,
-		op,
-		positionsOut, indicesOut, outLabels);
+		labels.push_back(labelsB.empty() ? 1 : labelsB[i]);
+
+	ws.positionsOut.clear();
+	ws.indicesOut.clear();
+	ws.outLabels.clear();
+	ws.outLabels.reserve(numTrisA + numTrisB);
+
+	PipelineStats pipelineStats;
+	ProgressMonitor localProgress; // the budget is checked by the monitor
+	pipelineStats.progress = progress ? progress : &localProgress;
+	cmb_Status status = CMB_STATUS_OK;
+	try {
+		booleanPipeline(
+			positionsA, indicesA, labels,
+			op,
+			ws.positionsOut, ws.indicesOut, ws.outLabels, pipelineStats, options, ws.pipeline);
+	}
+	catch (const OperationCancelled& e) {
+		if (e.reason == CANCELLED)
+			throw;
+		status = budgetStatus(e.reason);
+		ws.positionsOut.clear();
+		ws.indicesOut.clear();
+		ws.outLabels.clear();
+		if (options.preview_on_budget)
+			previewBooleanOp(positionsA, indicesA, labels, op, ws.positionsOut, ws.indicesOut, ws.outLabels);
+	}
+	accumulateStats(stats, pipelineStats);
 
-	std::swap(positionsA, positionsOut);
-	std::swap(indicesA, indicesOut);
+	std::swap(positionsA, ws.positionsOut);
+	std::swap(indicesA, ws.indicesOut);
+	return status;
 }
 
-static cmb_Result* prepareResult(CSpan<double> positions, CSpan<uint> indices)
+static cmb_Result* prepareResult(CSpan<double> positions, CSpan<uint> indices, const cmb_Stats& stats,
+	cmb_Status status = CMB_STATUS_OK)
 {
+	auto start = startChrono();
+
 	// prepare result
 	const u32 bufferSize_positions = sizeof(float) * positions.size();
 	const u32 bufferSize_normals = bufferSize_positions;
 	const u32 bufferSize_indices = sizeof(u32) * indices.size();
 
-	u8* resultPtr = new u8[bufferSize_positions + bufferSize_normals + bufferSize_indices];
+	const u32 bufferSize = sizeof(ResultHeader) + bufferSize_positions + bufferSize_normals + bufferSize_indices;
+	u8* resultPtr = new u8[bufferSize];
 
 	const u32 resultOffset_positions = sizeof(ResultHeader);
 	const u32 resultOffset_normals = resultOffset_positions + bufferSize_positions;
@@ -208,7 +425,7 @@ static cmb_Result* prepareResult(CSpan<double> positions, CSpan<uint> indices)
 
 	const u32 numVertices = positions.size() / 3;
 	const u32 numTriangles = indices.size() / 3;
-	*resultPtr_header = { numVertices, numTriangles };
+	*resultPtr_header = { numVertices, numTriangles, status, stats };
 
 	for (u32 i = 0; i < positions.size(); i++)
 		resultPtr_positions[i] = float(positions[i]);
@@ -222,10 +439,39 @@ static cmb_Result* prepareResult(CSpan<double> positions, CSpan<uint> indices)
 
 	computeNormals(numVertices, numTriangles, (Vec3f*)resultPtr_positions, resultPtr_indices, (Vec3f*)resultPtr_normals);
 
+	cmb_StageStats& packing = resultPtr_header->stats.stages[CMB_STAGE_RESULT_PACKING];
+	packing.seconds = stopChrono(start);
+	packing.numTriangles = numTriangles;
+	packing.numPoints = numVertices;
+	packing.structureBytes = bufferSize;
+
 	return (cmb_Result*)resultPtr;
 }
 
+static PipelineOptions pipelineOptions(const cmb_Options* options)
+{
+	PipelineOptions out;
+	if (options) {
+		assert((options->snapBits == 0 || (options->snapBits >= 2 && options->snapBits <= 31)) && "snapBits out of range");
+		out.snap_bits = options->snapBits;
+		if (options->maxSeconds > 0)
+			out.deadline = std::chrono::steady_clock::now() +
+				std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(options->maxSeconds));
+		out.max_intersection_pairs = options->maxIntersectingPairs;
+		out.max_implicit_points = options->maxImplicitPoints;
+		out.preview_on_budget = options->previewOnBudget;
+		out.merge_coplanar = options->mergeCoplanar;
+	}
+	return out;
+}
+
 CMB_API cmb_Result* cmb_boolean(cmb_BooleanType type, cmb_InputMesh meshA, cmb_InputMesh meshB)
+{
+	return cmb_boolean_ex(type, meshA, meshB, nullptr);
+}
+
+static cmb_Result* booleanOp(cmb_BooleanType type, cmb_InputMesh meshA, cmb_InputMesh meshB, const PipelineOptions& options, Workspace& ws,
+	ProgressMonitor* progress = nullptr)
 {
 	const auto op = (BoolOp)type;
 	const uint32_t numVerticesA = meshA.numVertices;
@@ -234,63 +480,276 @@ CMB_API cmb_Result* cmb_boolean(cmb_BooleanType type, cmb_InputMesh meshA, cmb_I
 	const uint32_t numTrianglesB = meshB.numTriangles;
 
 	// prepare positions
-	std::vector<double> positionsA;
+	std::vector<double>& positionsA = ws.positionsA;
+	positionsA.clear();
 	positionsA.reserve(3 * (numVerticesA + numVerticesB));
 	for (size_t i = 0; i < 3 * numVerticesA; i++)
 		positionsA.push_back(double(meshA.positions[i]));
 
-	std::vector<double> positionsB;
+	std::vector<double>& positionsB = ws.positionsB;
+	positionsB.clear();
 	positionsB.reserve(3 * numVerticesB);
 	for (size_t i = 0; i < 3 * numVerticesB; i++)
 		positionsB.push_back(double(meshB.positions[i]));
 	
 	// prepare indices
-	std::vector<uint> indicesA;
+	std::vector<uint>& indicesA = ws.indicesA;
+	indicesA.clear();
 	indicesA.reserve(3 * (numTrianglesA + numTrianglesB));
 	for (size_t i = 0; i < 3 * numTrianglesA; i++)
 		indicesA.push_back(uint(meshA.indices[i]));
 
-	std::vector<uint> indicesB;
+	std::vector<uint>& indicesB = ws.indicesB;
+	indicesB.clear();
 	indicesB.reserve(3 * numTrianglesB);
 	for (size_t i = 0; i < 3 * numTrianglesB; i++)
 		indicesB.push_back(uint(meshB.indices[i]));
 
-	calcBooleanOp(op, positionsA, indicesA, positionsB, indicesB);
+	cmb_Stats stats = {};
+	const cmb_Status status = calcBooleanOp(op, positionsA, indicesA, positionsB, indicesB, {}, options, stats, ws, progress);
 
-	return prepareResult(positionsA, indicesA);
+	return prepareResult(positionsA, indicesA, stats, status);
+}
+
+CMB_API cmb_Result* cmb_boolean_ex(cmb_BooleanType type, cmb_InputMesh meshA, cmb_InputMesh meshB, const cmb_Options* options)
+{
+	Workspace ws;
+	return booleanOp(type, meshA, meshB, pipelineOptions(options), ws);
+}
+
+CMB_API void cmb_boolean_batch(const cmb_BooleanJob* jobs, uint32_t numJobs, cmb_Result** results, uint32_t numThreads,
+	const cmb_Options* options)
+{
+	const PipelineOptions pipelineOpts = pipelineOptions(options);
+	if (numThreads == 0)
+		numThreads = std::max(1u, std::thread::hardware_concurrency());
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+	numThreads = 1;
+#endif
+	numThreads = std::min(numThreads, numJobs);
+
+#if ENABLE_MULTITHREADING
+	// work stealing over the jobs, with a workspace per worker thread. The jobs are isolated so that a worker
+	// waiting inside a job never picks up another one, which would share its workspace
+	tbb::enumerable_thread_specific<Workspace> workspaces;
+	tbb::task_arena arena(int(std::max(numThreads, 1u)));
+	arena.execute([&] {
+		tbb::parallel_for(u32(0), numJobs, [&](u32 i) {
+			tbb::this_task_arena::isolate([&] {
+				results[i] = booleanOp(jobs[i].type, jobs[i].meshA, jobs[i].meshB, pipelineOpts, workspaces.local());
+			});
+		});
+	});
+#else
+	// the workers take the jobs one at a time in order, so that a long job does not hold up the ones behind it
+	std::atomic<u32> nextJob{ 0 };
+	auto worker = [&] {
+		Workspace ws;
+		for (u32 i = nextJob++; i < numJobs; i = nextJob++)
+			results[i] = booleanOp(jobs[i].type, jobs[i].meshA, jobs[i].meshB, pipelineOpts, ws);
+	};
+
+	std::vector<std::thread> threads;
+	for (u32 t = 1; t < numThreads; t++)
+		threads.emplace_back(worker);
+	worker();
+	for (auto& thread : threads)
+		thread.join();
+#endif
+}
+
+static void runJob(cmb_Job* job)
+{
+	const cmb_InputMesh meshA = { u32(job->positionsA.size() / 3), u32(job->indicesA.size() / 3), job->positionsA.data(), job->indicesA.data() };
+	const cmb_InputMesh meshB = { u32(job->positionsB.size() / 3), u32(job->indicesB.size() / 3), job->positionsB.data(), job->indicesB.data() };
+	Workspace ws;
+	try {
+		job->result = booleanOp(job->type, meshA, meshB, job->options, ws, &job->progress);
+		job->status = CMB_JOB_DONE;
+	}
+	catch (const OperationCancelled&) {
+		job->status = CMB_JOB_CANCELLED;
+	}
+}
+
+CMB_API cmb_Job* cmb_boolean_async(cmb_BooleanType type, cmb_InputMesh meshA, cmb_InputMesh meshB, const cmb_Options* options)
+{
+	auto job = new cmb_Job;
+	job->type = type;
+	job->positionsA.assign(meshA.positions, meshA.positions + 3 * size_t(meshA.numVertices));
+	job->indicesA.assign(meshA.indices, meshA.indices + 3 * size_t(meshA.numTriangles));
+	job->positionsB.assign(meshB.positions, meshB.positions + 3 * size_t(meshB.numVertices));
+	job->indicesB.assign(meshB.indices, meshB.indices + 3 * size_t(meshB.numTriangles));
+	job->options = pipelineOptions(options);
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+	runJob(job); // no threads: the job is over when the call returns
+#else
+	job->thread = std::thread(runJob, job);
+#endif
+	return job;
+}
+
+CMB_API cmb_JobStatus cmb_job_poll(cmb_Job* job, cmb_Stage* stage, float* progress)
+{
+	const cmb_JobStatus status = job->status;
+	const u32 currStage = status == CMB_JOB_DONE ? u32(CMB_STAGE_COUNT) : std::min(job->progress.stage(), u32(CMB_STAGE_RESULT_PACKING));
+	if (stage)
+		*stage = cmb_Stage(std::min(currStage, u32(CMB_STAGE_RESULT_PACKING)));
+	if (progress) {
+		float done = 0, total = 0;
+		for (u32 s = 0; s < CMB_STAGE_COUNT; s++) {
+			total += stageWeights[s];
+			if (s < currStage) done += stageWeights[s];
+			else if (s == currStage) done += stageWeights[s] * float(job->progress.stageFraction());
+		}
+		*progress = done / total;
+	}
+	return status;
+}
+
+CMB_API void cmb_job_cancel(cmb_Job* job)
+{
+	job->progress.cancel();
+}
+
+CMB_API cmb_Result* cmb_job_wait(cmb_Job* job)
+{
+	if (job->thread.joinable())
+		job->thread.join();
+	cmb_Result* result = job->result;
+	job->result = nullptr;
+	return result;
+}
+
+CMB_API void cmb_job_release(cmb_Job* job)
+{
+	cmb_job_cancel(job);
+	if (cmb_Result* result = cmb_job_wait(job))
+		cmb_release(result);
+	delete job;
 }
 
 CMB_API cmb_Result* cmb_boolean_substract_mesh_cylinders(cmb_InputMesh mesh, uint32_t numCylinders, const cmb_CylinderInfo* cylinders)
+{
+	return cmb_boolean_substract_mesh_cylinders_ex(mesh, numCylinders, cylinders, nullptr);
+}
+
+CMB_API cmb_Result* cmb_boolean_substract_mesh_cylinders_ex(cmb_InputMesh mesh, uint32_t numCylinders, const cmb_CylinderInfo* cylinders,
+	const cmb_Options* options)
+{
+	std::vector<cmb_Primitive> primitives(numCylinders);
+	for (u32 cylI = 0; cylI < numCylinders; cylI++) {
+		auto& cylinder = cylinders[cylI];
+		cmb_Primitive& p = primitives[cylI];
+		p = {};
+		p.type = CMB_PRIMITIVE_CYLINDER;
+		p.posX = cylinder.posX; p.posY = cylinder.posY; p.posZ = cylinder.posZ;
+		p.dirX = cylinder.dirX; p.dirY = cylinder.dirY; p.dirZ = cylinder.dirZ;
+		p.radius = cylinder.radius;
+		p.halfHeight = cylinder.halfHeight;
+		p.resolution = defaultResolution;
+	}
+	return cmb_boolean_subtract_primitives(mesh, numCylinders, primitives.data(), options);
+}
+
+CMB_API cmb_Result* cmb_boolean_subtract_primitives(cmb_InputMesh mesh, uint32_t numPrimitives, const cmb_Primitive* primitives,
+	const cmb_Options* options)
 {
 	std::vector<double> meshPositions;
-	meshPositions.reserve(3 * (mesh.numVertices + cylinderNumVerts));
+	meshPositions.reserve(3 * mesh.numVertices);
 	for (u32 i = 0; i < 3 * mesh.numVertices; i++)
 		meshPositions.push_back(double(mesh.positions[i]));
 
 	std::vector<uint> meshIndices;
-	meshIndices.reserve(3 * (mesh.numTriangles + cylinderNumTris));
+	meshIndices.reserve(3 * mesh.numTriangles);
 	for (u32 i = 0; i < 3 * mesh.numTriangles; i++)
-		meshIndices.push_back(double(mesh.indices[i]));
+		meshIndices.push_back(mesh.indices[i]);
+
+	PipelineOptions pipelineOpts = pipelineOptions(options);
+	cmb_Stats stats = {};
+	cmb_Status status = CMB_STATUS_OK;
+	Workspace ws;
+	for (u32 primI = 0; primI < numPrimitives; primI++) {
+		if (!makePrimitive(primitives[primI], ws.positionsB, ws.indicesB))
+			continue;
+
+		// the primitive is generated without duplicated vertices: the vertex merge only welds the ones of the mesh
+		pipelineOpts.num_welded_verts = ws.positionsB.size() / 3;
+
+		// once out of time, the following operations stop at their first checkpoint: with previewOnBudget, the rest of
+		// the primitives are all previewed
+		const cmb_Status primStatus = calcBooleanOp(BoolOp::SUBTRACTION, meshPositions, meshIndices, ws.positionsB, ws.indicesB,
+			{}, pipelineOpts, stats, ws);
+		if (status == CMB_STATUS_OK)
+			status = primStatus;
+		if (status != CMB_STATUS_OK && !pipelineOpts.preview_on_budget)
+			break;
+	}
 
-	std::vector<double> cylinderPositions;
-	std::vector<uint> cylinderIndices;
-	for (u32 cylI = 0; cylI < numCylinders; cylI++) {
-		auto& cylinder = cylinders[cylI];
+	return prepareResult(meshPositions, meshIndices, stats, status);
+}
+
+CMB_API cmb_Result* cmb_boolean_subtract_toolpath(cmb_InputMesh mesh, uint32_t numPoints, const float* points, const cmb_Tool* tool,
+	const cmb_Options* options)
+{
+	std::vector<double> meshPositions(mesh.positions, mesh.positions + 3 * mesh.numVertices);
+	std::vector<uint> meshIndices(mesh.indices, mesh.indices + 3 * mesh.numTriangles);
+
+	std::vector<cinolib::vec3d> path(numPoints);
+	for (u32 i = 0; i < numPoints; i++)
+		path[i] = cinolib::vec3d(points[3 * i + 0], points[3 * i + 1], points[3 * i + 2]);
+
+	// the tubes of the sweep are labelled 1 and up, so that one operation subtracts as many of them as possible
+	std::vector<SweptVolumeBatch> batches;
+	if (tool->radius > 0 && numPoints > 0) {
+		const u32 resolution = primitiveResolution(tool->resolution, tool->tolerance, tool->radius);
+		const double tolerance = tool->tolerance > 0 ? tool->tolerance : tool->radius * (1 - cos(PI / resolution));
+		buildSweptVolume(path, tool->radius, resolution, tolerance, 1, batches);
+	}
 
-		const Vec3d basisY(cylinder.dirX, cylinder.dirY, cylinder.dirZ);
-		const Vec3d basisX = normalized(cross(basisY, abs(basisY.z) > 0.1 ? Vec3d(0, 0, 1) : Vec3d(1, 0, 0)));
-		const Vec3d basisZ = cross(basisX, basisY);
+	PipelineOptions pipelineOpts = pipelineOptions(options);
+	cmb_Stats stats = {};
+	cmb_Status status = CMB_STATUS_OK;
+	Workspace ws;
+	for (const SweptVolumeBatch& batch : batches) {
+		const cmb_Status batchStatus = calcBooleanOp(BoolOp::SUBTRACTION, meshPositions, meshIndices, batch.coords, batch.tris,
+			batch.labels, pipelineOpts, stats, ws);
+		if (status == CMB_STATUS_OK)
+			status = batchStatus;
+		if (status != CMB_STATUS_OK && !pipelineOpts.preview_on_budget)
+			break;
+	}
 
-		makeCylinder(cylinderPositions, cylinderIndices,
-			Vec3d{ cylinder.posX, cylinder.posY, cylinder.posZ },
-			basisX, basisY, basisZ,
-			cylinder.radius, cylinder.halfHeight, cylinderResolution
-		);
+	return prepareResult(meshPositions, meshIndices, stats, status);
+}
 
-		calcBooleanOp(BoolOp::SUBTRACTION, meshPositions, meshIndices, cylinderPositions, cylinderIndices);
+CMB_API cmb_Result* cmb_resolve_self_intersections(cmb_InputMesh mesh, const cmb_Options* options)
+{
+	std::vector<double> positions(mesh.positions, mesh.positions + 3 * mesh.numVertices);
+	std::vector<uint> indices(mesh.indices, mesh.indices + 3 * mesh.numTriangles);
+
+	const PipelineOptions pipelineOpts = pipelineOptions(options);
+	PipelineStats pipelineStats;
+	ProgressMonitor progress; // the budget is checked by the monitor
+	pipelineStats.progress = &progress;
+	Workspace ws;
+	cmb_Status status = CMB_STATUS_OK;
+	try {
+		resolveSelfIntersections(positions, indices, ws.positionsOut, ws.indicesOut, pipelineStats, pipelineOpts, ws.pipeline);
+	}
+	catch (const OperationCancelled& e) {
+		status = budgetStatus(e.reason);
+		ws.positionsOut.clear();
+		ws.indicesOut.clear();
+		if (pipelineOpts.preview_on_budget) {
+			std::swap(ws.positionsOut, positions);
+			std::swap(ws.indicesOut, indices);
+		}
 	}
 
-	return prepareResult(meshPositions, meshIndices);
+	cmb_Stats stats = {};
+	accumulateStats(stats, pipelineStats);
+	return prepareResult(ws.positionsOut, ws.indicesOut, stats, status);
 }
 
 CMB_API void cmb_release(cmb_Result* o)
@@ -299,6 +758,115 @@ CMB_API void cmb_release(cmb_Result* o)
 	delete[] ptr;
 }
 
+CMB_API cmb_Arrangement* cmb_arrangement(cmb_InputMesh meshA, cmb_InputMesh meshB, const cmb_Options* options)
+{
+	// A and B in a single mesh, labelled 0 and 1 as in calcBooleanOp
+	std::vector<double> positions(meshA.positions, meshA.positions + 3 * meshA.numVertices);
+	positions.insert(positions.end(), meshB.positions, meshB.positions + 3 * meshB.numVertices);
+
+	std::vector<uint> indices(meshA.indices, meshA.indices + 3 * meshA.numTriangles);
+	indices.reserve(3 * (meshA.numTriangles + meshB.numTriangles));
+	for (u32 i = 0; i < 3 * meshB.numTriangles; i++)
+		indices.push_back(meshA.numVertices + meshB.indices[i]);
+
+	std::vector<uint> labels(meshA.numTriangles, 0);
+	labels.resize(meshA.numTriangles + meshB.numTriangles, 1);
+
+	auto arrangement = new cmb_Arrangement;
+	PipelineStats pipelineStats;
+	computeLabelledArrangement(positions, indices, labels, arrangement->arrangement, pipelineStats, pipelineOptions(options));
+	accumulateStats(arrangement->stats, pipelineStats);
+	arrangement->mergeCoplanar = options && options->mergeCoplanar;
+	return arrangement;
+}
+
+CMB_API cmb_Result* cmb_arrangement_boolean(cmb_Arrangement* arrangement, cmb_BooleanType type, bool reversed)
+{
+	std::vector<double> positions;
+	std::vector<uint> indices;
+	std::vector<std::bitset<NBIT>> labels;
+	PipelineStats pipelineStats;
+	extractBooleanOp(arrangement->arrangement, (BoolOp)type, positions, indices, labels, pipelineStats,
+		(reversed && type == CMB_DIFFERENCE) ? 1 : 0, arrangement->mergeCoplanar);
+
+	cmb_Stats stats = {};
+	accumulateStats(stats, pipelineStats);
+	return prepareResult(positions, indices, stats);
+}
+
+CMB_API const cmb_Stats* cmb_arrangement_stats(cmb_Arrangement* arrangement)
+{
+	return &arrangement->stats;
+}
+
+CMB_API void cmb_arrangement_release(cmb_Arrangement* arrangement)
+{
+	delete arrangement;
+}
+
+CMB_API bool cmb_arrangement_save(cmb_Arrangement* arrangement, const char* path)
+{
+	return saveLabelledArrangement(path, arrangement->arrangement);
+}
+
+CMB_API cmb_Arrangement* cmb_arrangement_load(const char* path)
+{
+	auto arrangement = new cmb_Arrangement;
+	if (!loadLabelledArrangement(path, arrangement->arrangement)) {
+		delete arrangement;
+		return nullptr;
+	}
+	return arrangement;
+}
+
+CMB_API cmb_MeshFile* cmb_mesh_load(const char* path)
+{
+	auto mesh = new cmb_MeshFile(path);
+	MeshFileView view;
+	if (!mesh->file.isOpen() || !viewMeshFile(mesh->file.data(), mesh->file.size(), view)) {
+		delete mesh;
+		return nullptr;
+	}
+
+	const float* positions = view.positions_f;
+	if (view.positions_d) {
+		mesh->positions.assign(view.positions_d, view.positions_d + 3 * size_t(view.num_verts));
+		positions = mesh->positions.data();
+	}
+
+	// cmb_InputMesh is not const-qualified, but the operations only read it
+	mesh->input = { view.num_verts, view.num_tris, const_cast<float*>(positions), const_cast<u32*>(view.indices) };
+	mesh->labels = view.labels;
+	return mesh;
+}
+
+CMB_API cmb_InputMesh cmb_mesh_input(cmb_MeshFile* mesh)
+{
+	return mesh->input;
+}
+
+CMB_API const uint32_t* cmb_mesh_labels(cmb_MeshFile* mesh)
+{
+	return mesh->labels;
+}
+
+CMB_API void cmb_mesh_release(cmb_MeshFile* mesh)
+{
+	delete mesh;
+}
+
+CMB_API const cmb_Stats* cmb_stats(cmb_Result* o)
+{
+	auto header = (ResultHeader*)o;
+	return &header->stats;
+}
+
+CMB_API cmb_Status cmb_status(cmb_Result* o)
+{
+	auto header = (ResultHeader*)o;
+	return header->status;
+}
+
 CMB_API uint32_t cmb_numVertices(cmb_Result* o)
 {
 	auto header = (ResultHeader*)o;
@@ -328,6 +896,31 @@ CMB_API uint32_t* cmb_indices(cmb_Result* o)
 	return (u32*)(ptr + sizeof(ResultHeader) + 2 * 3 * sizeof(float) * header->numVertices);
 }
 
+CMB_API uint32_t cmb_predicate_stats(cmb_PredicateStats* stats, uint32_t maxStats)
+{
+	const auto predicateStats = predicate_stats::collect();
+	for (u32 i = 0; i < predicateStats.size() && i < maxStats; i++) {
+		const auto& s = predicateStats[i];
+		stats[i] = { s.name, s.calls, s.interval, s.exact, s.bigfloat, s.total_ns, s.exact_ns };
+	}
+	return u32(predicateStats.size());
+}
+
+CMB_API void cmb_predicate_stats_reset()
+{
+	predicate_stats::reset();
+}
+
+CMB_API bool cmb_predicate_capture_begin(const char* path, uint64_t maxRecords)
+{
+	return predicate_capture::start(path, maxRecords);
+}
+
+CMB_API uint64_t cmb_predicate_capture_end()
+{
+	return predicate_capture::stop();
+}
+
 CMB_API void cmb_nothing(int x)
 {
 	printf("nothing: %d\n", x);
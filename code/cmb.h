@@ -29,16 +29,229 @@ struct cmb_CylinderInfo {
 	float halfHeight;
 };
 
+enum cmb_PrimitiveType {
+	CMB_PRIMITIVE_CYLINDER,
+	CMB_PRIMITIVE_BOX,
+	CMB_PRIMITIVE_SPHERE,
+	CMB_PRIMITIVE_CONE,
+	CMB_PRIMITIVE_CAPSULE,
+};
+
+// A solid centred at pos, with its axis along dir (unit length). The frame of the primitive has dir as Y axis and side,
+// made perpendicular to dir, as X axis; a zero side picks any perpendicular direction (as for cmb_CylinderInfo).
+// Primitives with a non-positive size are skipped
+struct cmb_Primitive {
+	cmb_PrimitiveType type;
+	float posX, posY, posZ;
+	float dirX, dirY, dirZ;
+	float sideX, sideY, sideZ;
+	float radius; // cylinder, sphere, capsule; base radius of the cone
+	float topRadius; // cone radius at pos + halfHeight * dir: 0 for a pointed cone, nonzero for a truncated one
+	float halfHeight; // half length along dir: cylinder, cone, box, and the straight part of the capsule (0 = sphere)
+	float halfWidth, halfDepth; // box, along side and side x dir
+	// Segments around the axis of the round primitives. 0 = the smallest number that keeps the surface within
+	// tolerance of the exact one, or 32 if tolerance is 0 too. To keep the error below p pixels at distance d with a
+	// vertical field of view fov on a screen h pixels high, use tolerance = p * 2 * d * tan(fov / 2) / h
+	uint32_t resolution;
+	float tolerance;
+};
+
+// Ball end tool for cmb_boolean_subtract_toolpath. resolution and tolerance as in cmb_Primitive; tolerance also bounds
+// the distance from the toolpath of the points dropped from it
+struct cmb_Tool {
+	float radius;
+	uint32_t resolution;
+	float tolerance;
+};
+
+struct cmb_BooleanJob {
+	cmb_BooleanType type;
+	cmb_InputMesh meshA;
+	cmb_InputMesh meshB;
+};
+
 struct cmb_Result;
+struct cmb_Arrangement;
+struct cmb_MeshFile;
+struct cmb_Job;
+
+// Options of the _ex functions. A zero-initialized struct gives the same behaviour as the functions without _ex
+struct cmb_Options {
+	// When nonzero (2 to 31), the input coordinates are snapped to a lattice of signed integers of snapBits bits per
+	// axis, scaled by the largest power of 2 that fits the bounding box of the operands. Features closer than the
+	// lattice pitch collapse and the output vertices of the input mesh lie on the lattice. Use it for inputs that
+	// are already on a fixed grid (e.g. CAD data in micrometres), where it makes the geometric predicates cheaper.
+	uint32_t snapBits;
+
+	// Budget of the call, for interactive previews (0 = no limit). The boolean operations stop as soon as they notice
+	// that they have run for more than maxSeconds, found more than maxIntersectingPairs pairs of intersecting
+	// triangles (checked right after the broad phase) or made more than maxImplicitPoints intersection points, and
+	// return a result whose cmb_status tells which limit was hit. Applies to cmb_boolean_ex, cmb_boolean_batch (the
+	// time is the one of the whole batch), cmb_boolean_async, cmb_boolean_substract_mesh_cylinders_ex,
+	// cmb_boolean_subtract_primitives, cmb_boolean_subtract_toolpath and cmb_resolve_self_intersections
+	float maxSeconds;
+	uint32_t maxIntersectingPairs;
+	uint32_t maxImplicitPoints;
+	// When the budget is exceeded the result is empty, unless previewOnBudget is set: then it is an approximation
+	// made of whole input triangles, selected by testing their barycenters against the other mesh in floating point.
+	// It is much faster than the exact operation, but jagged along the intersection and not watertight
+	bool previewOnBudget;
+
+	// Re-triangulates the planar parts of the result with as few triangles as their outlines allow, dropping the
+	// vertices the intersection curves leave inside them or along their straight edges. The result stays watertight
+	// and its shape is unchanged; it avoids the growth of the triangle count over successive operations (e.g. one
+	// cylinder subtraction after the other). Given to cmb_arrangement, it applies to its cmb_arrangement_boolean calls
+	bool mergeCoplanar;
+};
+
+// stages of the boolean pipeline, in execution order
+enum cmb_Stage {
+	CMB_STAGE_VERTEX_MERGE,
+	CMB_STAGE_DEGENERATE_REMOVAL,
+	CMB_STAGE_TRIANGLE_SOUP,
+	CMB_STAGE_BROAD_PHASE,
+	CMB_STAGE_CLASSIFICATION,
+	CMB_STAGE_TRIANGULATION,
+	CMB_STAGE_MESH_BUILD,
+	CMB_STAGE_PATCHES,
+	CMB_STAGE_INSIDE_OUT,
+	CMB_STAGE_OP_SELECTION,
+	CMB_STAGE_FINAL_EXTRACTION,
+	CMB_STAGE_RESULT_PACKING,
+	CMB_STAGE_COUNT,
+};
+
+// outcome of an operation, see the budget of cmb_Options
+enum cmb_Status {
+	CMB_STATUS_OK,
+	CMB_STATUS_OUT_OF_TIME,
+	CMB_STATUS_TOO_MANY_PAIRS,
+	CMB_STATUS_TOO_MANY_POINTS,
+};
+
+enum cmb_JobStatus {
+	CMB_JOB_RUNNING,
+	CMB_JOB_DONE,
+	CMB_JOB_CANCELLED,
+};
+
+struct cmb_StageStats {
+	double seconds;
+	uint32_t numTriangles; // triangles of the working mesh at the end of the stage
+	uint32_t numPoints; // points of the working mesh at the end of the stage
+	uint64_t arenaBytes; // bytes held by the point arena at the end of the stage
+	uint64_t structureBytes; // bytes of the structure built by the stage (0 if the stage does not build one)
+};
+
+// When a result is made of several boolean operations (e.g. one per cylinder) the times are summed,
+// the byte counts are the peaks and the triangle/point counts are the ones of the last operation
+struct cmb_Stats {
+	cmb_StageStats stages[CMB_STAGE_COUNT];
+};
+
+struct cmb_PredicateStats {
+	const char* name;
+	uint64_t calls;
+	uint64_t intervalCalls; // calls that reached the interval arithmetic stage
+	uint64_t exactCalls; // calls that reached the floating point expansion stage
+	uint64_t bigfloatCalls; // calls that fell back to bigfloat because of an underflow/overflow
+	uint64_t totalNanoseconds;
+	uint64_t exactNanoseconds; // time spent in the exact and bigfloat stages
+};
 
 CMB_API cmb_Result* cmb_boolean(cmb_BooleanType type, cmb_InputMesh meshA, cmb_InputMesh meshB);
 CMB_API cmb_Result* cmb_boolean_substract_mesh_cylinders(cmb_InputMesh mesh, uint32_t numCylinders, const cmb_CylinderInfo* cylinders);
+CMB_API cmb_Result* cmb_boolean_ex(cmb_BooleanType type, cmb_InputMesh meshA, cmb_InputMesh meshB, const cmb_Options* options);
+CMB_API cmb_Result* cmb_boolean_substract_mesh_cylinders_ex(cmb_InputMesh mesh, uint32_t numCylinders, const cmb_CylinderInfo* cylinders,
+	const cmb_Options* options);
+// mesh minus each of the primitives, in order. Each primitive is tessellated at its own resolution and its vertices
+// are not welded again, so small or far away ones are cheap. options may be null
+CMB_API cmb_Result* cmb_boolean_subtract_primitives(cmb_InputMesh mesh, uint32_t numPrimitives, const cmb_Primitive* primitives,
+	const cmb_Options* options);
+// mesh minus the volume swept by the tool along the polyline of numPoints points (x, y, z each), i.e. a milling
+// simulation. The whole toolpath is subtracted by a single boolean operation, or a few ones for paths that overlap
+// themselves many times, instead of one per move. options may be null
+CMB_API cmb_Result* cmb_boolean_subtract_toolpath(cmb_InputMesh mesh, uint32_t numPoints, const float* points, const cmb_Tool* tool,
+	const cmb_Options* options);
+// Splits the triangles of mesh along the curves where they cross each other, so that they only meet at shared edges
+// and vertices, e.g. to clean scanned meshes before the booleans. Only the degenerate and duplicated triangles are
+// removed: the parts of the mesh inside itself stay. Runs the arrangement stages of cmb_boolean_ex, with the same
+// budget; over budget the result is empty, or the input mesh as it is with previewOnBudget. options may be null
+CMB_API cmb_Result* cmb_resolve_self_intersections(cmb_InputMesh mesh, const cmb_Options* options);
+
+// Runs numJobs independent operations concurrently on numThreads threads (0 = one per hardware thread) and stores the
+// result of jobs[i] in results[i], to be released with cmb_release. Each thread reuses its buffers from one job to the
+// next, so batching pays off even for small meshes. options may be null and apply to every job
+CMB_API void cmb_boolean_batch(const cmb_BooleanJob* jobs, uint32_t numJobs, cmb_Result** results, uint32_t numThreads,
+	const cmb_Options* options);
+
+// Starts A <type> B on a thread of its own and returns at once. The meshes are copied, so they can be modified or
+// released as soon as the call returns. options may be null. Release the job with cmb_job_release
+CMB_API cmb_Job* cmb_boolean_async(cmb_BooleanType type, cmb_InputMesh meshA, cmb_InputMesh meshB, const cmb_Options* options);
+// Status of the job, without blocking. stage and progress, if not null, receive the stage being run and an estimate
+// of the fraction of the job done so far, in [0, 1]
+CMB_API cmb_JobStatus cmb_job_poll(cmb_Job* job, cmb_Stage* stage, float* progress);
+// Asks the job to stop and returns at once. The job checks the request at the end of each stage and every few hundred
+// triangles within the long ones, so it ends within milliseconds as CMB_JOB_CANCELLED, unless it had already finished
+CMB_API void cmb_job_cancel(cmb_Job* job);
+// Blocks until the job ends and returns its result, or null if it was cancelled. The caller owns the result and
+// releases it with cmb_release; later calls return null. Not to be called from several threads at once
+CMB_API cmb_Result* cmb_job_wait(cmb_Job* job);
+// Cancels the job if it is still running, waits for it to end and frees it, together with the result if it has not
+// been taken by cmb_job_wait
+CMB_API void cmb_job_release(cmb_Job* job);
 
 CMB_API void cmb_release(cmb_Result* o);
 
+// Computes the arrangement of meshA and meshB once and classifies its triangles with respect to both meshes, so
+// that any number of operations can then be extracted from it with cmb_arrangement_boolean, each one in time
+// linear in the number of triangles. Release it with cmb_arrangement_release. options may be null
+CMB_API cmb_Arrangement* cmb_arrangement(cmb_InputMesh meshA, cmb_InputMesh meshB, const cmb_Options* options);
+// A <type> B, or B - A if type is CMB_DIFFERENCE and reversed is true. The result stats only cover the selection
+// and the extraction of the triangles; the ones of the arrangement are given by cmb_arrangement_stats
+CMB_API cmb_Result* cmb_arrangement_boolean(cmb_Arrangement* arrangement, cmb_BooleanType type, bool reversed);
+// per-stage statistics of the arrangement computation. Valid until cmb_arrangement_release
+CMB_API const cmb_Stats* cmb_arrangement_stats(cmb_Arrangement* arrangement);
+CMB_API void cmb_arrangement_release(cmb_Arrangement* arrangement);
+// Writes the arrangement to a binary file (see arrangement_io.h) that cmb_arrangement_load reads back, so that the
+// operations can be extracted later without computing it again. Returns false if the file cannot be written
+CMB_API bool cmb_arrangement_save(cmb_Arrangement* arrangement, const char* path);
+// Loads an arrangement written by cmb_arrangement_save, or returns null if the file cannot be read or is not valid.
+// The stats of a loaded arrangement are all zero
+CMB_API cmb_Arrangement* cmb_arrangement_load(const char* path);
+
+// Maps a mesh stored in the native binary format (.cmb files, see io_functions.h, written e.g. by "cmdline convert"
+// from OBJ/OFF/STL files), or returns null if the file cannot be read or is not valid. Release it with cmb_mesh_release
+CMB_API cmb_MeshFile* cmb_mesh_load(const char* path);
+// The mesh as an input of cmb_boolean and the other operations, without copies: the arrays point into the mapped
+// file (unless it stores double positions, converted to float once by cmb_mesh_load) and must not be written.
+// Valid until cmb_mesh_release
+CMB_API cmb_InputMesh cmb_mesh_input(cmb_MeshFile* mesh);
+// label of each triangle, or null if the file has none
+CMB_API const uint32_t* cmb_mesh_labels(cmb_MeshFile* mesh);
+CMB_API void cmb_mesh_release(cmb_MeshFile* mesh);
+
+// per-stage statistics of the operation that produced the result. Valid until cmb_release
+CMB_API const cmb_Stats* cmb_stats(cmb_Result* o);
+// CMB_STATUS_OK unless the operation exceeded the budget of its cmb_Options (then the result is empty or a preview)
+CMB_API cmb_Status cmb_status(cmb_Result* o);
+
 CMB_API uint32_t cmb_numVertices(cmb_Result* o);
 CMB_API uint32_t cmb_numTriangles(cmb_Result* o);
 CMB_API float* cmb_positions(cmb_Result* o);
 CMB_API float* cmb_normals(cmb_Result* o);
 CMB_API uint32_t* cmb_indices(cmb_Result* o);
+// Statistics of the geometric predicates, summed over all the threads since the last reset. They are only
+// collected when the library is built with ENABLE_PREDICATE_STATS; otherwise there are none.
+// Writes up to maxStats entries and returns the number of predicates that have been called.
+CMB_API uint32_t cmb_predicate_stats(cmb_PredicateStats* stats, uint32_t maxStats);
+CMB_API void cmb_predicate_stats_reset();
+
+// Records the arguments and the result of every orient3D, orient2D and lessThan predicate call into the file at path,
+// up to maxRecords calls (0 = no limit), so that they can be replayed by cmb_predicate_bench. Only available when
+// the library is built with ENABLE_PREDICATE_CAPTURE; returns false otherwise, or if the file cannot be created.
+CMB_API bool cmb_predicate_capture_begin(const char* path, uint64_t maxRecords);
+// Stops the capture and returns the number of calls recorded
+CMB_API uint64_t cmb_predicate_capture_end();
+
 CMB_API void cmb_nothing(int x);
\ No newline at end of file
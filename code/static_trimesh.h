@@ -0,0 +1,127 @@
+/*****************************************************************************************
+ *              MIT License                                                              *
+ *                                                                                       *
+ * Copyright (c) 2022 G. Cherchi, F. Pellacini, M. Attene and M. Livesu                  *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION     *
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                *
+ *                                                                                       *
+ * Authors:                                                                              *
+ *      Gianmarco Cherchi (g.cherchi@unica.it)                                           *
+ *      https://www.gianmarcocherchi.com                                                 *
+ *                                                                                       *
+ *      Fabio Pellacini (fabio.pellacini@uniroma1.it)                                    *
+ *      https://pellacini.di.uniroma1.it                                                 *
+ *                                                                                       *
+ *      Marco Attene (marco.attene@ge.imati.cnr.it)                                      *
+ *      https://www.cnr.it/en/people/marco.attene/                                       *
+ *                                                                                       *
+ *      Marco Livesu (marco.livesu@ge.imati.cnr.it)                                      *
+ *      http://pers.ge.imati.cnr.it/livesu/                                              *
+ *                                                                                       *
+ * ***************************************************************************************/
+
+#ifndef EXACT_BOOLEANS_STATIC_TRIMESH_H
+#define EXACT_BOOLEANS_STATIC_TRIMESH_H
+
+#include <implicit_point.h>
+#include "common.h"
+
+#include <array>
+#include <mutex>
+#include <span>
+#include <vector>
+
+/* Read-mostly triangle mesh used by the boolean stage (patches, inside/out, final selection).
+ * The topology is never modified after construction, so edges are extracted once by sorting
+ * the half-edges and all the adjacencies are stored in CSR form (offsets + flat id arrays).
+ * Only per-element info values and triangle orientation can change. */
+class StaticTrimesh
+{
+    public:
+
+        inline StaticTrimesh(const std::vector<genericPoint*> &in_verts, const std::vector<uint> &in_tris, bool parallel);
+
+        inline uint numVerts() const;
+        inline uint numEdges() const;
+        inline uint numTris() const;
+
+        // VERTICES
+        inline const genericPoint* vert(uint v_id) const;
+
+        // approximate (double) coordinates of all the vertices, 3 per vertex. The table is filled by the
+        // first call, in parallel if the mesh was built with parallel = true, and shared by all the later ones
+        inline const std::vector<double> &approxCoords() const;
+
+        inline std::span<const uint> adjV2E(uint v_id) const;
+
+        inline void resetVerticesInfo();
+
+        inline void setVertInfo(const uint v_id, const uint info);
+
+        inline uint vertInfo(const uint v_id) const;
+
+        // EDGES
+        inline uint edgeVertID(uint e_id, uint off) const;
+
+        inline bool edgeIsManifold(uint e_id) const;
+
+        inline std::span<const uint> adjE2T(uint e_id) const;
+
+        // TRIANGLES
+        inline const uint *tri(uint t_id) const;
+
+        inline uint triVertID(uint t_id, uint off) const;
+
+        inline const genericPoint *triVert(uint t_id, uint off) const;
+
+        inline uint triEdgeID(uint t_id, uint off) const;
+
+        inline std::span<const uint> adjT2E(uint t_id) const;
+
+        inline void resetTrianglesInfo();
+
+        inline uint triInfo(uint t_id) const;
+
+        inline void setTriInfo(uint t_id, uint val);
+
+        inline void flipTri(uint t_id);
+
+        inline size_t memoryFootprint() const; // bytes used by the topology, info and coordinate arrays
+
+    private:
+        const std::vector<genericPoint*> &vertices;
+        std::vector<uint> vert_info;
+
+        bool parallel;
+        mutable std::vector<double> approx_coords;
+        mutable std::once_flag approx_coords_once;
+
+        std::vector<uint> triangles;            // 3 vertex ids per triangle
+        std::vector<uint> tri_edges;            // 3 edge ids per triangle, edge i is (v[i], v[(i+1)%3])
+        std::vector<uint> tri_info;
+
+        std::vector<std::array<uint, 2>> edges; // (min, max) vertex ids
+        std::vector<uint8_t> edge_manifold;
+
+        std::vector<uint> v2e_offset, v2e;      // CSR vertex -> edges
+        std::vector<uint> e2t_offset, e2t;      // CSR edge -> triangles
+};
+
+#include "static_trimesh.inl"
+
+#endif // EXACT_BOOLEANS_STATIC_TRIMESH_H
@@ -0,0 +1,295 @@
+/*****************************************************************************************
+ *              MIT License                                                              *
+ *                                                                                       *
+ * Copyright (c) 2022 G. Cherchi, F. Pellacini, M. Attene and M. Livesu                  *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION     *
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                *
+ *                                                                                       *
+ * Authors:                                                                              *
+ *      Gianmarco Cherchi (g.cherchi@unica.it)                                           *
+ *      https://www.gianmarcocherchi.com                                                 *
+ *                                                                                       *
+ *      Fabio Pellacini (fabio.pellacini@uniroma1.it)                                    *
+ *      https://pellacini.di.uniroma1.it                                                 *
+ *                                                                                       *
+ *      Marco Attene (marco.attene@ge.imati.cnr.it)                                      *
+ *      https://www.cnr.it/en/people/marco.attene/                                       *
+ *                                                                                       *
+ *      Marco Livesu (marco.livesu@ge.imati.cnr.it)                                      *
+ *      http://pers.ge.imati.cnr.it/livesu/                                              *
+ *                                                                                       *
+ * ***************************************************************************************/
+
+#include "static_trimesh.h"
+
+#include "utils.h"
+
+inline StaticTrimesh::StaticTrimesh(const std::vector<genericPoint*> &in_verts, const std::vector<uint> &in_tris, bool parallel)
+    : vertices(in_verts), vert_info(in_verts.size(), 0), parallel(parallel), triangles(in_tris), tri_edges(in_tris.size()), tri_info(in_tris.size() / 3, 0)
+{
+    // edges are extracted from the sorted half-edges: the copies of the same edge are contiguous and
+    // ordered by triangle id, which gives the edge -> triangles adjacency for free
+    std::vector<std::pair<uint64_t, uint>> half_edges = sorted_half_edges(triangles, parallel);
+
+    // edges and edge -> triangles adjacency
+    edges.reserve(half_edges.size() / 2 + 1);
+    e2t_offset.reserve(half_edges.size() / 2 + 2);
+    e2t.resize(half_edges.size());
+
+    for(uint i = 0; i < (uint)half_edges.size(); i++)
+    {
+        if(i == 0 || half_edges[i].first != half_edges[i - 1].first)
+        {
+            edges.push_back({static_cast<uint>(half_edges[i].first >> 32), static_cast<uint>(half_edges[i].first & 0xFFFFFFFF)});
+            e2t_offset.push_back(i);
+        }
+
+        tri_edges[half_edges[i].second] = static_cast<uint>(edges.size() - 1);
+        e2t[i] = half_edges[i].second / 3;
+    }
+    e2t_offset.push_back(static_cast<uint>(half_edges.size()));
+
+    std::vector<std::pair<uint64_t, uint>>().swap(half_edges); // release the temporary memory before building the other arrays
+
+    edge_manifold.resize(edges.size());
+    for(uint e_id = 0; e_id < (uint)edges.size(); e_id++)
+        edge_manifold[e_id] = (e2t_offset[e_id + 1] - e2t_offset[e_id] == 2);
+
+    // vertex -> edges adjacency (counting sort on the edge endpoints)
+    v2e_offset.assign(vertices.size() + 1, 0);
+    for(const auto &e : edges)
+    {
+        v2e_offset[e[0] + 1]++;
+        v2e_offset[e[1] + 1]++;
+    }
+
+    for(uint v_id = 0; v_id < (uint)vertices.size(); v_id++)
+        v2e_offset[v_id + 1] += v2e_offset[v_id];
+
+    std::vector<uint> fill(v2e_offset.begin(), v2e_offset.end() - 1);
+    v2e.resize(2 * edges.size());
+    for(uint e_id = 0; e_id < (uint)edges.size(); e_id++)
+    {
+        v2e[fill[edges[e_id][0]]++] = e_id;
+        v2e[fill[edges[e_id][1]]++] = e_id;
+    }
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline uint StaticTrimesh::numVerts() const
+{
+    return static_cast<uint>(vertices.size());
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline uint StaticTrimesh::numEdges() const
+{
+    return static_cast<uint>(edges.size());
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline uint StaticTrimesh::numTris() const
+{
+    return static_cast<uint>(tri_info.size());
+}
+
+/************************************************************************************************
+ *          VERTICES
+ * *********************************************************************************************/
+
+inline const genericPoint *StaticTrimesh::vert(uint v_id) const
+{
+    assert(v_id < vertices.size() && "vtx id out of range");
+    return vertices[v_id];
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline const std::vector<double> &StaticTrimesh::approxCoords() const
+{
+    std::call_once(approx_coords_once, [this]()
+    {
+        approx_coords.resize(3 * vertices.size());
+
+        auto approx = [&](uint v_id)
+        {
+            double *c = approx_coords.data() + 3 * v_id;
+            vertices[v_id]->getApproxXYZCoordinates(c[0], c[1], c[2]);
+        };
+
+        if(parallel)
+        {
+#if ENABLE_MULTITHREADING
+            tbb::parallel_for((uint)0, (uint)vertices.size(), approx);
+#endif
+        }
+        else
+        {
+            for(uint v_id = 0; v_id < (uint)vertices.size(); v_id++) approx(v_id);
+        }
+    });
+
+    return approx_coords;
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline std::span<const uint> StaticTrimesh::adjV2E(uint v_id) const
+{
+    assert(v_id < vertices.size() && "vtx id out of range");
+    return std::span<const uint>(v2e.data() + v2e_offset[v_id], v2e_offset[v_id + 1] - v2e_offset[v_id]);
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline void StaticTrimesh::resetVerticesInfo()
+{
+    std::fill(vert_info.begin(), vert_info.end(), 0);
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline void StaticTrimesh::setVertInfo(const uint v_id, const uint info)
+{
+    assert(v_id < vertices.size() && "vtx id out of range");
+    vert_info[v_id] = info;
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline uint StaticTrimesh::vertInfo(const uint v_id) const
+{
+    assert(v_id < vertices.size() && "vtx id out of range");
+    return vert_info[v_id];
+}
+
+/************************************************************************************************
+ *          EDGES
+ * *********************************************************************************************/
+
+inline uint StaticTrimesh::edgeVertID(uint e_id, uint off) const
+{
+    assert(e_id < edges.size() && "edge id out of range");
+    assert(off < 2 && "offset out of range");
+    return edges[e_id][off];
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline bool StaticTrimesh::edgeIsManifold(uint e_id) const
+{
+    assert(e_id < edges.size() && "edge id out of range");
+    return edge_manifold[e_id];
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline std::span<const uint> StaticTrimesh::adjE2T(uint e_id) const
+{
+    assert(e_id < edges.size() && "edge id out of range");
+    return std::span<const uint>(e2t.data() + e2t_offset[e_id], e2t_offset[e_id + 1] - e2t_offset[e_id]);
+}
+
+/************************************************************************************************
+ *          TRIANGLES
+ * *********************************************************************************************/
+
+inline const uint *StaticTrimesh::tri(uint t_id) const
+{
+    assert(t_id < tri_info.size() && "tri id out of range");
+    return &triangles[3 * t_id];
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline uint StaticTrimesh::triVertID(uint t_id, uint off) const
+{
+    assert(t_id < tri_info.size() && "tri id out of range");
+    assert(off < 3 && "offset out of range");
+    return triangles[3 * t_id + off];
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline const genericPoint *StaticTrimesh::triVert(uint t_id, uint off) const
+{
+    return vertices[triVertID(t_id, off)];
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline uint StaticTrimesh::triEdgeID(uint t_id, uint off) const
+{
+    assert(t_id < tri_info.size() && "tri id out of range");
+    assert(off < 3 && "offset out of range");
+    return tri_edges[3 * t_id + off];
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline std::span<const uint> StaticTrimesh::adjT2E(uint t_id) const
+{
+    assert(t_id < tri_info.size() && "tri id out of range");
+    return std::span<const uint>(tri_edges.data() + 3 * t_id, 3);
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline void StaticTrimesh::resetTrianglesInfo()
+{
+    std::fill(tri_info.begin(), tri_info.end(), 0);
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline uint StaticTrimesh::triInfo(uint t_id) const
+{
+    assert(t_id < tri_info.size() && "tri id out of range");
+    return tri_info[t_id];
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline void StaticTrimesh::setTriInfo(uint t_id, uint val)
+{
+    assert(t_id < tri_info.size() && "tri id out of range");
+    tri_info[t_id] = val;
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline void StaticTrimesh::flipTri(uint t_id)
+{
+    assert(t_id < tri_info.size() && "tri id out of range");
+
+    // (v0, v1, v2) -> (v2, v1, v0): edges (v0,v1) and (v1,v2) swap their offsets, (v2,v0) stays
+    std::swap(triangles[3 * t_id], triangles[3 * t_id + 2]);
+    std::swap(tri_edges[3 * t_id], tri_edges[3 * t_id + 1]);
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline size_t StaticTrimesh::memoryFootprint() const
+{
+    return sizeof(uint) * (vert_info.capacity() + triangles.capacity() + tri_edges.capacity() + tri_info.capacity() +
+                           v2e_offset.capacity() + v2e.capacity() + e2t_offset.capacity() + e2t.capacity()) +
+           sizeof(std::array<uint, 2>) * edges.capacity() + edge_manifold.capacity() + sizeof(double) * approx_coords.capacity();
+}
@@ -0,0 +1,94 @@
+/*****************************************************************************************
+ *              MIT License                                                              *
+ *                                                                                       *
+ * Copyright (c) 2022 G. Cherchi, F. Pellacini, M. Attene and M. Livesu                  *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION     *
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                *
+ *                                                                                       *
+ * Authors:                                                                              *
+ *      Gianmarco Cherchi (g.cherchi@unica.it)                                           *
+ *      https://www.gianmarcocherchi.com                                                 *
+ *                                                                                       *
+ *      Fabio Pellacini (fabio.pellacini@uniroma1.it)                                    *
+ *      https://pellacini.di.uniroma1.it                                                 *
+ *                                                                                       *
+ *      Marco Attene (marco.attene@ge.imati.cnr.it)                                      *
+ *      https://www.cnr.it/en/people/marco.attene/                                       *
+ *                                                                                       *
+ *      Marco Livesu (marco.livesu@ge.imati.cnr.it)                                      *
+ *      http://pers.ge.imati.cnr.it/livesu/                                              *
+ *                                                                                       *
+ * ***************************************************************************************/
+
+#ifndef EXACT_BOOLEANS_SWEPT_VOLUME_H
+#define EXACT_BOOLEANS_SWEPT_VOLUME_H
+
+#include "common.h"
+#include <cinolib/geometry/vec_mat.h>
+
+#include <vector>
+
+/* Volume swept by a ball moving along a polyline (a ball end tool along a toolpath), i.e. the union of the capsules
+ * of the segments, built directly as closed tubes that one arrangement subtracts at once, instead of running one
+ * boolean per segment.
+ *
+ * The path is simplified first: the points within tolerance of the segment that skips them are dropped, so a
+ * straight move sampled at hundreds of positions becomes one segment. The path is then cut into pieces, each one
+ * tessellated as a single tube that does not touch itself: at each joint the inner side of the turn is mitered and
+ * the outer side follows the sphere around the joint. A piece ends where that does not work: turns above 90 degrees,
+ * segments too short for their miters, or the path coming back within two radii of the piece. The tubes are closed
+ * by hemispheres, except at the cuts, where the next piece starts with a flat cap inside the ball of the previous one:
+ * the cap is moved along the path by sqrt(2 * radius * tolerance), which leaves out less than tolerance of the
+ * volume, so that it crosses the ball instead of touching it along the rim. The segments that retrace a recent one
+ * within tolerance are skipped, as their tubes would coincide with it: the path resumes at their end in the same way.
+ *
+ * The pieces are labelled so that the pieces with the same label are disjoint, which keeps each label a valid closed
+ * mesh, while pieces with different labels may overlap freely. The labels go from first_label to NBIT - 1, and the
+ * pieces that find no free label go to the next batch: most paths fit in one. */
+
+struct SweptVolumeBatch
+{
+    std::vector<double> coords;
+    std::vector<uint>   tris;
+    std::vector<uint>   labels; // one per triangle
+};
+
+// piece of a simplified path, from point first to point last (first == last for a path made of a single point)
+struct SweptPiece
+{
+    uint first, last;
+    // 0 for a piece closed by a hemisphere at its start. At a cut, the distance along the path of the flat cap that
+    // starts the piece: inside the ball at the end of the previous piece, far enough from its surface to cross it
+    double start_offset;
+};
+
+inline void buildSweptVolume(const std::vector<cinolib::vec3d> &path, double radius, uint resolution, double tolerance,
+                             uint first_label, std::vector<SweptVolumeBatch> &batches);
+
+// drops the points within tolerance of the segment between the previous point kept and a later one
+inline void simplifyPath(const std::vector<cinolib::vec3d> &path, double tolerance, std::vector<cinolib::vec3d> &simplified);
+
+inline void splitPath(const std::vector<cinolib::vec3d> &points, double radius, double tolerance, std::vector<SweptPiece> &pieces);
+
+// appends the tube of the piece, with resolution segments around the path, to the batch
+inline void tessellatePiece(const std::vector<cinolib::vec3d> &points, const SweptPiece &piece, double radius, uint resolution,
+                            uint label, SweptVolumeBatch &batch);
+
+#include "swept_volume.inl"
+
+#endif // EXACT_BOOLEANS_SWEPT_VOLUME_H
@@ -0,0 +1,383 @@
+/*****************************************************************************************
+ *              MIT License                                                              *
+ *                                                                                       *
+ * Copyright (c) 2022 G. Cherchi, F. Pellacini, M. Attene and M. Livesu                  *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION     *
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE        *
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                *
+ *                                                                                       *
+ * Authors:                                                                              *
+ *      Gianmarco Cherchi (g.cherchi@unica.it)                                           *
+ *      https://www.gianmarcocherchi.com                                                 *
+ *                                                                                       *
+ *      Fabio Pellacini (fabio.pellacini@uniroma1.it)                                    *
+ *      https://pellacini.di.uniroma1.it                                                 *
+ *                                                                                       *
+ *      Marco Attene (marco.attene@ge.imati.cnr.it)                                      *
+ *      https://www.cnr.it/en/people/marco.attene/                                       *
+ *                                                                                       *
+ *      Marco Livesu (marco.livesu@ge.imati.cnr.it)                                      *
+ *      http://pers.ge.imati.cnr.it/livesu/                                              *
+ *                                                                                       *
+ * ***************************************************************************************/
+
+#include "swept_volume.h"
+
+#include <cinolib/geometry/segment_utils.h>
+
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+
+static constexpr double SWEPT_MAX_TURN_COS       = 0.0;  // turns up to 90 degrees stay in the same piece
+static constexpr double SWEPT_MITER_FILL         = 0.8;  // share of a segment that its two miters may take
+static constexpr uint   SWEPT_MAX_RUN            = 1024; // points checked by a single step of simplifyPath
+static constexpr uint   SWEPT_MAX_PIECE_SEGMENTS = 256;
+static constexpr uint   SWEPT_RETRACE_WINDOW     = 256;  // earlier segments checked for retraced ones
+
+inline double distanceToSegment(const cinolib::vec3d &p, const cinolib::vec3d &a, const cinolib::vec3d &b)
+{
+    const cinolib::vec3d ab = b - a;
+    const double len2 = ab.dot(ab);
+    const double t = (len2 > 0) ? std::clamp((p - a).dot(ab) / len2, 0.0, 1.0) : 0.0;
+    return p.dist(a + ab * t);
+}
+
+// v rotated by angle around the unit axis (Rodrigues' formula)
+inline cinolib::vec3d rotateAround(const cinolib::vec3d &v, const cinolib::vec3d &axis, double angle)
+{
+    const double c = std::cos(angle), s = std::sin(angle);
+    return v * c + axis.cross(v) * s + axis * (axis.dot(v) * (1 - c));
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline void simplifyPath(const std::vector<cinolib::vec3d> &path, double tolerance, std::vector<cinolib::vec3d> &simplified)
+{
+    simplified.clear();
+    if(path.empty()) return;
+
+    simplified.push_back(path[0]);
+    uint anchor = 0; // the last point kept
+    for(uint end = 1; end < path.size(); end++)
+    {
+        // extend the segment from the anchor as long as it stays within tolerance of the points it skips
+        for(uint next = end + 1; next < path.size() && next - anchor <= SWEPT_MAX_RUN; next++)
+        {
+            bool fits = true;
+            for(uint i = anchor + 1; fits && i < next; i++)
+                fits = distanceToSegment(path[i], simplified.back(), path[next]) <= tolerance;
+            if(!fits) break;
+            end = next;
+        }
+
+        // points within tolerance of the anchor are skipped without moving it
+        if(path[end].dist(simplified.back()) > tolerance)
+        {
+            simplified.push_back(path[end]);
+            anchor = end;
+        }
+    }
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline void splitPath(const std::vector<cinolib::vec3d> &points, double radius, double tolerance, std::vector<SweptPiece> &pieces)
+{
+    pieces.clear();
+    if(points.empty()) return;
+
+    const uint num_points = static_cast<uint>(points.size());
+    if(num_points == 1)
+    {
+        pieces.push_back({0, 0, 0.0});
+        return;
+    }
+
+    std::vector<double> arc_length(num_points, 0.0);
+    for(uint i = 1; i < num_points; i++) arc_length[i] = arc_length[i - 1] + points[i].dist(points[i - 1]);
+
+    // true if segment j (points j, j + 1) gets within two radii of a segment of the piece further than half a turn
+    // around a ball away along the path: closer segments are kept apart by the miter checks
+    auto comes_back = [&](uint first, uint j)
+    {
+        cinolib::vec3d s, t;
+        double u, v;
+        for(uint k = first; k + 1 < j; k++)
+        {
+            if(arc_length[j] - arc_length[k + 1] <= M_PI * radius) break;
+            if(cinolib::closest_points_between_segments(points[k], points[k + 1], points[j], points[j + 1], u, v, s, t) < 2 * radius)
+                return true;
+        }
+        return false;
+    };
+
+    // true if segment j lies within tolerance of a recent segment of the pieces, which already sweeps its volume.
+    // Tubes along the same segment would have coincident surfaces, which the arrangement handles badly
+    std::vector<bool> swept(num_points - 1, false);
+    auto retraces = [&](uint j)
+    {
+        for(uint k = (j > SWEPT_RETRACE_WINDOW) ? j - SWEPT_RETRACE_WINDOW : 0; k < j; k++)
+            if(swept[k] && distanceToSegment(points[j], points[k], points[k + 1]) <= tolerance &&
+               distanceToSegment(points[j + 1], points[k], points[k + 1]) <= tolerance) return true;
+        return false;
+    };
+
+    // the flat cap at a cut leaves out the part of the tube outside the ball, at most offset^2 / (2 radius) thick
+    const double cut_offset = std::min(std::sqrt(2 * radius * tolerance), 0.5 * radius);
+
+    bool open = false; // a piece is being built, from point first to point j
+    uint first = 0;
+    double start_offset = 0;
+    double start_miter = 0; // miter (or start offset) at the start of the last segment of the piece
+    for(uint j = 0; j + 1 < num_points; j++)
+    {
+        if(retraces(j))
+        {
+            if(open) pieces.push_back({first, j, start_offset});
+            open = false;
+            continue;
+        }
+        swept[j] = true;
+
+        cinolib::vec3d d1 = points[j + 1] - points[j];
+        const double len1 = d1.normalize();
+        if(!open)
+        {
+            // the first piece starts with a hemisphere, the ones after a skipped segment inside the ball at its end
+            first = j;
+            start_offset = start_miter = (j == 0) ? 0.0 : std::min(cut_offset, 0.5 * len1);
+            open = true;
+            continue;
+        }
+
+        cinolib::vec3d d0 = points[j] - points[j - 1];
+        const double len0 = d0.normalize();
+        const double cos_turn = d0.dot(d1);
+        const double miter = radius * std::sqrt(std::max(0.0, 1 - cos_turn) / std::max(1e-12, 1 + cos_turn)); // r tan(turn / 2)
+
+        const bool keep = cos_turn >= SWEPT_MAX_TURN_COS &&
+                          start_miter + miter <= SWEPT_MITER_FILL * len0 &&
+                          miter <= SWEPT_MITER_FILL * len1 &&
+                          j - first < SWEPT_MAX_PIECE_SEGMENTS &&
+                          !comes_back(first, j);
+        if(keep)
+        {
+            start_miter = miter;
+            continue;
+        }
+        pieces.push_back({first, j, start_offset});
+        first = j;
+        start_offset = start_miter = std::min(cut_offset, 0.5 * len1);
+    }
+    if(open) pieces.push_back({first, num_points - 1, start_offset});
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline void tessellatePiece(const std::vector<cinolib::vec3d> &points, const SweptPiece &piece, double radius, uint resolution,
+                            uint label, SweptVolumeBatch &batch)
+{
+    assert(resolution >= 3 && "too few segments");
+
+    std::vector<double> sin_a(resolution), cos_a(resolution);
+    for(uint i = 0; i < resolution; i++)
+    {
+        sin_a[i] = std::sin(2 * M_PI * i / resolution);
+        cos_a[i] = std::cos(2 * M_PI * i / resolution);
+    }
+
+    // rings of vertices along the tube, from the start to the end. A ring of one vertex is a pole
+    std::vector<uint> ring_first, ring_size;
+    auto add_vert = [&](const cinolib::vec3d &v)
+    {
+        batch.coords.insert(batch.coords.end(), {v.x(), v.y(), v.z()});
+    };
+    auto add_ring = [&](const auto &vert_of)
+    {
+        ring_first.push_back(static_cast<uint>(batch.coords.size() / 3));
+        ring_size.push_back(resolution);
+        for(uint i = 0; i < resolution; i++) add_vert(vert_of(i));
+    };
+    auto add_pole = [&](const cinolib::vec3d &v)
+    {
+        ring_first.push_back(static_cast<uint>(batch.coords.size() / 3));
+        ring_size.push_back(1);
+        add_vert(v);
+    };
+
+    // frame of the current segment: vertex i of a ring is at centre + r * (sin_a[i] * x + cos_a[i] * z)
+    cinolib::vec3d dir(0, 0, 1);
+    if(piece.last != piece.first)
+    {
+        dir = points[piece.first + 1] - points[piece.first];
+        dir.normalize();
+    }
+    cinolib::vec3d x = dir.cross(std::abs(dir.z()) > 0.9 ? cinolib::vec3d(1, 0, 0) : cinolib::vec3d(0, 0, 1));
+    x.normalize();
+    cinolib::vec3d z = x.cross(dir);
+
+    auto circle = [&](const cinolib::vec3d &centre, double r)
+    {
+        add_ring([&](uint i) { return centre + (x * sin_a[i] + z * cos_a[i]) * r; });
+    };
+
+    // rings of the hemisphere around p on the side of side * dir, without the rim and the pole
+    const uint quarter_rings = std::max(resolution / 4, 1u);
+    auto hemisphere_rings = [&](const cinolib::vec3d &p, double side)
+    {
+        for(uint i = 1; i < quarter_rings; i++)
+        {
+            const uint k = (side < 0) ? quarter_rings - i : i; // from the pole to the rim at the start, the other way at the end
+            const double phi = 0.5 * M_PI * k / quarter_rings; // angle from the rim
+            circle(p + dir * (side * radius * std::sin(phi)), radius * std::cos(phi));
+        }
+    };
+
+    const cinolib::vec3d start = points[piece.first] + dir * piece.start_offset;
+    if(piece.start_offset == 0)
+    {
+        add_pole(start - dir * radius);
+        hemisphere_rings(start, -1);
+    }
+    circle(start, radius);
+
+    const double segment_angle = 2 * M_PI / resolution;
+    for(uint j = piece.first + 1; j < piece.last; j++)
+    {
+        const cinolib::vec3d &p = points[j];
+        cinolib::vec3d next_dir = points[j + 1] - p;
+        next_dir.normalize();
+
+        cinolib::vec3d axis = dir.cross(next_dir);
+        const double sin_turn = axis.normalize();
+        const double cos_turn = dir.dot(next_dir);
+        const double turn = std::atan2(sin_turn, cos_turn);
+
+        // the outer side of the turn sweeps the sphere around p in num_steps steps, the inner side is cut by the
+        // miter plane, where the walls of the two segments meet: the same point for all the rings of the joint
+        const uint num_steps = static_cast<uint>(std::lround(turn / segment_angle));
+        for(uint s = 0; s <= num_steps; s++)
+        {
+            const double angle = num_steps ? turn * s / num_steps : 0.5 * turn;
+            add_ring([&](uint i)
+            {
+                const cinolib::vec3d e = x * sin_a[i] + z * cos_a[i];
+                const double inner = e.dot(next_dir);
+                if(inner > 0) return p + e * radius - dir * (radius * inner / (1 + cos_turn));
+                return p + rotateAround(e, axis, angle) * radius;
+            });
+        }
+
+        x = rotateAround(x, axis, turn);
+        z = rotateAround(z, axis, turn);
+        dir = next_dir;
+    }
+
+    const cinolib::vec3d &end = points[piece.last];
+    if(piece.last != piece.first) circle(end, radius);
+    hemisphere_rings(end, 1);
+    add_pole(end + dir * radius);
+
+    // the triangles face outwards, as the ones of the primitives of cmb.cpp
+    auto add_tri = [&](uint v0, uint v1, uint v2)
+    {
+        batch.tris.insert(batch.tris.end(), {v0, v1, v2});
+    };
+    if(piece.start_offset > 0)
+        for(uint i = 0; i + 2 < resolution; i++) add_tri(ring_first[0] + i + 1, ring_first[0], ring_first[0] + i + 2);
+
+    for(size_t r = 0; r + 1 < ring_first.size(); r++)
+    {
+        const uint lower = ring_first[r], upper = ring_first[r + 1];
+        for(uint i = 0; i < resolution; i++)
+        {
+            const uint next = (i + 1) % resolution;
+            if(ring_size[r] == 1)
+                add_tri(upper + next, upper + i, lower);
+            else if(ring_size[r + 1] == 1)
+                add_tri(upper, lower + i, lower + next);
+            else
+            {
+                add_tri(upper + next, upper + i, lower + i);
+                add_tri(upper + next, lower + i, lower + next);
+            }
+        }
+    }
+
+    batch.labels.resize(batch.tris.size() / 3, label);
+}
+
+//:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+inline void buildSweptVolume(const std::vector<cinolib::vec3d> &path, double radius, uint resolution, double tolerance,
+                             uint first_label, std::vector<SweptVolumeBatch> &batches)
+{
+    assert(first_label < NBIT && "no labels left for the swept volume");
+    batches.clear();
+
+    std::vector<cinolib::vec3d> points;
+    simplifyPath(path, tolerance, points);
+
+    std::vector<SweptPiece> pieces;
+    splitPath(points, radius, tolerance, pieces);
+
+    // boxes of the pieces, grown by the radius
+    std::vector<cinolib::vec3d> box_min(pieces.size()), box_max(pieces.size());
+    for(size_t p_id = 0; p_id < pieces.size(); p_id++)
+    {
+        box_min[p_id] = box_max[p_id] = points[pieces[p_id].first];
+        for(uint i = pieces[p_id].first + 1; i <= pieces[p_id].last; i++)
+        {
+            box_min[p_id] = box_min[p_id].min(points[i]);
+            box_max[p_id] = box_max[p_id].max(points[i]);
+        }
+        box_min[p_id] -= cinolib::vec3d(radius, radius, radius);
+        box_max[p_id] += cinolib::vec3d(radius, radius, radius);
+    }
+    auto overlap = [&](size_t a, size_t b)
+    {
+        for(uint i = 0; i < 3; i++)
+            if(box_min[a][i] > box_max[b][i] || box_min[b][i] > box_max[a][i]) return false;
+        return true;
+    };
+
+    // greedy labelling: each piece takes the first label that no overlapping piece of the batch has
+    std::vector<uint> piece_label(pieces.size());
+    std::vector<size_t> batch_pieces;
+    for(size_t p_id = 0; p_id < pieces.size(); p_id++)
+    {
+        std::bitset<NBIT> taken;
+        for(uint l = 0; l < first_label; l++) taken[l] = true;
+        for(size_t o_id : batch_pieces)
+            if(overlap(p_id, o_id)) taken[piece_label[o_id]] = true;
+
+        if(taken.all())
+        {
+            batch_pieces.clear();
+            taken.reset();
+            for(uint l = 0; l < first_label; l++) taken[l] = true;
+        }
+        if(batch_pieces.empty()) batches.emplace_back();
+
+        uint label = first_label;
+        while(taken[label]) label++;
+        piece_label[p_id] = label;
+        batch_pieces.push_back(p_id);
+        tessellatePiece(points, pieces[p_id], radius, resolution, label, batches.back());
+    }
+}
@@ -10,10 +10,35 @@
 struct Mesh {
     std::vector<float> positions;
     std::vector<uint32_t> indices;
+    cmb_MeshFile *file = nullptr; // .cmb inputs are mapped and used in place
+
+    cmb_InputMesh input()
+    {
+        if(file) return cmb_mesh_input(file);
+        return { uint32_t(positions.size() / 3), uint32_t(indices.size() / 3), positions.data(), indices.data() };
+    }
 };
 
+bool isMeshFile(const std::string &path)
+{
+    std::string filetype = path.size() >= 4 ? path.substr(path.size() - 4, 4) : "";
+    return filetype.compare(".cmb") == 0 || filetype.compare(".CMB") == 0;
+}
+
 Mesh loadMesh(const std::string path)
 {
+    if(isMeshFile(path))
+    {
+        Mesh mesh;
+        mesh.file = cmb_mesh_load(path.c_str());
+        if(!mesh.file)
+        {
+            std::cout << path << " is not a valid mesh file" << std::endl;
+            exit(-1);
+        }
+        return mesh;
+    }
+
     std::vector<double> positions;
     std::vector<uint> indices;
     std::vector<uint> labels;
@@ -26,13 +51,104 @@ Mesh loadMesh(const std::string path)
     };
 }
 
+// ./cmdline convert input1.obj [input2.stl ...] output.cmb [--double]
+// Writes the inputs as a native binary mesh file (see cmb_mesh_load), with float positions (the ones cmb_InputMesh
+// takes) unless --double is given. When there are several inputs, each triangle is labelled with its input file
+int convert(int argc, char **argv)
+{
+    bool double_positions = (strcmp(argv[argc -1], "--double") == 0);
+    if(double_positions) argc--;
+
+    if(argc < 4 || !isMeshFile(argv[argc -1]))
+    {
+        std::cout << "syntax error!" << std::endl;
+        std::cout << "./exact_boolean convert input1.obj [input2.obj ...] output.cmb [--double]" << std::endl;
+        return -1;
+    }
+
+    std::vector<std::string> files(argv + 2, argv + argc -1);
+    std::string file_out = argv[argc -1];
+
+    std::vector<double> positions;
+    std::vector<uint> indices;
+    std::vector<uint> labels;
+    loadMultipleFiles(files, positions, indices, labels);
+
+    const uint numVertices = uint(positions.size() / 3), numTriangles = uint(indices.size() / 3);
+    const uint *triLabels = files.size() > 1 ? labels.data() : nullptr;
+
+    bool ok;
+    if(double_positions)
+        ok = writeCMB(file_out, positions.data(), numVertices, indices.data(), numTriangles, triLabels);
+    else
+    {
+        std::vector<float> floatPositions(positions.begin(), positions.end());
+        ok = writeCMB(file_out, floatPositions.data(), numVertices, indices.data(), numTriangles, triLabels);
+    }
+
+    if(!ok)
+    {
+        std::cout << "cannot write " << file_out << std::endl;
+        return -1;
+    }
+    return 0;
+}
+
+void printPredicateStats()
+{
+    std::vector<cmb_PredicateStats> stats(cmb_predicate_stats(nullptr, 0));
+    cmb_predicate_stats(stats.data(), uint32_t(stats.size()));
+    if(stats.empty())
+    {
+        std::cout << "no predicate statistics (build with ENABLE_PREDICATE_STATS)" << std::endl;
+        return;
+    }
+
+    std::sort(stats.begin(), stats.end(), [](const cmb_PredicateStats &a, const cmb_PredicateStats &b) { return a.totalNanoseconds > b.totalNanoseconds; });
+
+    printf("%-36s %12s %12s %12s %10s %11s %11s\n", "predicate", "calls", "interval", "exact", "bigfloat", "total ms", "exact ms");
+    for(const auto &s : stats)
+        printf("%-36s %12llu %12llu %12llu %10llu %11.3f %11.3f\n", s.name,
+               (unsigned long long)s.calls, (unsigned long long)s.intervalCalls, (unsigned long long)s.exactCalls,
+               (unsigned long long)s.bigfloatCalls, s.totalNanoseconds * 1e-6, s.exactNanoseconds * 1e-6);
+}
+
+void printStageStats(const cmb_Stats &stats)
+{
+    const char *names[CMB_STAGE_COUNT] = {"vertex merge", "degenerate removal", "triangle soup", "broad phase",
+                                          "classification", "triangulation", "mesh build", "patches", "inside/out",
+                                          "op selection", "final extraction", "result packing"};
+
+    printf("%-20s %10s %10s %10s %12s %12s\n", "stage", "ms", "tris", "points", "arena KB", "struct KB");
+    for(uint32_t i = 0; i < CMB_STAGE_COUNT; i++)
+    {
+        const cmb_StageStats &s = stats.stages[i];
+        printf("%-20s %10.3f %10u %10u %12llu %12llu\n", names[i], s.seconds * 1e3, s.numTriangles, s.numPoints,
+               (unsigned long long)(s.arenaBytes / 1024), (unsigned long long)(s.structureBytes / 1024));
+    }
+}
+
 int main(int argc, char **argv)
 {
+    if(argc > 1 && strcmp(argv[1], "convert") == 0)
+        return convert(argc, argv);
+
+    bool stage_stats = false, predicate_stats = false;
+    const char *capture_file = nullptr;
+    for(; argc > 1; argc--)
+    {
+        if(strcmp(argv[argc -1], "--stats") == 0)                 stage_stats = true;
+        else if(strcmp(argv[argc -1], "--predicate-stats") == 0)  predicate_stats = true;
+        else if(argc > 2 && strcmp(argv[argc -2], "--capture-predicates") == 0) capture_file = argv[--argc];
+        else break;
+    }
+
     cmb_BooleanType op;
     if(argc != 5)
     {
         std::cout << "syntax error!" << std::endl;
-        std::cout << "./exact_boolean BOOL_OPERATION (intersection OR union OR subtraction) input1.obj input2.obj output.obj" << std::endl;
+        std::cout << "./exact_boolean BOOL_OPERATION (intersection OR union OR subtraction) input1.obj input2.obj output.obj [--stats] [--predicate-stats] [--capture-predicates FILE]" << std::endl;
+        std::cout << "./exact_boolean convert input1.obj [input2.obj ...] output.cmb [--double]" << std::endl;
         return -1;
     }
     else
@@ -55,18 +171,23 @@ int main(int argc, char **argv)
 
     std::string file_out = argv[4];
 
-    auto result = cmb_boolean(op,
-        { uint32_t(meshA.positions.size() / 3), uint32_t(meshA.indices.size() / 3), meshA.positions.data(), meshA.indices.data() },
-        { uint32_t(meshB.positions.size() / 3), uint32_t(meshB.indices.size() / 3), meshB.positions.data(), meshB.indices.data() }
-    );
+    if(capture_file && !cmb_predicate_capture_begin(capture_file, 0))
+    {
+        std::cout << "cannot capture the predicates to " << capture_file << " (build with ENABLE_PREDICATE_CAPTURE)" << std::endl;
+        return -1;
+    }
+
+    auto result = cmb_boolean(op, meshA.input(), meshB.input());
 
-    auto positionsPtr = cmb_positions(result);
-    std::vector<double> resultPositons(positionsPtr, positionsPtr + 3 * cmb_numVertices(result));
+    if(capture_file)
+        std::cout << cmb_predicate_capture_end() << " predicate calls captured to " << capture_file << std::endl;
 
-    auto indicesPtr = cmb_indices(result);
-    std::vector<uint> resultIndices(indicesPtr, indicesPtr + 3 * cmb_numTriangles(result));
+    // the format follows the extension of the output file (obj, off, stl or ply)
+    if(!saveMesh(file_out, cmb_positions(result), cmb_numVertices(result), cmb_indices(result), cmb_numTriangles(result)))
+        std::cout << "cannot write " << file_out << std::endl;
 
-    cinolib::write_OBJ(file_out.c_str(), resultPositons, resultIndices, {});
+    if(stage_stats) printStageStats(*cmb_stats(result));
+    if(predicate_stats) printPredicateStats();
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,186 @@
+#ifdef _MSC_VER // Workaround for known bugs and issues on MSVC
+    #define _HAS_STD_BYTE 0  // https://developercommunity.visualstudio.com/t/error-c2872-byte-ambiguous-symbol/93889
+    #define NOMINMAX // https://stackoverflow.com/questions/1825904/error-c2589-on-stdnumeric-limitsdoublemin
+#endif
+#include <implicit_point.h>
+
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+// cmb_predicate_bench: replays the predicate calls recorded by cmb_predicate_capture_begin (or by
+// "cmdline ... --capture-predicates FILE"), grouped by predicate and by which of its arguments are implicit, and
+// reports the time per call of each group. Every call is also checked against the result recorded during the capture.
+//
+// The points are rebuilt once, before timing, exactly as the arrangement builds them (so the implicit points carry
+// their cached interval lambdas), then each group is replayed in capture order until --min-time has elapsed.
+
+using namespace predicate_capture;
+
+struct Call {
+    Predicate predicate;
+    int8_t expected;
+    uint32_t args[4];
+};
+
+struct Group {
+    std::vector<Call> calls;
+    uint64_t passes = 0;
+    double seconds = 0;
+    uint64_t mismatches = 0;
+};
+
+struct Points {
+    std::deque<explicitPoint3D> explicitPoints;
+    std::deque<implicitPoint3D_LPI> lpis;
+    std::deque<implicitPoint3D_TPI> tpis;
+    std::deque<implicitPoint3D_LNC> lncs;
+    std::vector<const genericPoint*> all;
+
+    const explicitPoint3D& e(const double* c) { return explicitPoints.emplace_back(c[0], c[1], c[2]); }
+
+    uint32_t add(uint8_t type, const double* c)
+    {
+        if (type == EXPLICIT3D)   all.push_back(&e(c));
+        else if (type == LPI)     all.push_back(&lpis.emplace_back(e(c), e(c + 3), e(c + 6), e(c + 9), e(c + 12)));
+        else if (type == TPI)     all.push_back(&tpis.emplace_back(e(c), e(c + 3), e(c + 6), e(c + 9), e(c + 12), e(c + 15),
+                                                                    e(c + 18), e(c + 21), e(c + 24)));
+        else                      all.push_back(&lncs.emplace_back(e(c), e(c + 3), c[6]));
+        return uint32_t(all.size() - 1);
+    }
+};
+
+static const char* predicateNames[NUM_PREDICATES] = { "orient3D", "orient2Dxy", "orient2Dyz", "orient2Dzx", "lessThan" };
+
+// e.g. "orient3D/IIEE": the implicit arguments first, as the dispatchers in implicit_point.hpp reorder them
+static std::string groupName(const Call& call, const Points& points)
+{
+    const uint32_t n = numArgs(call.predicate);
+    uint32_t numExplicit = 0;
+    for (uint32_t i = 0; i < n; i++) numExplicit += points.all[call.args[i]]->isExplicit3D();
+    return std::string(predicateNames[call.predicate]) + "/" + std::string(n - numExplicit, 'I') + std::string(numExplicit, 'E');
+}
+
+static bool loadCapture(const std::string& path, Points& points, std::map<std::string, Group>& groups, uint64_t& numCalls)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        printf("Cannot open %s\n", path.c_str());
+        return false;
+    }
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (data.size() < sizeof(MAGIC) || memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        printf("%s is not a predicate capture\n", path.c_str());
+        return false;
+    }
+
+    size_t pos = sizeof(MAGIC);
+    auto read = [&](void* dst, size_t bytes) {
+        if (pos + bytes > data.size()) return false;
+        memcpy(dst, data.data() + pos, bytes);
+        pos += bytes;
+        return true;
+    };
+
+    numCalls = 0;
+    while (pos < data.size()) {
+        uint8_t predicate;
+        Call call = {};
+        if (!read(&predicate, 1) || predicate >= NUM_PREDICATES || !read(&call.expected, 1)) break;
+        call.predicate = Predicate(predicate);
+
+        bool ok = true;
+        for (uint32_t i = 0; ok && i < numArgs(call.predicate); i++) {
+            uint8_t type;
+            double coords[27];
+            ok = read(&type, 1) && numCoords(type) && read(coords, numCoords(type) * sizeof(double));
+            if (ok) call.args[i] = points.add(type, coords);
+        }
+        if (!ok) break;
+
+        groups[groupName(call, points)].calls.push_back(call);
+        numCalls++;
+    }
+    if (pos < data.size()) {
+        printf("%s is truncated or corrupted after %llu calls\n", path.c_str(), (unsigned long long)numCalls);
+        return false;
+    }
+    return true;
+}
+
+static inline int replay(const Call& call, const std::vector<const genericPoint*>& p)
+{
+    const uint32_t* a = call.args;
+    switch (call.predicate) {
+        case ORIENT3D:   return genericPoint::orient3D(*p[a[0]], *p[a[1]], *p[a[2]], *p[a[3]]);
+        case ORIENT2DXY: return genericPoint::orient2Dxy(*p[a[0]], *p[a[1]], *p[a[2]]);
+        case ORIENT2DYZ: return genericPoint::orient2Dyz(*p[a[0]], *p[a[1]], *p[a[2]]);
+        case ORIENT2DZX: return genericPoint::orient2Dzx(*p[a[0]], *p[a[1]], *p[a[2]]);
+        default:         return genericPoint::lessThan(*p[a[0]], *p[a[1]]);
+    }
+}
+
+static void runGroup(Group& group, const Points& points, double minSeconds)
+{
+    // the first pass checks the results, the timed ones only keep them alive
+    for (const Call& call : group.calls)
+        group.mismatches += (replay(call, points.all) != call.expected);
+
+    volatile int sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    do {
+        int sum = 0;
+        for (const Call& call : group.calls)
+            sum += replay(call, points.all);
+        sink = sink + sum;
+        group.passes++;
+        group.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } while (group.seconds < minSeconds);
+}
+
+int main(int argc, char **argv)
+{
+    std::string path, filter;
+    double minSeconds = 0.5;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--min-time" && hasValue)      minSeconds = std::stod(argv[++i]);
+        else if (arg == "--filter" && hasValue)   filter = argv[++i];
+        else if (path.empty() && arg[0] != '-')   path = arg;
+        else {
+            path.clear();
+            break;
+        }
+    }
+    if (path.empty()) {
+        std::cout << "usage: ./cmb_predicate_bench CAPTURE_FILE [--min-time SECONDS] [--filter SUBSTRING]" << std::endl;
+        return -1;
+    }
+
+    initFPU();
+
+    Points points;
+    std::map<std::string, Group> groups;
+    uint64_t numCalls;
+    if (!loadCapture(path, points, groups, numCalls)) return -1;
+
+    printf("%llu calls, %llu points\n\n", (unsigned long long)numCalls, (unsigned long long)points.all.size());
+    printf("%-20s %12s %8s %8s %12s %12s\n", "benchmark", "calls", "share", "passes", "ns/call", "mismatches");
+
+    uint64_t totalMismatches = 0;
+    for (auto& [name, group] : groups) {
+        if (name.find(filter) == std::string::npos) continue;
+        runGroup(group, points, minSeconds);
+        totalMismatches += group.mismatches;
+        printf("%-20s %12llu %7.2f%% %8llu %12.2f %12llu\n", name.c_str(), (unsigned long long)group.calls.size(),
+               100.0 * group.calls.size() / numCalls, (unsigned long long)group.passes,
+               1e9 * group.seconds / (double(group.passes) * group.calls.size()), (unsigned long long)group.mismatches);
+    }
+
+    return totalMismatches ? 1 : 0;
+}